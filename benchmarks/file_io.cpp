@@ -0,0 +1,483 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.16 Added rewrite policies benchmark.
+//      2026.10.16 Unknown benchmark names are rejected.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/ionik/directory_handle.hpp"
+#include "pfs/ionik/local_file.hpp"
+#include <pfs/filesystem.hpp>
+#include <pfs/fmt.hpp>
+#include <pfs/standard_paths.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = pfs::filesystem;
+
+using clock_type = std::chrono::steady_clock;
+
+enum class format_enum { json, csv };
+
+struct options
+{
+    fs::path dir;
+    std::size_t file_size {256 * 1024 * 1024}; // Size of the file for throughput benchmarks
+    std::size_t small_files {1000};            // Number of small files
+    std::size_t ops {100000};                  // Number of operations for rate benchmarks
+    std::size_t rewrites {200};                // Number of rewrites (durable ones take milliseconds)
+    int repeat {5};
+    format_enum format {format_enum::json};
+};
+
+/**
+ * Measurement: bytes and operations processed per run, and run times.
+ */
+struct measurement
+{
+    std::string name;
+    std::string params;           // Parameters as `key=value` list separated by `;`
+    std::uint64_t bytes {0};      // Bytes processed by one run
+    std::uint64_t ops {0};        // Operations performed by one run
+    std::vector<double> seconds;  // Time of each run
+};
+
+static void print_header (format_enum format)
+{
+    if (format == format_enum::csv)
+        fmt::print("benchmark,params,runs,bytes,ops,min_sec,median_sec,mb_per_sec,ops_per_sec\n");
+}
+
+// Throughput is reported for the best (minimum time) run
+static void print_measurement (measurement m, format_enum format)
+{
+    std::sort(m.seconds.begin(), m.seconds.end());
+
+    auto min_sec = m.seconds.front();
+    auto median_sec = m.seconds[m.seconds.size() / 2];
+    auto mb_per_sec = min_sec > 0 ? static_cast<double>(m.bytes) / (1024 * 1024) / min_sec : 0.0;
+    auto ops_per_sec = min_sec > 0 ? static_cast<double>(m.ops) / min_sec : 0.0;
+
+    if (format == format_enum::csv) {
+        fmt::print("{},\"{}\",{},{},{},{:.6f},{:.6f},{:.2f},{:.2f}\n", m.name, m.params
+            , m.seconds.size(), m.bytes, m.ops, min_sec, median_sec, mb_per_sec, ops_per_sec);
+    } else {
+        fmt::print("{{\"benchmark\": \"{}\", \"params\": \"{}\", \"runs\": {}, \"bytes\": {}"
+            ", \"ops\": {}, \"min_sec\": {:.6f}, \"median_sec\": {:.6f}, \"mb_per_sec\": {:.2f}"
+            ", \"ops_per_sec\": {:.2f}}}\n", m.name, m.params, m.seconds.size(), m.bytes
+            , m.ops, min_sec, median_sec, mb_per_sec, ops_per_sec);
+    }
+
+    std::fflush(stdout);
+}
+
+/**
+ * Runs @a f @a repeat times, @a prepare is called before each run and is not measured.
+ */
+static std::vector<double> run (int repeat, std::function<void ()> const & prepare
+    , std::function<void ()> const & f)
+{
+    std::vector<double> result;
+
+    for (int i = 0; i < repeat; i++) {
+        prepare();
+
+        auto start = clock_type::now();
+        f();
+        auto finish = clock_type::now();
+
+        result.push_back(std::chrono::duration<double>(finish - start).count());
+    }
+
+    return result;
+}
+
+static void nothing () {}
+
+// Drops file pages from the page cache (best effort), so the next read goes to the device
+static void drop_cache (fs::path const & path)
+{
+    auto f = ionik::local_file::open_read_only(path);
+    ionik::error err;
+    f.advise(ionik::advice_enum::dontneed, 0, f.size(), & err);
+}
+
+static void write_file (fs::path const & path, std::size_t size, std::size_t block_size)
+{
+    std::vector<char> block(block_size, 'x');
+    auto out = ionik::local_file::open_write_only(path, ionik::truncate_enum::on);
+
+    for (std::size_t total = 0; total < size; total += block_size)
+        out.write(block.data(), (std::min)(block_size, size - total));
+
+    out.sync_data();
+}
+
+static void bench_sequential_write (options const & opts, std::vector<std::size_t> const & block_sizes)
+{
+    auto path = opts.dir / PFS__LITERAL_PATH("seq.bin");
+
+    for (auto block_size: block_sizes) {
+        measurement m;
+        m.name = "seq_write";
+        m.params = fmt::format("block_size={};sync=data", block_size);
+        m.bytes = opts.file_size;
+        m.ops = (opts.file_size + block_size - 1) / block_size;
+        m.seconds = run(opts.repeat, nothing, [&] {
+            write_file(path, opts.file_size, block_size);
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+}
+
+static void bench_sequential_read (options const & opts, std::vector<std::size_t> const & block_sizes)
+{
+    auto path = opts.dir / PFS__LITERAL_PATH("seq.bin");
+    write_file(path, opts.file_size, 1024 * 1024);
+
+    for (bool cold: {false, true}) {
+        for (auto block_size: block_sizes) {
+            std::vector<char> block(block_size);
+
+            measurement m;
+            m.name = "seq_read";
+            m.params = fmt::format("block_size={};cache={}", block_size, cold ? "cold" : "warm");
+            m.bytes = opts.file_size;
+            m.ops = (opts.file_size + block_size - 1) / block_size;
+            m.seconds = run(opts.repeat, [&] {
+                if (cold)
+                    drop_cache(path);
+            }, [&] {
+                auto in = ionik::local_file::open_read_only(path);
+
+                while (in.read(block.data(), block.size()).first > 0)
+                    ;
+            });
+
+            print_measurement(std::move(m), opts.format);
+        }
+    }
+}
+
+static void bench_read_all (options const & opts)
+{
+    auto small_dir = opts.dir / PFS__LITERAL_PATH("small");
+    fs::create_directories(small_dir);
+
+    std::vector<fs::path> small_paths;
+
+    for (std::size_t i = 0; i < opts.small_files; i++) {
+        small_paths.push_back(small_dir / pfs::utf8_decode_path(std::to_string(i)));
+        write_file(small_paths.back(), 4096, 4096);
+    }
+
+    {
+        std::string content;
+
+        measurement m;
+        m.name = "read_all";
+        m.params = fmt::format("file_size={};files={}", 4096, small_paths.size());
+        m.bytes = 4096 * small_paths.size();
+        m.ops = small_paths.size();
+        m.seconds = run(opts.repeat, nothing, [&] {
+            for (auto const & p: small_paths)
+                ionik::local_file::read_all(p, content);
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+
+    auto large_path = opts.dir / PFS__LITERAL_PATH("seq.bin");
+    write_file(large_path, opts.file_size, 1024 * 1024);
+
+    {
+        std::string content;
+
+        measurement m;
+        m.name = "read_all";
+        m.params = fmt::format("file_size={};files=1", opts.file_size);
+        m.bytes = opts.file_size;
+        m.ops = 1;
+        m.seconds = run(opts.repeat, nothing, [&] {
+            ionik::local_file::read_all(large_path, content);
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+}
+
+static void bench_open_close (options const & opts)
+{
+    auto small_dir = opts.dir / PFS__LITERAL_PATH("small");
+    auto path = small_dir / PFS__LITERAL_PATH("0");
+    auto name = fs::path{PFS__LITERAL_PATH("0")};
+
+    if (!fs::exists(path)) {
+        fs::create_directories(small_dir);
+        write_file(path, 4096, 4096);
+    }
+
+    {
+        measurement m;
+        m.name = "open_close";
+        m.params = "lookup=path";
+        m.ops = opts.ops;
+        m.seconds = run(opts.repeat, nothing, [&] {
+            for (std::size_t i = 0; i < opts.ops; i++)
+                ionik::local_file::open_read_only(path).close();
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+
+    {
+        auto dir = ionik::directory_handle::open(small_dir);
+
+        measurement m;
+        m.name = "open_close";
+        m.params = "lookup=directory_handle";
+        m.ops = opts.ops;
+        m.seconds = run(opts.repeat, nothing, [&] {
+            for (std::size_t i = 0; i < opts.ops; i++)
+                dir.open_at(name).close();
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+}
+
+static void bench_positional_read (options const & opts)
+{
+    static constexpr std::size_t IO_BLOCK_SIZE = 4096;
+
+    auto path = opts.dir / PFS__LITERAL_PATH("seq.bin");
+    write_file(path, opts.file_size, 1024 * 1024);
+
+    auto in = ionik::local_file::open_read_only(path);
+    auto block_count = opts.file_size / IO_BLOCK_SIZE;
+
+    auto thread_counts = std::vector<unsigned>{1};
+    auto hw = std::thread::hardware_concurrency();
+
+    if (hw > 1)
+        thread_counts.push_back(hw);
+
+    for (auto threads: thread_counts) {
+        auto ops_per_thread = opts.ops / threads;
+
+        measurement m;
+        m.name = "pread";
+        m.params = fmt::format("block_size={};threads={};cache=warm", IO_BLOCK_SIZE, threads);
+        m.bytes = ops_per_thread * threads * IO_BLOCK_SIZE;
+        m.ops = ops_per_thread * threads;
+        m.seconds = run(opts.repeat, nothing, [&] {
+            std::vector<std::thread> workers;
+
+            for (unsigned t = 0; t < threads; t++) {
+                workers.emplace_back([&, t] {
+                    std::minstd_rand rnd {t + 1};
+                    std::vector<char> block(IO_BLOCK_SIZE);
+
+                    for (std::size_t i = 0; i < ops_per_thread; i++) {
+                        auto offset = static_cast<ionik::filesize_t>(rnd() % block_count) * IO_BLOCK_SIZE;
+                        in.read_at(offset, block.data(), block.size());
+                    }
+                });
+            }
+
+            for (auto & w: workers)
+                w.join();
+        });
+
+        print_measurement(std::move(m), opts.format);
+    }
+}
+
+static void bench_rewrite (options const & opts)
+{
+    auto path = opts.dir / PFS__LITERAL_PATH("snapshot.bin");
+
+    struct policy_item
+    {
+        ionik::rewrite_policy_enum policy;
+        char const * name;
+    };
+
+    policy_item const policies[] = {
+          {ionik::rewrite_policy_enum::in_place, "in_place"}
+        , {ionik::rewrite_policy_enum::atomic, "atomic"}
+        , {ionik::rewrite_policy_enum::durable, "durable"}
+    };
+
+    for (auto size: {std::size_t{4096}, std::size_t{1024 * 1024}}) {
+        std::string content(size, 'x');
+
+        for (auto const & item: policies) {
+            measurement m;
+            m.name = "rewrite";
+            m.params = fmt::format("size={};policy={}", size, item.name);
+            m.bytes = size * opts.rewrites;
+            m.ops = opts.rewrites;
+            m.seconds = run(opts.repeat, nothing, [&] {
+                for (std::size_t i = 0; i < opts.rewrites; i++)
+                    ionik::local_file::rewrite(path, content, item.policy);
+            });
+
+            print_measurement(std::move(m), opts.format);
+        }
+    }
+}
+
+static void cleanup (fs::path const & dir, bool temp_dir)
+{
+    std::error_code ec;
+
+    if (temp_dir) {
+        fs::remove_all(dir, ec);
+    } else {
+        fs::remove(dir / PFS__LITERAL_PATH("seq.bin"), ec);
+        fs::remove(dir / PFS__LITERAL_PATH("snapshot.bin"), ec);
+        fs::remove_all(dir / PFS__LITERAL_PATH("small"), ec);
+    }
+}
+
+static char const * const BENCHMARK_NAMES[] = {
+    "seq_write", "seq_read", "read_all", "open_close", "pread", "rewrite"
+};
+
+static std::string benchmark_names ()
+{
+    std::string result;
+
+    for (auto name: BENCHMARK_NAMES)
+        result += result.empty() ? name : std::string{" "} + name;
+
+    return result;
+}
+
+static void print_help (char const * program)
+{
+    fmt::print("Usage: {} [OPTIONS] [BENCHMARK...]\n\n", program);
+    fmt::print("Benchmarks: {} (all by default)\n\n", benchmark_names());
+    fmt::print("Options:\n");
+    fmt::print("    --dir DIR        Directory for test files (temporary directory by default)\n");
+    fmt::print("    --size MIB       Size of the file for throughput benchmarks (256)\n");
+    fmt::print("    --files N        Number of small files for read_all (1000)\n");
+    fmt::print("    --ops N          Number of operations for rate benchmarks (100000)\n");
+    fmt::print("    --rewrites N     Number of rewrites for rewrite benchmark (200)\n");
+    fmt::print("    --repeat N       Number of runs of each benchmark (5)\n");
+    fmt::print("    --format FORMAT  Output format: json (JSON object per line) or csv\n");
+}
+
+int main (int argc, char * argv[])
+{
+    options opts;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            print_help(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (arg == "--dir" && has_value) {
+            opts.dir = pfs::utf8_decode_path(argv[++i]);
+        } else if (arg == "--size" && has_value) {
+            opts.file_size = std::stoul(argv[++i]) * 1024 * 1024;
+        } else if (arg == "--files" && has_value) {
+            opts.small_files = std::stoul(argv[++i]);
+        } else if (arg == "--ops" && has_value) {
+            opts.ops = std::stoul(argv[++i]);
+        } else if (arg == "--rewrites" && has_value) {
+            opts.rewrites = std::stoul(argv[++i]);
+        } else if (arg == "--repeat" && has_value) {
+            opts.repeat = (std::max)(std::stoi(argv[++i]), 1);
+        } else if (arg == "--format" && has_value) {
+            std::string format = argv[++i];
+
+            if (format == "csv") {
+                opts.format = format_enum::csv;
+            } else if (format != "json") {
+                fmt::print(stderr, "Bad format: {}\n", format);
+                return EXIT_FAILURE;
+            }
+        } else if (arg.size() > 0 && arg[0] != '-') {
+            if (std::find(std::begin(BENCHMARK_NAMES), std::end(BENCHMARK_NAMES), arg)
+                    == std::end(BENCHMARK_NAMES)) {
+                fmt::print(stderr, "Unknown benchmark: {}\nValid benchmarks: {}\n", arg
+                    , benchmark_names());
+                return EXIT_FAILURE;
+            }
+
+            selected.push_back(arg);
+        } else {
+            fmt::print(stderr, "Bad argument: {}\n", arg);
+            print_help(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (opts.file_size == 0 || opts.small_files == 0 || opts.ops == 0
+            || opts.rewrites == 0) {
+        fmt::print(stderr, "Sizes and counts must be positive\n");
+        return EXIT_FAILURE;
+    }
+
+    bool temp_dir = opts.dir.empty();
+
+    if (temp_dir) {
+        opts.dir = fs::standard_paths::temp_folder()
+            / pfs::utf8_decode_path(fmt::format("ionik-file-io-benchmark-{}"
+                , clock_type::now().time_since_epoch().count()));
+    }
+
+    fs::create_directories(opts.dir);
+
+    auto enabled = [& selected] (char const * name) {
+        return selected.empty() || std::find(selected.begin(), selected.end(), name) != selected.end();
+    };
+
+    std::vector<std::size_t> const block_sizes {4096, 64 * 1024, 1024 * 1024};
+
+    try {
+        print_header(opts.format);
+
+        if (enabled("seq_write"))
+            bench_sequential_write(opts, block_sizes);
+
+        if (enabled("seq_read"))
+            bench_sequential_read(opts, block_sizes);
+
+        if (enabled("read_all"))
+            bench_read_all(opts);
+
+        if (enabled("open_close"))
+            bench_open_close(opts);
+
+        if (enabled("pread"))
+            bench_positional_read(opts);
+
+        if (enabled("rewrite"))
+            bench_rewrite(opts);
+    } catch (ionik::error const & ex) {
+        fmt::print(stderr, "Benchmark failure: {}\n", ex.what());
+        cleanup(opts.dir, temp_dir);
+        return EXIT_FAILURE;
+    }
+
+    cleanup(opts.dir, temp_dir);
+    return EXIT_SUCCESS;
+}
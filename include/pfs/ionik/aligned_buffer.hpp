@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.15 Added allocation in huge pages.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#if _MSC_VER
+#   include <malloc.h>
+#elif defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
+namespace ionik {
+
+enum class huge_pages_enum: std::int8_t { off, on };
+
+/**
+ * Owning buffer with aligned start address, suitable for direct I/O.
+ */
+class aligned_buffer
+{
+    char * _data {nullptr};
+    std::size_t _size {0};
+    std::size_t _alignment {0};
+    std::size_t _mapped_size {0}; // Non-zero if allocated in huge pages
+
+public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+public:
+    aligned_buffer () = default;
+
+    /**
+     * Allocates @a size bytes aligned to @a alignment (must be power of two and multiple of
+     * `sizeof(void *)`).
+     *
+     * @throws std::bad_alloc on allocation failure.
+     */
+    aligned_buffer (std::size_t size, std::size_t alignment)
+        : aligned_buffer(size, alignment, huge_pages_enum::off)
+    {}
+
+    /**
+     * Allocates @a size bytes aligned to @a alignment, in huge pages if @a huge is @c on
+     * (Linux only, `MAP_HUGETLB`). Huge pages reduce TLB misses on large buffers, but must be
+     * reserved by the system (`/proc/sys/vm/nr_hugepages`), so regular allocation is used if
+     * huge pages are not available (see `huge_pages()`).
+     *
+     * @throws std::bad_alloc on allocation failure.
+     */
+    aligned_buffer (std::size_t size, std::size_t alignment, huge_pages_enum huge)
+        : _size(size)
+        , _alignment(alignment)
+    {
+        if (size == 0)
+            return;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        if (huge == huge_pages_enum::on && alignment <= HUGE_PAGE_SIZE) {
+            auto mapped_size = align_up(size, HUGE_PAGE_SIZE);
+            void * p = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE
+                , MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (p != MAP_FAILED) {
+                _data = static_cast<char *>(p);
+                _mapped_size = mapped_size;
+                return;
+            }
+        }
+#else
+        (void)huge;
+#endif
+
+#if _MSC_VER
+        _data = static_cast<char *>(_aligned_malloc(size, alignment));
+
+        if (_data == nullptr)
+            throw std::bad_alloc{};
+#else
+        void * p = nullptr;
+
+        if (::posix_memalign(& p, alignment, size) != 0)
+            throw std::bad_alloc{};
+
+        _data = static_cast<char *>(p);
+#endif
+    }
+
+    aligned_buffer (aligned_buffer const &) = delete;
+    aligned_buffer & operator = (aligned_buffer const &) = delete;
+
+    aligned_buffer (aligned_buffer && other) noexcept
+    {
+        swap(other);
+    }
+
+    aligned_buffer & operator = (aligned_buffer && other) noexcept
+    {
+        aligned_buffer tmp {std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    ~aligned_buffer ()
+    {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        if (_mapped_size > 0) {
+            ::munmap(_data, _mapped_size);
+            return;
+        }
+#endif
+
+#if _MSC_VER
+        _aligned_free(_data);
+#else
+        std::free(_data);
+#endif
+    }
+
+    char * data () noexcept
+    {
+        return _data;
+    }
+
+    char const * data () const noexcept
+    {
+        return _data;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    std::size_t alignment () const noexcept
+    {
+        return _alignment;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * Checks buffer is allocated in huge pages.
+     */
+    bool huge_pages () const noexcept
+    {
+        return _mapped_size > 0;
+    }
+
+    void swap (aligned_buffer & other) noexcept
+    {
+        using std::swap;
+        swap(_data, other._data);
+        swap(_size, other._size);
+        swap(_alignment, other._alignment);
+        swap(_mapped_size, other._mapped_size);
+    }
+
+public: // static
+    /**
+     * Rounds @a n up to multiple of @a alignment (must be power of two).
+     */
+    static constexpr std::size_t align_up (std::size_t n, std::size_t alignment) noexcept
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+};
+
+} // namespace ionik
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/ionik/exports.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ionik {
+namespace audio {
+
+/**
+ * Statistics of the normalized (in range [-1.0, 1.0]) samples of a single channel.
+ */
+struct sample_stats
+{
+    std::size_t count {0};
+    double sum {0};
+    double sum_squares {0};
+    float min {(std::numeric_limits<float>::max)()};
+    float max {std::numeric_limits<float>::lowest()};
+
+    float mean () const noexcept
+    {
+        return count > 0 ? static_cast<float>(sum / count) : 0.0f;
+    }
+
+    float rms () const noexcept
+    {
+        return count > 0 ? static_cast<float>(std::sqrt(sum_squares / count)) : 0.0f;
+    }
+
+    /**
+     * Merges statistics of another range of samples.
+     */
+    void merge (sample_stats const & other) noexcept
+    {
+        if (other.count == 0)
+            return;
+
+        count += other.count;
+        sum += other.sum;
+        sum_squares += other.sum_squares;
+
+        if (other.min < min)
+            min = other.min;
+
+        if (other.max > max)
+            max = other.max;
+    }
+};
+
+enum class simd_enum: std::int8_t
+{
+      scalar
+    , sse2
+    , avx2
+    , neon
+};
+
+/**
+ * Instruction set used by the sample kernels (selected at runtime by CPU features).
+ */
+IONIK__EXPORT simd_enum sample_kernels_simd () noexcept;
+
+/**
+ * Accumulates statistics of @a frame_count interleaved frames of @a channels (1 or 2) signed
+ * 16-bit samples into @a stats (array of @a channels elements). Sample value is normalized by
+ * division by 32767 (-32768 is clamped to -32767).
+ *
+ * @details Only each @a frame_step frame is accounted (starting from the first one).
+ *          Vectorized if @a frame_step is 1, decimated frames are reduced by scalar loop (there
+ *          is a single sample per cache line for large steps anyway).
+ */
+IONIK__EXPORT void reduce_samples (std::int16_t const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept;
+
+/**
+ * Unsigned 8-bit samples version of `reduce_samples`. Sample value is normalized as
+ * `(value - 128) / 255`.
+ */
+IONIK__EXPORT void reduce_samples (std::uint8_t const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept;
+
+/**
+ * Floating point samples version of `reduce_samples`. Samples are accounted as is.
+ */
+IONIK__EXPORT void reduce_samples (float const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept;
+
+}} // namespace ionik::audio
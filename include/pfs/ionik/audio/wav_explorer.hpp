@@ -5,11 +5,23 @@
 //
 // Changelog:
 //      2023.10.10 Initial version.
+//      2026.10.15 `wav_explorer` is generalized by file provider (`basic_wav_explorer`).
+//      2026.10.15 Added `compressed_wav_explorer`.
+//      2026.10.15 Decoding buffer is borrowed from `buffer_pool`.
+//      2026.10.15 Added multi-threaded spectrum building.
+//      2026.10.15 Added `wav_envelope`.
+//      2026.10.15 Added envelope mode of `wav_spectrum_builder`.
+//      2026.10.15 Added decoding from memory mapped data.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "pfs/ionik/buffer_pool.hpp"
 #include "pfs/ionik/error.hpp"
 #include "pfs/ionik/exports.hpp"
 #include "pfs/ionik/local_file.hpp"
+#include "pfs/ionik/memory_file.hpp"
+#if IONIK__HAS_ZSTD
+#   include "pfs/ionik/compressed_file.hpp"
+#endif
 #include "pfs/optional.hpp"
 #include "pfs/endian.hpp"
 #include "pfs/filesystem.hpp"
@@ -62,10 +74,17 @@ inline constexpr bool is_stereo16 (wav_info const & info)
     return info.sample_size <= 16 && info.num_channels == 2;
 }
 
-class wav_explorer
+enum class mapping_enum: std::int8_t
 {
-    local_file _wav_file;
+      off
+    , on
+};
 
+/**
+ * Base of WAV explorers, independent of the file provider.
+ */
+class wav_explorer_base
+{
 public:
     // Decoder callbacks
     mutable std::function<void (error const &)> on_error = [] (error const &) {};
@@ -81,14 +100,100 @@ public:
     mutable std::function<bool (char const *, std::size_t)> on_raw_data
         = [] (char const *, std::size_t) {return true;};
 
+protected:
+    buffer_pool * _buffer_pool {& buffer_pool::shared()};
+    mapping_enum _mapping {mapping_enum::off};
+
 public:
-    IONIK__EXPORT wav_explorer (local_file && wav_file);
-    IONIK__EXPORT wav_explorer (pfs::filesystem::path const & path, error * perr = nullptr);
+    virtual ~wav_explorer_base () = default;
+
+    /**
+     * Sets pool to borrow decoding buffer from (shared pool by default). Pool must outlive
+     * the explorer.
+     */
+    void set_buffer_pool (buffer_pool & pool) noexcept
+    {
+        _buffer_pool = & pool;
+    }
+
+    buffer_pool & get_buffer_pool () const noexcept
+    {
+        return *_buffer_pool;
+    }
+
+    /**
+     * Enables decoding of memory mapped samples data: `on_raw_data` receives pointers into the
+     * mapping (sequential access is advised), so data already in the page cache is not copied.
+     * Decoding falls back to reading if mapping fails or is not zero-copy for the file
+     * provider (compressed files).
+     *
+     * @note Truncation of the file by another process while decoding crashes the process
+     *       (SIGBUS on POSIX) in this mode.
+     */
+    void set_mapping (mapping_enum value) noexcept
+    {
+        _mapping = value;
+    }
+
+    virtual pfs::optional<wav_info> read_header (error * perr = nullptr) = 0;
+    virtual bool decode (std::size_t frames_chunk_size = 1024) = 0;
+
+    /**
+     * Reads up to @a len bytes at @a offset of the WAV file without changing the file
+     * position. Can be called concurrently from several threads.
+     */
+    virtual std::pair<filesize_t, bool> read_at (filesize_t offset, char * buffer
+        , std::size_t len, error * perr = nullptr) const = 0;
+
+    /**
+     * @return @c true if `read_at()` calls are cheap and really run concurrently (@c false for
+     *         compressed files: reads are serialized and decompression restarts for each of
+     *         them).
+     */
+    virtual bool concurrent_reads () const noexcept = 0;
+};
+
+/**
+ * WAV explorer reading data through file of specified provider, e.g. `memory_file_provider`
+ * to explore already loaded data.
+ */
+template <typename FileProvider>
+class basic_wav_explorer: public wav_explorer_base
+{
+public:
+    using file_type = file<FileProvider>;
+    using filepath_type = typename FileProvider::filepath_type;
+
+private:
+    file_type _wav_file;
+
+public:
+    basic_wav_explorer (file_type && wav_file);
+    basic_wav_explorer (filepath_type const & path, error * perr = nullptr);
+
+    pfs::optional<wav_info> read_header (error * perr = nullptr) override;
+    bool decode (std::size_t frames_chunk_size = 1024) override;
 
-    IONIK__EXPORT pfs::optional<wav_info> read_header (error * perr = nullptr);
-    IONIK__EXPORT bool decode (std::size_t frames_chunk_size = 1024);
+    std::pair<filesize_t, bool> read_at (filesize_t offset, char * buffer, std::size_t len
+        , error * perr = nullptr) const override
+    {
+        return _wav_file.read_at(offset, buffer, len, perr);
+    }
+
+    bool concurrent_reads () const noexcept override;
 };
 
+extern template class IONIK__EXPORT basic_wav_explorer<local_file_provider>;
+extern template class IONIK__EXPORT basic_wav_explorer<memory_file_provider>;
+
+using wav_explorer = basic_wav_explorer<local_file_provider>;
+using memory_wav_explorer = basic_wav_explorer<memory_file_provider>;
+
+#if IONIK__HAS_ZSTD
+extern template class IONIK__EXPORT basic_wav_explorer<compressed_file_provider>;
+using compressed_wav_explorer = basic_wav_explorer<compressed_file_provider>;
+#endif
+
 template <typename SampleType>
 struct mono_frame
 {
@@ -194,6 +299,31 @@ using s16_stereo_frame_iterator = frame_iterator<stereo_frame<std::int16_t>>;
 using f32_mono_frame_iterator   = frame_iterator<mono_frame<float>>;
 using f32_stereo_frame_iterator = frame_iterator<stereo_frame<float>>;
 
+/**
+ * Waveform envelope: minimum, maximum and RMS of normalized samples for each point (chunk of
+ * frames) of each channel. Values are stored in structure-of-arrays layout, so a channel can
+ * be drawn or uploaded to GPU directly.
+ */
+struct wav_envelope
+{
+    struct channel_data
+    {
+        std::vector<float> min;
+        std::vector<float> max;
+        std::vector<float> rms;
+    };
+
+    std::vector<channel_data> channels;
+
+    /**
+     * Number of points.
+     */
+    std::size_t size () const noexcept
+    {
+        return channels.empty() ? 0 : channels.front().min.size();
+    }
+};
+
 struct wav_spectrum
 {
     // For mono frames second part of pair is unused
@@ -203,6 +333,16 @@ struct wav_spectrum
     unified_frame max_frame;
     std::vector<unified_frame> data;
     wav_info info;
+
+    // Per chunk envelope (parallel to `data`), built if enabled by
+    // `wav_spectrum_builder::set_envelope()`
+    wav_envelope envelope;
+};
+
+enum class envelope_enum: std::int8_t
+{
+      off
+    , on
 };
 
 class wav_spectrum_builder
@@ -210,28 +350,57 @@ class wav_spectrum_builder
     struct builder_context
     {
         std::size_t frame_step;
+        bool envelope {false};
         error err;
         wav_spectrum spectrum;
     };
 
 private:
-    wav_explorer * _explorer {nullptr};
+    wav_explorer_base * _explorer {nullptr};
+    std::size_t _thread_count {1};
+    envelope_enum _envelope {envelope_enum::off};
 
     bool (wav_spectrum_builder::*_build_proc) (builder_context &, char const *, std::size_t) {nullptr};
 
 private:
+    bool prepare (builder_context & ctx, wav_info const & info, std::size_t chunk_count
+        , std::size_t * frames_chunk_size);
+    bool build_sequential (builder_context & ctx, std::size_t chunk_count);
+    bool build_parallel (builder_context & ctx, std::size_t chunk_count, std::size_t thread_count);
     bool build_from_mono8 (builder_context &, char const *, std::size_t);
     bool build_from_stereo8 (builder_context & ctx, char const *, std::size_t);
     bool build_from_mono16 (builder_context & ctx, char const *, std::size_t);
     bool build_from_stereo16 (builder_context & ctx, char const *, std::size_t);
 
 public:
-    wav_spectrum_builder (wav_explorer & explorer)
+    wav_spectrum_builder (wav_explorer_base & explorer)
         : _explorer(& explorer)
     {}
 
-    IONIK__EXPORT pfs::optional<wav_spectrum> operator () (std::size_t chunk_count, std::size_t frame_step
-        , error * perr = nullptr);
+    /**
+     * Sets number of threads building the spectrum (1 by default, 0 for the number of hardware
+     * threads). With several threads data chunks are read by positional reads and reduced
+     * concurrently, the result is the same as built by the single thread. Spectrum is built
+     * by the single thread if explorer does not support concurrent reads (see
+     * `wav_explorer_base::concurrent_reads()`).
+     */
+    void set_thread_count (std::size_t n) noexcept
+    {
+        _thread_count = n;
+    }
+
+    /**
+     * Enables building of per chunk envelope (minimum, maximum and RMS of each channel, see
+     * `wav_spectrum::envelope`) in the same pass with averaged data. Envelope accounts all
+     * frames to catch peaks, so frame step is ignored (set to 1) if enabled.
+     */
+    void set_envelope (envelope_enum value) noexcept
+    {
+        _envelope = value;
+    }
+
+    IONIK__EXPORT pfs::optional<wav_spectrum> operator () (std::size_t chunk_count
+        , std::size_t frame_step, error * perr = nullptr);
 
     pfs::optional<wav_spectrum> operator () (std::size_t chunk_count, error * perr = nullptr)
     {
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/ionik/error.hpp"
+#include "pfs/ionik/exports.hpp"
+#include "wav_explorer.hpp"
+#include "pfs/filesystem.hpp"
+#include "pfs/optional.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ionik {
+namespace audio {
+
+/**
+ * Multi-resolution waveform (mip-map) of WAV file samples. Level 0 keeps envelope of chunks of
+ * `base_frames()` frames, each next level merges pairs of chunks of the previous one, up to the
+ * level of a single chunk. Any range of frames can be queried with any resolution in time
+ * proportional to the number of requested points, so zooming and scrolling do not rescan
+ * samples.
+ *
+ * @details Pyramid is built by a single decoding pass and can be persisted in a sidecar file
+ *          (see `open()`), it takes about `2 * 3 * sizeof(float) / base_frames()` bytes per
+ *          frame of each channel.
+ */
+class waveform_pyramid
+{
+public:
+    static constexpr std::size_t DEFAULT_BASE_FRAMES = 256;
+
+private:
+    std::size_t _channels {0};
+    std::size_t _base_frames {DEFAULT_BASE_FRAMES};
+    std::uint64_t _frame_count {0};
+    std::vector<wav_envelope> _levels;
+
+    // Size and modification time (nanoseconds since epoch) of the WAV file the pyramid is built
+    // from, set by `open()` to check the sidecar file is up to date (zero if unknown).
+    std::uint64_t _source_size {0};
+    std::int64_t _source_mtime {0};
+
+private:
+    void build_levels ();
+    std::size_t chunk_frames (std::size_t level, std::size_t index) const noexcept;
+
+public:
+    waveform_pyramid () = default;
+
+    std::size_t channels () const noexcept
+    {
+        return _channels;
+    }
+
+    /**
+     * Number of frames in the chunk of level 0.
+     */
+    std::size_t base_frames () const noexcept
+    {
+        return _base_frames;
+    }
+
+    std::uint64_t frame_count () const noexcept
+    {
+        return _frame_count;
+    }
+
+    std::size_t level_count () const noexcept
+    {
+        return _levels.size();
+    }
+
+    /**
+     * Envelope of the level @a n (chunks of `base_frames() << n` frames, the last chunk may
+     * be incomplete).
+     */
+    wav_envelope const & level (std::size_t n) const
+    {
+        return _levels.at(n);
+    }
+
+    /**
+     * Returns envelope of @a count points covering frames in range [@a first_frame,
+     * @a last_frame) (range is clipped by the number of frames). Each point is built from
+     * the coarsest level which chunks are not wider than the point, point boundaries are
+     * rounded to the chunks of that level.
+     */
+    IONIK__EXPORT wav_envelope query (std::uint64_t first_frame, std::uint64_t last_frame
+        , std::size_t count) const;
+
+    /**
+     * Returns envelope of @a count points covering all frames.
+     */
+    wav_envelope query (std::size_t count) const
+    {
+        return query(0, _frame_count, count);
+    }
+
+    /**
+     * Saves pyramid into the file @a path (replaced atomically).
+     */
+    IONIK__EXPORT bool save (pfs::filesystem::path const & path, error * perr = nullptr) const;
+
+public: // static
+    /**
+     * Builds pyramid by decoding samples (8/16 bits, mono/stereo) with @a explorer. Decoder
+     * callbacks of @a explorer are replaced while decoding and restored on return.
+     */
+    static IONIK__EXPORT pfs::optional<waveform_pyramid> build (wav_explorer_base & explorer
+        , std::size_t base_frames = DEFAULT_BASE_FRAMES, error * perr = nullptr);
+
+    /**
+     * Loads pyramid saved by `save()`.
+     */
+    static IONIK__EXPORT pfs::optional<waveform_pyramid> load (
+        pfs::filesystem::path const & path, error * perr = nullptr);
+
+    /**
+     * Path of the sidecar file for the WAV file @a wav_path (".wfp" is appended).
+     */
+    static IONIK__EXPORT pfs::filesystem::path sidecar_path (
+        pfs::filesystem::path const & wav_path);
+
+    /**
+     * Loads pyramid of the WAV file @a wav_path from the sidecar file if it is built from the
+     * file of the same size and modification time and has the same @a base_frames. Otherwise
+     * builds pyramid and saves it into the sidecar file (failure to save is ignored, the sidecar
+     * is just a cache).
+     *
+     * @note Staleness is judged by size and modification time only: the file replaced by the
+     *       file of the same size with the same modification time is not detected.
+     */
+    static IONIK__EXPORT pfs::optional<waveform_pyramid> open (
+        pfs::filesystem::path const & wav_path, std::size_t base_frames = DEFAULT_BASE_FRAMES
+        , error * perr = nullptr);
+};
+
+}} // namespace ionik::audio
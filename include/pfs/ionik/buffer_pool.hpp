@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "aligned_buffer.hpp"
+#include "exports.hpp"
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ionik {
+
+class buffer_pool;
+
+/**
+ * Buffer borrowed from the `buffer_pool`. Storage is returned to the pool on destruction,
+ * so the pool must outlive its buffers.
+ */
+class pooled_buffer
+{
+    friend class buffer_pool;
+
+    buffer_pool * _pool {nullptr};
+    aligned_buffer _buf;
+    std::size_t _size {0};
+
+private:
+    pooled_buffer (buffer_pool * pool, aligned_buffer && buf, std::size_t size)
+        : _pool(pool)
+        , _buf(std::move(buf))
+        , _size(size)
+    {}
+
+public:
+    pooled_buffer () = default;
+
+    pooled_buffer (pooled_buffer const &) = delete;
+    pooled_buffer & operator = (pooled_buffer const &) = delete;
+
+    pooled_buffer (pooled_buffer && other) noexcept
+    {
+        swap(other);
+    }
+
+    pooled_buffer & operator = (pooled_buffer && other) noexcept
+    {
+        pooled_buffer tmp {std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    ~pooled_buffer ()
+    {
+        release();
+    }
+
+    char * data () noexcept
+    {
+        return _buf.data();
+    }
+
+    char const * data () const noexcept
+    {
+        return _buf.data();
+    }
+
+    char & operator [] (std::size_t i) noexcept
+    {
+        return _buf.data()[i];
+    }
+
+    char const & operator [] (std::size_t i) const noexcept
+    {
+        return _buf.data()[i];
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    std::size_t capacity () const noexcept
+    {
+        return _buf.size();
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    void clear () noexcept
+    {
+        _size = 0;
+    }
+
+    /**
+     * Resizes buffer preserving its content. Larger storage is borrowed from the same pool
+     * (from the shared pool if buffer is default constructed).
+     *
+     * @throws std::bad_alloc on allocation failure.
+     */
+    IONIK__EXPORT void resize (std::size_t size);
+
+    /**
+     * Returns storage to the pool, buffer becomes empty.
+     */
+    IONIK__EXPORT void release () noexcept;
+
+    void swap (pooled_buffer & other) noexcept
+    {
+        using std::swap;
+        swap(_pool, other._pool);
+        _buf.swap(other._buf);
+        swap(_size, other._size);
+    }
+};
+
+/**
+ * Thread-safe pool of aligned buffers reused between calls, so periodic reads (e.g. polling of
+ * `/proc` entries or decoding in long-lived processes) do not allocate memory each time.
+ *
+ * @details Storage is allocated with power of two capacity and cached on release up to the
+ *          limits of buffer count and total bytes. Buffers larger than the maximum cacheable
+ *          size are allocated exactly (rounded to alignment) and freed on release, so a single
+ *          large read does not pin memory for the life of the pool. Acquired buffer is the
+ *          smallest cached one large enough for the request.
+ */
+class buffer_pool
+{
+    friend class pooled_buffer;
+
+public:
+    static constexpr std::size_t DEFAULT_ALIGNMENT = 4096;
+    static constexpr std::size_t DEFAULT_MAX_CACHED = 16;
+    static constexpr std::size_t DEFAULT_MAX_CACHED_BYTES = 64 * 1024 * 1024;
+    static constexpr std::size_t DEFAULT_MAX_BUFFER_SIZE = 16 * 1024 * 1024;
+
+private:
+    std::size_t _alignment {DEFAULT_ALIGNMENT};
+    huge_pages_enum _huge {huge_pages_enum::off};
+    std::size_t _max_cached {DEFAULT_MAX_CACHED};
+    std::size_t _max_cached_bytes {DEFAULT_MAX_CACHED_BYTES};
+    std::size_t _max_buffer_size {DEFAULT_MAX_BUFFER_SIZE};
+    mutable std::mutex _mtx;
+    std::vector<aligned_buffer> _cache;
+    std::size_t _cached_bytes {0};
+
+public:
+    /**
+     * Constructs pool of buffers aligned to @a alignment (see `aligned_buffer`) and allocated
+     * in huge pages if @a huge is @c on and huge pages are available. At most @a max_cached
+     * released buffers of total @a max_cached_bytes capacity are kept for reuse, buffers of
+     * capacity larger than @a max_buffer_size are never cached.
+     */
+    IONIK__EXPORT buffer_pool (std::size_t alignment = DEFAULT_ALIGNMENT
+        , huge_pages_enum huge = huge_pages_enum::off, std::size_t max_cached = DEFAULT_MAX_CACHED
+        , std::size_t max_cached_bytes = DEFAULT_MAX_CACHED_BYTES
+        , std::size_t max_buffer_size = DEFAULT_MAX_BUFFER_SIZE);
+
+    buffer_pool (buffer_pool const &) = delete;
+    buffer_pool (buffer_pool &&) = delete;
+    buffer_pool & operator = (buffer_pool const &) = delete;
+    buffer_pool & operator = (buffer_pool &&) = delete;
+
+    /**
+     * Borrows buffer of @a size bytes (content is undefined).
+     *
+     * @throws std::bad_alloc on allocation failure.
+     */
+    IONIK__EXPORT pooled_buffer acquire (std::size_t size);
+
+    /**
+     * Number of cached (released) buffers.
+     */
+    IONIK__EXPORT std::size_t cached () const;
+
+    /**
+     * Total capacity of cached (released) buffers.
+     */
+    IONIK__EXPORT std::size_t cached_bytes () const;
+
+    /**
+     * Frees cached buffers.
+     */
+    IONIK__EXPORT void clear ();
+
+public: // static
+    /**
+     * Process-wide pool with default parameters.
+     */
+    static IONIK__EXPORT buffer_pool & shared ();
+
+private:
+    void recycle (aligned_buffer && buf) noexcept;
+};
+
+} // namespace ionik
@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "file.hpp"
+#include <pfs/i18n.hpp>
+#include <pfs/numeric_cast.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace ionik {
+
+/**
+ * Reader serving small reads from the in-process buffer filled by large blocks.
+ *
+ * @details Reader starts from the current position of the file. The file position is
+ *          undefined while reading through the reader, use `sync_pos()` to set it to the
+ *          logical position of the reader before accessing the file directly.
+ */
+template <typename FileProvider>
+class buffered_reader
+{
+public:
+    using file_type = file<FileProvider>;
+    using filesize_type = typename file_type::filesize_type;
+    using read_result_type = typename file_type::read_result_type;
+
+private:
+    file_type * _f {nullptr};
+    std::vector<char> _buffer;
+    std::size_t _begin {0};          // Read position in the buffer
+    std::size_t _end {0};            // End of valid data in the buffer
+    filesize_type _buffer_offset {0}; // File offset of the buffer start
+
+public:
+    /**
+     * @param f File to read from.
+     * @param block_size Buffer size, also the minimal size of the read request to the file.
+     */
+    buffered_reader (file_type & f, std::size_t block_size = 4096, error * perr = nullptr)
+        : _f(& f)
+        , _buffer((std::max)(block_size, std::size_t{1}))
+    {
+        auto off_res = _f->offset(perr);
+
+        if (off_res.second)
+            _buffer_offset = off_res.first;
+    }
+
+    buffered_reader (buffered_reader const &) = delete;
+    buffered_reader & operator = (buffered_reader const &) = delete;
+    buffered_reader (buffered_reader &&) = default;
+    buffered_reader & operator = (buffered_reader &&) = default;
+
+    /**
+     * Logical position of the reader in the file.
+     */
+    filesize_type offset () const noexcept
+    {
+        return _buffer_offset + _begin;
+    }
+
+    /**
+     * Number of bytes available in the buffer.
+     */
+    std::size_t available () const noexcept
+    {
+        return _end - _begin;
+    }
+
+    /**
+     * Read data chunk. Requests greater than the block size are read directly into @a buffer.
+     *
+     * @return Actually read chunk size and success flag (see `file::read()`). Read size less
+     *         than @a len means end of file.
+     */
+    read_result_type read (char * buffer, filesize_type len, error * perr = nullptr)
+    {
+        filesize_type total = 0;
+
+        while (total < len) {
+            if (_begin == _end) {
+                // Bypass buffer for large requests
+                if (len - total >= _buffer.size()) {
+                    auto res = _f->read(buffer + total, len - total, perr);
+
+                    if (!res.second)
+                        return read_result_type{0, false};
+
+                    _buffer_offset += _end + res.first;
+                    _begin = _end = 0;
+                    total += res.first;
+
+                    if (res.first == 0)
+                        break;
+
+                    continue;
+                }
+
+                auto res = fill(perr);
+
+                if (!res.second)
+                    return read_result_type{0, false};
+
+                if (res.first == 0)
+                    break;
+            }
+
+            auto n = (std::min)(pfs::numeric_cast<std::size_t>(len - total), _end - _begin);
+            std::memcpy(buffer + total, _buffer.data() + _begin, n);
+            _begin += n;
+            total += n;
+        }
+
+        return read_result_type{total, true};
+    }
+
+    template <typename T>
+    inline read_result_type read (T & value, error * perr = nullptr)
+    {
+        return read(reinterpret_cast<char *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Read data chunk without consuming it. @a len is limited by the block size.
+     *
+     * @return Actually copied chunk size and success flag.
+     */
+    read_result_type peek (char * buffer, filesize_type len, error * perr = nullptr)
+    {
+        len = (std::min)(len, static_cast<filesize_type>(_buffer.size()));
+
+        while (_end - _begin < len) {
+            auto res = fill(perr);
+
+            if (!res.second)
+                return read_result_type{0, false};
+
+            if (res.first == 0)
+                break;
+        }
+
+        auto n = (std::min)(pfs::numeric_cast<std::size_t>(len), _end - _begin);
+        std::memcpy(buffer, _buffer.data() + _begin, n);
+
+        return read_result_type{n, true};
+    }
+
+    template <typename T>
+    inline read_result_type peek (T & value, error * perr = nullptr)
+    {
+        return peek(reinterpret_cast<char *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Return @a n recently read bytes back to the reader.
+     *
+     * @return @c false if @a n bytes are not in the buffer anymore.
+     */
+    bool unread (std::size_t n) noexcept
+    {
+        if (n > _begin)
+            return false;
+
+        _begin -= n;
+        return true;
+    }
+
+    /**
+     * Skip @a bytes from current logical position.
+     */
+    bool skip (filesize_type bytes, error * perr = nullptr)
+    {
+        if (bytes <= _end - _begin) {
+            _begin += pfs::numeric_cast<std::size_t>(bytes);
+            return true;
+        }
+
+        auto pos = offset() + bytes;
+
+        if (!_f->set_pos(pos, perr))
+            return false;
+
+        _buffer_offset = pos;
+        _begin = _end = 0;
+        return true;
+    }
+
+    /**
+     * Set position of the underlying file to the logical position of the reader.
+     */
+    bool sync_pos (error * perr = nullptr)
+    {
+        // File position is at the end of the buffered data
+        if (offset() != _buffer_offset + _end) {
+            if (!_f->set_pos(offset(), perr))
+                return false;
+        }
+
+        _buffer_offset = offset();
+        _begin = _end = 0;
+        return true;
+    }
+
+private:
+    // Compacts buffer and appends data from the file
+    read_result_type fill (error * perr)
+    {
+        if (_begin > 0) {
+            std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+            _buffer_offset += _begin;
+            _end -= _begin;
+            _begin = 0;
+        }
+
+        auto res = _f->read(_buffer.data() + _end, _buffer.size() - _end, perr);
+
+        if (res.second)
+            _end += pfs::numeric_cast<std::size_t>(res.first);
+
+        return res;
+    }
+};
+
+/**
+ * Writer accumulating small writes in the in-process buffer and writing them by large blocks.
+ * Buffered data is flushed on destruction (errors are ignored), call `flush()` explicitly to
+ * handle errors.
+ */
+template <typename FileProvider>
+class buffered_writer
+{
+public:
+    using file_type = file<FileProvider>;
+    using filesize_type = typename file_type::filesize_type;
+    using write_result_type = typename file_type::write_result_type;
+
+private:
+    file_type * _f {nullptr};
+    std::vector<char> _buffer;
+    std::size_t _size {0}; // Size of buffered data
+
+public:
+    buffered_writer (file_type & f, std::size_t block_size = 4096)
+        : _f(& f)
+        , _buffer((std::max)(block_size, std::size_t{1}))
+    {}
+
+    buffered_writer (buffered_writer const &) = delete;
+    buffered_writer & operator = (buffered_writer const &) = delete;
+
+    buffered_writer (buffered_writer && other)
+        : _f(other._f)
+        , _buffer(std::move(other._buffer))
+        , _size(other._size)
+    {
+        other._f = nullptr;
+        other._size = 0;
+    }
+
+    buffered_writer & operator = (buffered_writer &&) = delete;
+
+    ~buffered_writer ()
+    {
+        if (_f != nullptr && _size > 0) {
+            error err;
+            flush(& err);
+        }
+    }
+
+    /**
+     * Number of bytes waiting for flushing.
+     */
+    std::size_t pending () const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * Write data chunk. Chunks greater than the block size are written directly after flushing
+     * buffered data.
+     *
+     * @return @a len and success flag.
+     */
+    write_result_type write (char const * buffer, filesize_type len, error * perr = nullptr)
+    {
+        if (_size + len > _buffer.size()) {
+            if (!flush(perr))
+                return write_result_type{0, false};
+
+            if (len >= _buffer.size()) {
+                if (!write_fully(buffer, len, perr))
+                    return write_result_type{0, false};
+
+                return write_result_type{len, true};
+            }
+        }
+
+        std::memcpy(_buffer.data() + _size, buffer, pfs::numeric_cast<std::size_t>(len));
+        _size += pfs::numeric_cast<std::size_t>(len);
+
+        return write_result_type{len, true};
+    }
+
+    template <typename T>
+    inline write_result_type write (T const & value, error * perr = nullptr)
+    {
+        return write(reinterpret_cast<char const *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Write buffered data into the file.
+     */
+    bool flush (error * perr = nullptr)
+    {
+        if (_size == 0)
+            return true;
+
+        auto success = write_fully(_buffer.data(), _size, perr);
+        _size = 0;
+        return success;
+    }
+
+private:
+    bool write_fully (char const * buffer, filesize_type len, error * perr)
+    {
+        while (len > 0) {
+            auto res = _f->write(buffer, len, perr);
+
+            if (!res.second)
+                return false;
+
+            if (res.first == 0) {
+                pfs::throw_or(perr, make_error_code(std::errc::io_error)
+                    , tr::_("write into file: no data written"));
+                return false;
+            }
+
+            buffer += res.first;
+            len -= res.first;
+        }
+
+        return true;
+    }
+};
+
+} // namespace ionik
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include "file_provider.hpp"
+#include "pfs/filesystem.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace ionik {
+
+struct compressed_file_context;
+
+/**
+ * Path of the compressed file and compression parameters used on writing.
+ */
+struct compressed_file_path
+{
+    static constexpr int DEFAULT_LEVEL = 3;
+    static constexpr std::size_t DEFAULT_FRAME_SIZE = 1024 * 1024;
+
+    pfs::filesystem::path path;
+    int level {DEFAULT_LEVEL};                    // zstd compression level
+    std::size_t frame_size {DEFAULT_FRAME_SIZE}; // Uncompressed size of the frame
+
+    compressed_file_path () = default;
+
+    compressed_file_path (pfs::filesystem::path p, int lvl = DEFAULT_LEVEL
+        , std::size_t fsize = DEFAULT_FRAME_SIZE)
+        : path(std::move(p))
+        , level(lvl)
+        , frame_size(fsize)
+    {}
+};
+
+/**
+ * Provider of zstd compressed files. Data is split into frames compressed independently, so
+ * any position can be reached by decompressing one frame only. Frame index is stored at the end
+ * of the file in the zstd seekable format (skippable frame ignored by the regular decompressors,
+ * e.g. `zstd -d`). Files without the index (produced by other tools) are indexed by scanning
+ * frame headers on opening.
+ *
+ * @note Files are written sequentially: positional writes are allowed at the end of the file
+ *       only. Pending data is compressed and the index is written on `sync()` and on closing
+ *       (errors are ignored on closing, call `sync()` to handle them). Index of the existing
+ *       file is removed on opening for appending, so interrupted file remains readable (frames
+ *       are indexed by scanning).
+ */
+using compressed_file_handle = compressed_file_context *;
+using compressed_file_provider = file_provider<compressed_file_handle, compressed_file_path>;
+using compressed_file = file<compressed_file_provider>;
+
+} // namespace ionik
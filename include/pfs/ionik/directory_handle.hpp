@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "file.hpp"
+#include "file_provider.hpp"
+#include "local_file.hpp"
+#include <string>
+
+namespace ionik {
+
+/**
+ * Directory opened once to access many files by paths relative to it. Relative lookups
+ * (`openat()`, `fstatat()` on POSIX systems) resolve only the remaining path components, so
+ * polling many files of the same directory (e.g. sysfs or procfs attributes) avoids repeated
+ * resolution of the whole path.
+ *
+ * @note On Windows relative paths are joined to the directory path obtained from the handle.
+ */
+template <typename FileProvider>
+class basic_directory_handle
+{
+public:
+    using filepath_type = typename FileProvider::filepath_type;
+    using handle_type   = typename FileProvider::handle_type;
+    using read_result_type = typename FileProvider::read_result_type;
+    using file_type     = file<FileProvider>;
+
+private:
+    handle_type _h {FileProvider::invalid()};
+
+private:
+    basic_directory_handle (handle_type h)
+        : _h(h)
+    {}
+
+public:
+    basic_directory_handle () {}
+
+    basic_directory_handle (basic_directory_handle const &) = delete;
+    basic_directory_handle & operator = (basic_directory_handle const &) = delete;
+
+    basic_directory_handle (basic_directory_handle && d)
+    {
+        _h = d._h;
+        d._h = FileProvider::invalid();
+    }
+
+    basic_directory_handle & operator = (basic_directory_handle && d)
+    {
+        if (this != & d) {
+            close();
+            _h = d._h;
+            d._h = FileProvider::invalid();
+        }
+
+        return *this;
+    }
+
+    ~basic_directory_handle ()
+    {
+        close();
+    }
+
+    operator bool () const noexcept
+    {
+        return _h != FileProvider::invalid();
+    }
+
+    handle_type native () const noexcept
+    {
+        return _h;
+    }
+
+    void close ()
+    {
+        if (_h != FileProvider::invalid())
+            FileProvider::close(_h);
+
+        _h = FileProvider::invalid();
+    }
+
+    /**
+     * Opens regular file @a path (relative to this directory) for reading.
+     */
+    file_type open_at (filepath_type const & path, error * perr = nullptr) const
+    {
+        file_stat st;
+        auto h = FileProvider::open_read_only_at(_h, path, st, perr);
+
+        if (FileProvider::is_invalid(h))
+            return file_type{};
+
+        return file_type{h, st};
+    }
+
+    /**
+     * Obtains metadata of the entry @a path (relative to this directory) without opening it.
+     */
+    bool stat_at (filepath_type const & path, file_stat & st, error * perr = nullptr) const
+    {
+        return FileProvider::stat_at(_h, path, st, perr);
+    }
+
+    /**
+     * Reads whole content of the file @a path (relative to this directory) into @a result.
+     * Buffer of @a result is reused, so repeated polling does not allocate.
+     */
+    read_result_type read_all_at (filepath_type const & path, std::string & result
+        , error * perr = nullptr) const
+    {
+        auto f = open_at(path, perr);
+
+        if (f)
+            return f.read_all(result, perr);
+
+        result.clear();
+        return read_result_type{0, false};
+    }
+
+    std::string read_all_at (filepath_type const & path, error * perr = nullptr) const
+    {
+        auto f = open_at(path, perr);
+
+        if (f)
+            return f.read_all(perr);
+
+        return std::string{};
+    }
+
+public: // static
+    static basic_directory_handle open (filepath_type const & path, error * perr = nullptr)
+    {
+        auto h = FileProvider::open_directory(path, perr);
+
+        if (FileProvider::is_invalid(h))
+            return basic_directory_handle{};
+
+        return basic_directory_handle{h};
+    }
+};
+
+using directory_handle = basic_directory_handle<local_file_provider>;
+
+} // namespace ionik
@@ -6,21 +6,43 @@
 // Changelog:
 //      2021.10.20 Initial version.
 //      2021.11.01 Complete basic version.
+//      2026.10.15 Added `map_read_only()`.
+//      2026.10.15 `read_all()` reads into single (reusable) buffer.
+//      2026.10.15 Added positional read/write.
+//      2026.10.15 Added scatter/gather (vectored) read/write.
+//      2026.10.15 Added direct I/O mode.
+//      2026.10.15 Added preallocation and punching holes.
+//      2026.10.15 Added kernel-side copy.
+//      2026.10.15 Added `sync()`, `sync_data()` and atomic/durable rewrite.
+//      2026.10.15 Added `advise()` and `readahead()`.
+//      2026.10.15 File metadata is obtained once on opening and cached.
+//      2026.10.15 Files can be opened by `basic_directory_handle`.
+//      2026.10.15 `read_all()` can read into `pooled_buffer`.
+//      2026.10.15 Added non-throwing `try_read()`, `try_write()`, `try_read_at()` and `try_write_at()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "buffer_pool.hpp"
 #include "error.hpp"
 #include "file_provider.hpp"
 #include <pfs/expected.hpp>
 #include <pfs/i18n.hpp>
+#include <pfs/numeric_cast.hpp>
 #include <pfs/optional.hpp>
+#include <algorithm>
+#include <initializer_list>
 #include <string>
 #include <type_traits>
 
 namespace ionik {
 
+template <typename FileProvider>
+class basic_directory_handle;
+
 template <typename FileProvider>
 class file
 {
+    friend class basic_directory_handle<FileProvider>;
+
 public:
     using filepath_type = typename FileProvider::filepath_type;
     using filesize_type = typename FileProvider::filesize_type;
@@ -28,15 +50,19 @@ public:
     using offset_result_type = typename FileProvider::offset_result_type;
     using read_result_type   = typename FileProvider::read_result_type;
     using write_result_type  = typename FileProvider::write_result_type;
+    using mapped_view_type   = typename FileProvider::mapped_view;
 
     static_assert(std::is_unsigned<filesize_type>::value, "File size must be unsigned");
 
 private:
     handle_type _h {FileProvider::invalid()};
-    filesize_type _size {0};
+    file_stat _stat;            // Metadata at the moment of opening
+    std::size_t _alignment {0}; // Non-zero in direct I/O mode
 
 private:
-    file (handle_type h, filesize_type size): _h(h), _size(size) {}
+    file (handle_type h, file_stat const & st, std::size_t alignment = 0)
+        : _h(h), _stat(st), _alignment(alignment)
+    {}
 
 public:
     file () {}
@@ -47,9 +73,11 @@ public:
     file (file && f)
     {
         _h = f._h;
-        _size = f._size;
+        _stat = f._stat;
+        _alignment = f._alignment;
         f._h = FileProvider::invalid();
-        f._size = 0;
+        f._stat = file_stat{};
+        f._alignment = 0;
     }
 
     file & operator = (file && f)
@@ -57,9 +85,11 @@ public:
         if (this != & f) {
             close();
             _h = f._h;
-            _size = f._size;
+            _stat = f._stat;
+            _alignment = f._alignment;
             f._h = FileProvider::invalid();
-            f._size = 0;
+            f._stat = file_stat{};
+            f._alignment = 0;
         }
 
         return *this;
@@ -80,6 +110,31 @@ public:
         return _h;
     }
 
+    /**
+     * File metadata obtained on opening.
+     */
+    file_stat const & stat () const noexcept
+    {
+        return _stat;
+    }
+
+    /**
+     * File size at the moment of opening.
+     */
+    filesize_type size () const noexcept
+    {
+        return _stat.size;
+    }
+
+    /**
+     * Alignment required for buffers, sizes and offsets if file is opened in direct I/O mode,
+     * zero otherwise.
+     */
+    std::size_t alignment () const noexcept
+    {
+        return _alignment;
+    }
+
     void close () noexcept
     {
         if (!FileProvider::is_invalid(_h))
@@ -107,6 +162,9 @@ public:
      */
     read_result_type read (char * buffer, filesize_type len, error * perr = nullptr)
     {
+        if (!check_direct(buffer, len, 0, perr))
+            return read_result_type{0, false};
+
         return FileProvider::read(_h, buffer, len, perr);
     }
 
@@ -117,21 +175,38 @@ public:
     }
 
     /**
-     * Read all content from file started from specified @a offset.
+     * Read all content from file started from current position into @a result.
+     *
+     * @details Previous content of @a result is replaced, its capacity is reused,
+     *          so the same buffer can be passed through subsequent calls to avoid
+     *          allocations. Buffer is allocated at once if file size is known and
+     *          grows geometrically otherwise (e.g. for `/proc` entries).
+     *          Not supported in direct I/O mode.
+     *
+     * @return { n, true } on success, where @a n is a size of read content;
+     *         { 0, false } on failure, @a result is cleared.
      */
-    std::string read_all (error * perr = nullptr)
+    read_result_type read_all (std::string & result, error * perr = nullptr)
     {
-        std::string result;
-        char buffer[512];
-
-        auto n = FileProvider::read(_h, buffer, 512, perr);
-
-        while (n.first > 0) {
-            result.append(buffer, n.first);
+        return read_all_into(result, perr);
+    }
 
-            n = FileProvider::read(_h, buffer, 512, perr);
-        }
+    /**
+     * Same as `read_all(std::string &, error *)`, but reads into the buffer borrowed from the
+     * `buffer_pool` (from the shared pool if @a result is empty).
+     */
+    read_result_type read_all (pooled_buffer & result, error * perr = nullptr)
+    {
+        return read_all_into(result, perr);
+    }
 
+    /**
+     * Read all content from file started from current position.
+     */
+    std::string read_all (error * perr = nullptr)
+    {
+        std::string result;
+        auto n = read_all(result, perr);
         return n.second ? result : std::string{};
     }
 
@@ -140,6 +215,9 @@ public:
      */
     write_result_type write (char const * buffer, filesize_type len, error * perr = nullptr)
     {
+        if (!check_direct(buffer, len, 0, perr))
+            return write_result_type{0, false};
+
         return FileProvider::write(_h, buffer, len, perr);
     }
 
@@ -152,12 +230,174 @@ public:
         return write(reinterpret_cast<char const *>(& value), sizeof(T), perr);
     }
 
+    /**
+     * Read data chunk from file at specified @a offset. File position is not used, so this
+     * method can be called concurrently from several threads for the same file.
+     *
+     * @return Actually read chunk size and success flag (see `read()`).
+     */
+    read_result_type read_at (filesize_type offset, char * buffer, filesize_type len
+        , error * perr = nullptr) const
+    {
+        if (!check_direct(buffer, len, offset, perr))
+            return read_result_type{0, false};
+
+        return FileProvider::read_at(_h, offset, buffer, len, perr);
+    }
+
+    template <typename T>
+    inline read_result_type read_at (filesize_type offset, T & value, error * perr = nullptr) const
+    {
+        return read_at(offset, reinterpret_cast<char *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Write buffer to file at specified @a offset. File position is not used, so this
+     * method can be called concurrently from several threads for the same file.
+     */
+    write_result_type write_at (filesize_type offset, char const * buffer, filesize_type len
+        , error * perr = nullptr)
+    {
+        if (!check_direct(buffer, len, offset, perr))
+            return write_result_type{0, false};
+
+        return FileProvider::write_at(_h, offset, buffer, len, perr);
+    }
+
+    template <typename T>
+    inline write_result_type write_at (filesize_type offset, T const & value, error * perr = nullptr)
+    {
+        return write_at(offset, reinterpret_cast<char const *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Non-throwing version of `read()` for hot loops (e.g. reading non-blocking descriptors):
+     * failure is reported by error code in the result (see `io_result`), nothing is allocated.
+     */
+    io_result try_read (char * buffer, filesize_type len)
+    {
+        if (!is_direct_aligned(buffer, len, 0))
+            return misaligned_result(io_op_enum::read);
+
+        return FileProvider::try_read(_h, buffer, len);
+    }
+
+    /**
+     * Non-throwing version of `write()` (see `try_read()`).
+     */
+    io_result try_write (char const * buffer, filesize_type len)
+    {
+        if (!is_direct_aligned(buffer, len, 0))
+            return misaligned_result(io_op_enum::write);
+
+        return FileProvider::try_write(_h, buffer, len);
+    }
+
+    /**
+     * Non-throwing version of `read_at()` (see `try_read()`).
+     */
+    io_result try_read_at (filesize_type offset, char * buffer, filesize_type len) const
+    {
+        if (!is_direct_aligned(buffer, len, offset))
+            return misaligned_result(io_op_enum::read_at);
+
+        return FileProvider::try_read_at(_h, offset, buffer, len);
+    }
+
+    /**
+     * Non-throwing version of `write_at()` (see `try_read()`).
+     */
+    io_result try_write_at (filesize_type offset, char const * buffer, filesize_type len)
+    {
+        if (!is_direct_aligned(buffer, len, offset))
+            return misaligned_result(io_op_enum::write_at);
+
+        return FileProvider::try_write_at(_h, offset, buffer, len);
+    }
+
+    /**
+     * Read data from file into several buffers by single call (scatter read).
+     *
+     * @return Total read size and success flag (see `read()`).
+     */
+    read_result_type read_v (io_buffer const * bufs, std::size_t count, error * perr = nullptr)
+    {
+        if (!check_direct_v(bufs, count, 0, perr))
+            return read_result_type{0, false};
+
+        return FileProvider::read_v(_h, bufs, count, perr);
+    }
+
+    read_result_type read_v (std::initializer_list<io_buffer> bufs, error * perr = nullptr)
+    {
+        return read_v(bufs.begin(), bufs.size(), perr);
+    }
+
+    /**
+     * Write data from several buffers into file by single call (gather write).
+     *
+     * @details Values can be passed as buffers using `make_io_buffer()`, e.g.:
+     * @code
+     * f.write_v({make_io_buffer(header), {payload.data(), payload.size()}, make_io_buffer(crc)});
+     * @endcode
+     *
+     * @return Total written size and success flag.
+     */
+    write_result_type write_v (const_io_buffer const * bufs, std::size_t count, error * perr = nullptr)
+    {
+        if (!check_direct_v(bufs, count, 0, perr))
+            return write_result_type{0, false};
+
+        return FileProvider::write_v(_h, bufs, count, perr);
+    }
+
+    write_result_type write_v (std::initializer_list<const_io_buffer> bufs, error * perr = nullptr)
+    {
+        return write_v(bufs.begin(), bufs.size(), perr);
+    }
+
+    /**
+     * Positional scatter read (see `read_at()` and `read_v()`).
+     */
+    read_result_type read_v_at (filesize_type offset, io_buffer const * bufs, std::size_t count
+        , error * perr = nullptr) const
+    {
+        if (!check_direct_v(bufs, count, offset, perr))
+            return read_result_type{0, false};
+
+        return FileProvider::read_v_at(_h, offset, bufs, count, perr);
+    }
+
+    read_result_type read_v_at (filesize_type offset, std::initializer_list<io_buffer> bufs
+        , error * perr = nullptr) const
+    {
+        return read_v_at(offset, bufs.begin(), bufs.size(), perr);
+    }
+
+    /**
+     * Positional gather write (see `write_at()` and `write_v()`).
+     */
+    write_result_type write_v_at (filesize_type offset, const_io_buffer const * bufs
+        , std::size_t count, error * perr = nullptr)
+    {
+        if (!check_direct_v(bufs, count, offset, perr))
+            return write_result_type{0, false};
+
+        return FileProvider::write_v_at(_h, offset, bufs, count, perr);
+    }
+
+    write_result_type write_v_at (filesize_type offset, std::initializer_list<const_io_buffer> bufs
+        , error * perr = nullptr)
+    {
+        return write_v_at(offset, bufs.begin(), bufs.size(), perr);
+    }
+
     /**
      * Set file position by @a offset.
      */
     bool set_pos (filesize_type pos, error * perr = nullptr)
     {
-        if (pos >= _size) {
+        if (pos >= _stat.size) {
             pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
                 , tr::f_("new file position is out of bounds"));
             return false;
@@ -179,6 +419,213 @@ public:
         return set_pos(off_res.first + bytes, perr);
     }
 
+    /**
+     * Map file region into memory for reading without copying.
+     *
+     * @param offset Offset of the region from the start of the file.
+     * @param len Region size.
+     * @param advice Expected access pattern for the region.
+     * @param perr Pointer to store error if not @c null. If @a perr is null
+     *        function may throw an error.
+     *
+     * @return Mapped view, empty view if @a len is zero or on failure.
+     *
+     * @note The view stays valid after the file is closed.
+     */
+    mapped_view_type map_read_only (filesize_type offset, filesize_type len
+        , advice_enum advice = advice_enum::normal, error * perr = nullptr) const
+    {
+        if (offset > _stat.size || len > _stat.size - offset) {
+            pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
+                , tr::f_("mapped region is out of bounds"));
+            return mapped_view_type{};
+        }
+
+        return FileProvider::map_read_only(_h, offset, len, advice, perr);
+    }
+
+    /**
+     * Map whole file into memory for reading without copying.
+     */
+    mapped_view_type map_read_only (advice_enum advice = advice_enum::normal
+        , error * perr = nullptr) const
+    {
+        return map_read_only(0, _stat.size, advice, perr);
+    }
+
+    /**
+     * Allocate disk blocks for the first @a bytes of the file without changing file size,
+     * so subsequent writes do not stall on block allocation and file is not fragmented.
+     * Does nothing if the platform or file system does not support allocation.
+     */
+    bool reserve (filesize_type bytes, error * perr = nullptr)
+    {
+        return FileProvider::reserve(_h, 0, bytes, perr);
+    }
+
+    /**
+     * Deallocate disk blocks of the region [@a offset, @a offset + @a len) without changing file
+     * size. Subsequent reads of the region return zeros.
+     */
+    bool punch_hole (filesize_type offset, filesize_type len, error * perr = nullptr)
+    {
+        return FileProvider::punch_hole(_h, offset, len, perr);
+    }
+
+    /**
+     * Announce expected access pattern for the region [@a offset, @a offset + @a len) of the file
+     * (zero @a len means up to the end of file), so the kernel can tune readahead and caching.
+     * The advice is a hint only and ignored where not supported.
+     */
+    bool advise (advice_enum advice, filesize_type offset = 0, filesize_type len = 0
+        , error * perr = nullptr) const
+    {
+        return FileProvider::advise(_h, offset, len, advice, perr);
+    }
+
+    /**
+     * Start reading the region [@a offset, @a offset + @a len) into the page cache in background,
+     * so subsequent reads of the region do not block on the device.
+     */
+    bool readahead (filesize_type offset, filesize_type len, error * perr = nullptr) const
+    {
+        return FileProvider::readahead(_h, offset, len, perr);
+    }
+
+    /**
+     * Flush file data and metadata to the storage device.
+     */
+    bool sync (error * perr = nullptr)
+    {
+        return FileProvider::sync(_h, false, perr);
+    }
+
+    /**
+     * Flush file data to the storage device, metadata is flushed only if it is needed to read
+     * the data (e.g. file size, but not modification time). Cheaper than `sync()`.
+     */
+    bool sync_data (error * perr = nullptr)
+    {
+        return FileProvider::sync(_h, true, perr);
+    }
+
+    /**
+     * Copy @a length bytes of the file started from @a offset to the current position of @a dst.
+     * Data is copied inside the kernel if possible, without passing through the user space.
+     *
+     * @return Copied size (less than @a length if end of file reached) and success flag.
+     */
+    write_result_type copy_to (file & dst, filesize_type offset, filesize_type length
+        , error * perr = nullptr) const
+    {
+        return FileProvider::copy(_h, offset, dst._h, length, perr);
+    }
+
+private:
+    /**
+     * Makes file object for just opened for writing handle @a h.
+     */
+    static file make_write_file (handle_type h, direct_io_enum direct, error * perr)
+    {
+        if (FileProvider::is_invalid(h))
+            return file{};
+
+        file_stat st;
+
+        if (!FileProvider::stat(h, st, perr)) {
+            FileProvider::close(h);
+            return file{};
+        }
+
+        return file {
+              h
+            , st
+            , direct == direct_io_enum::on ? FileProvider::direct_io_alignment(h) : 0
+        };
+    }
+
+    template <typename Buffer>
+    read_result_type read_all_into (Buffer & result, error * perr)
+    {
+        static constexpr std::size_t MIN_CHUNK_SIZE = 4096;
+        static constexpr std::size_t MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+        if (_alignment > 0) {
+            pfs::throw_or(perr, make_error_code(std::errc::operation_not_supported)
+                , tr::_("read all is not supported in direct I/O mode"));
+            result.clear();
+            return read_result_type{0, false};
+        }
+
+        // One extra byte to detect end of file without buffer reallocation.
+        auto expected_size = _stat.size > 0
+            ? pfs::numeric_cast<std::size_t>(_stat.size) + 1
+            : MIN_CHUNK_SIZE;
+
+        // Only the expected size is initialized (reused capacity can be much larger), the buffer
+        // grows geometrically if the read fills it.
+        result.resize(expected_size);
+        std::size_t total = 0;
+
+        for (;;) {
+            if (total == result.size())
+                result.resize(result.size() * 2);
+
+            auto block_size = (std::min)(result.size() - total, MAX_BLOCK_SIZE);
+            auto n = FileProvider::read(_h, & result[0] + total, block_size, perr);
+
+            if (!n.second) {
+                result.clear();
+                return read_result_type{0, false};
+            }
+
+            if (n.first == 0)
+                break;
+
+            total += pfs::numeric_cast<std::size_t>(n.first);
+        }
+
+        result.resize(total);
+        return read_result_type{total, true};
+    }
+
+    bool is_direct_aligned (void const * buffer, filesize_type len, filesize_type offset) const noexcept
+    {
+        return _alignment == 0
+            || (reinterpret_cast<std::uintptr_t>(buffer) % _alignment == 0
+                && len % _alignment == 0 && offset % _alignment == 0);
+    }
+
+    static io_result misaligned_result (io_op_enum op) noexcept
+    {
+        io_result result;
+        result.op = op;
+        result.ec = make_error_code(std::errc::invalid_argument);
+        return result;
+    }
+
+    bool check_direct (void const * buffer, filesize_type len, filesize_type offset
+        , error * perr) const
+    {
+        return _alignment == 0
+            || check_alignment(buffer, len, offset, _alignment, perr);
+    }
+
+    template <typename IoBuffer>
+    bool check_direct_v (IoBuffer const * bufs, std::size_t count, filesize_type offset
+        , error * perr) const
+    {
+        if (_alignment == 0)
+            return true;
+
+        for (std::size_t i = 0; i < count; i++) {
+            if (!check_alignment(bufs[i].data, bufs[i].size, offset, _alignment, perr))
+                return false;
+        }
+
+        return true;
+    }
+
 public: // static
    /**
     * @brief Open file for reading.
@@ -187,10 +634,7 @@ public: // static
     */
     static file open_read_only (filepath_type const & path, error * perr = nullptr)
     {
-        return file {
-              FileProvider::open_read_only(path, perr)
-            , FileProvider::size(path, perr)
-        };
+        return open_read_only(path, direct_io_enum::off, perr);
     }
 
     /**
@@ -206,10 +650,22 @@ public: // static
     static file open_write_only (filepath_type const & path, truncate_enum trunc
         , filesize_type initial_size = 0, error * perr = nullptr)
     {
-        return file {
-              FileProvider::open_write_only(path, trunc, initial_size, perr)
-            , trunc == truncate_enum::on ? 0 : FileProvider::size(path, perr)
-        };
+        return open_write_only(path, trunc, initial_size, preallocate_enum::off, perr);
+    }
+
+    /**
+    * @brief Open file for writing.
+    *
+    * @param prealloc Preallocation mode. If @c on then disk blocks for @a initial_size are
+    *        allocated instead of creating sparse file.
+    */
+    static file open_write_only (filepath_type const & path, truncate_enum trunc
+        , filesize_type initial_size, preallocate_enum prealloc, error * perr = nullptr)
+    {
+        auto h = FileProvider::open_write_only(path, trunc, initial_size, prealloc
+            , direct_io_enum::off, perr);
+
+        return make_write_file(h, direct_io_enum::off, perr);
     }
 
     static file open_write_only (filepath_type const & path, error * perr = nullptr)
@@ -217,6 +673,38 @@ public: // static
         return open_write_only(path, truncate_enum::off, 0, perr);
     }
 
+    /**
+     * Open file for reading in direct I/O mode if @a direct is @c on. Buffers, sizes and offsets
+     * passed to read methods must be aligned to `alignment()` (see `aligned_buffer`), the reading
+     * of the tail of the file returns less than requested.
+     */
+    static file open_read_only (filepath_type const & path, direct_io_enum direct
+        , error * perr = nullptr)
+    {
+        file_stat st;
+        auto h = FileProvider::open_read_only(path, direct, st, perr);
+
+        if (FileProvider::is_invalid(h))
+            return file{};
+
+        return file {
+              h
+            , st
+            , direct == direct_io_enum::on ? FileProvider::direct_io_alignment(h) : 0
+        };
+    }
+
+    /**
+     * Open file for writing in direct I/O mode if @a direct is @c on. Buffers, sizes and offsets
+     * passed to write methods must be aligned to `alignment()`.
+     */
+    static file open_write_only (filepath_type const & path, truncate_enum trunc
+        , filesize_type initial_size, direct_io_enum direct, error * perr = nullptr)
+    {
+        auto h = FileProvider::open_write_only(path, trunc, initial_size, direct, perr);
+        return make_write_file(h, direct, perr);
+    }
+
     /**
      * Rewrite file with content from @a buffer.
      */
@@ -250,6 +738,109 @@ public: // static
         rewrite(path, text.c_str(), static_cast<filesize_type>(text.size()));
     }
 
+    /**
+     * Rewrite file with content from @a buffer according to @a policy.
+     *
+     * @details For `rewrite_policy_enum::atomic` and `rewrite_policy_enum::durable` the content
+     *          is written into temporary file in the same directory which is renamed to @a path
+     *          on success, and removed on failure (target file remains untouched).
+     *          `rewrite_policy_enum::durable` additionally costs two synchronizations with the
+     *          storage device (file data and directory), that usually takes milliseconds versus
+     *          microseconds for other policies on devices without write-back cache (costs can
+     *          be measured by `rewrite` benchmark of `file_io_benchmark`).
+     */
+    static bool rewrite (filepath_type const & path, char const * buffer, filesize_type count
+        , rewrite_policy_enum policy, error * perr = nullptr)
+    {
+        if (policy == rewrite_policy_enum::in_place)
+            return rewrite(path, buffer, count, perr);
+
+        filepath_type temp_path;
+        auto h = FileProvider::open_temporary(path, temp_path, perr);
+
+        if (FileProvider::is_invalid(h))
+            return false;
+
+        file f {h, file_stat{}};
+        auto success = true;
+
+        while (success && count > 0) {
+            auto n = f.write(buffer, count, perr);
+            success = n.second;
+
+            if (success && n.first == 0) {
+                pfs::throw_or(perr, make_error_code(std::errc::io_error)
+                    , tr::_("write into file: no data written"));
+                success = false;
+            }
+
+            buffer += n.first;
+            count -= n.first;
+        }
+
+        if (success && policy == rewrite_policy_enum::durable)
+            success = f.sync_data(perr);
+
+        f.close();
+
+        if (success)
+            success = FileProvider::rename(temp_path, path, perr);
+
+        if (!success) {
+            error err;
+            FileProvider::remove(temp_path, & err);
+            return false;
+        }
+
+        if (policy == rewrite_policy_enum::durable)
+            return FileProvider::sync_directory(path, perr);
+
+        return true;
+    }
+
+    static bool rewrite (filepath_type const & path, std::string const & text
+        , rewrite_policy_enum policy, error * perr = nullptr)
+    {
+        return rewrite(path, text.c_str(), static_cast<filesize_type>(text.size()), policy, perr);
+    }
+
+    /**
+     * Copy content of the file @a src to the file @a dst (rewriting it). The content is cloned
+     * if file system supports it (reflink), or copied inside the kernel if possible.
+     */
+    static bool copy (filepath_type const & src, filepath_type const & dst, error * perr = nullptr)
+    {
+        auto in = open_read_only(src, perr);
+
+        if (!in)
+            return false;
+
+        auto out = open_write_only(dst, truncate_enum::on, 0, perr);
+
+        if (!out)
+            return false;
+
+        error err;
+
+        if (FileProvider::clone(in._h, out._h, & err))
+            return true;
+
+        auto res = in.copy_to(out, 0, in._stat.size, perr);
+        return res.second;
+    }
+
+    static read_result_type read_all (filepath_type const & path, std::string & result
+        , error * perr = nullptr)
+    {
+        auto f = file::open_read_only(path, perr);
+
+        if (f)
+            return f.read_all(result, perr);
+
+        result.clear();
+        return read_result_type{0, false};
+    }
+
     static std::string read_all (filepath_type const & path, error * perr)
     {
         auto f = file::open_read_only(path, perr);
@@ -5,18 +5,216 @@
 //
 // Changelog:
 //      2023.03.27 Initial version.
+//      2026.10.15 Added memory-mapped read-only view.
+//      2026.10.15 Added positional read/write.
+//      2026.10.15 Added scatter/gather (vectored) read/write.
+//      2026.10.15 Added direct I/O mode.
+//      2026.10.15 Added preallocation and punching holes.
+//      2026.10.15 Added kernel-side copy.
+//      2026.10.15 Added synchronization and primitives for atomic rewrite.
+//      2026.10.15 Added access pattern advice and readahead.
+//      2026.10.15 Added `file_stat` obtained from the open handle.
+//      2026.10.15 Added access to files relative to the opened directory.
+//      2026.10.15 Added `io_result` and non-throwing `try_*` I/O calls.
+//      2026.10.16 Added owner of the region to `mapped_view`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "pfs/ionik/error.hpp"
 #include "pfs/ionik/exports.hpp"
+#include <pfs/i18n.hpp>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
 #include <utility>
 
 namespace ionik {
 
 enum class truncate_enum: std::int8_t { off, on };
+
+/**
+ * Direct I/O mode: data is transferred between user buffers and the device bypassing the
+ * page cache (O_DIRECT on Linux, FILE_FLAG_NO_BUFFERING on Windows, F_NOCACHE on macOS).
+ * Buffer addresses, sizes and file offsets must be aligned (see `direct_io_alignment()`).
+ */
+enum class direct_io_enum: std::int8_t { off, on };
+
+/**
+ * Preallocation mode: disk blocks are allocated when file is resized instead of creating
+ * sparse file. Avoids fragmentation and allocation stalls on subsequent writes.
+ */
+enum class preallocate_enum: std::int8_t { off, on };
+
+/**
+ * File rewrite policy.
+ */
+enum class rewrite_policy_enum: std::int8_t
+{
+      in_place // Truncate and write the file in place (cheapest, readers can see partial
+               // content, crash leaves broken file).
+    , atomic   // Write temporary file in the same directory and rename it over the target.
+               // Readers see old or new content only, but the new content can be lost (or
+               // be empty on some file systems) on power failure.
+    , durable  // Same as atomic, but temporary file data and the directory are synchronized
+               // with the storage device (most expensive, survives power failure).
+};
+
+/**
+ * Expected access pattern hint.
+ */
+enum class advice_enum: std::int8_t { normal, sequential, random, willneed, dontneed };
 using filesize_t = std::uint64_t;
 
+/**
+ * File metadata.
+ */
+struct file_stat
+{
+    filesize_t size {0};
+    std::chrono::system_clock::time_point mtime; // Last modification time
+    std::uint64_t inode {0};      // File serial number (file index on Windows)
+    std::uint32_t block_size {0}; // Preferred block size for I/O
+};
+
+/**
+ * I/O operation reported by `io_result`.
+ */
+enum class io_op_enum: std::int8_t
+{
+      none
+    , read
+    , write
+    , read_at
+    , write_at
+    , offset
+    , set_pos
+};
+
+/**
+ * Result of the I/O operation reported without exceptions and memory allocations: transferred
+ * size (file position for `offset`) and system error code. Error message is formatted on
+ * demand only, so expected errors in hot loops (e.g. `EAGAIN` or `EINTR` on non-blocking
+ * descriptors) are cheap.
+ */
+struct io_result
+{
+    filesize_t size {0};
+    std::error_code ec;
+    io_op_enum op {io_op_enum::none};
+
+    explicit operator bool () const noexcept
+    {
+        return !ec;
+    }
+
+    bool would_block () const noexcept
+    {
+        return ec == std::errc::resource_unavailable_try_again
+            || ec == std::errc::operation_would_block;
+    }
+
+    bool interrupted () const noexcept
+    {
+        return ec == std::errc::interrupted;
+    }
+
+    /**
+     * Description of the operation.
+     */
+    std::string what () const
+    {
+        switch (op) {
+            case io_op_enum::read: return tr::_("read from file");
+            case io_op_enum::write: return tr::_("write into file");
+            case io_op_enum::read_at: return tr::_("read from file at offset");
+            case io_op_enum::write_at: return tr::_("write into file at offset");
+            case io_op_enum::offset: return tr::_("get file position");
+            case io_op_enum::set_pos: return tr::_("set file position");
+            default: break;
+        }
+
+        return tr::_("file I/O");
+    }
+
+    std::string message () const
+    {
+        return what() + ": " + ec.message();
+    }
+
+    /**
+     * Reports failure to @a perr or throws `error` if @a perr is @c null.
+     */
+    void report (error * perr) const
+    {
+        pfs::throw_or(perr, ec, what());
+    }
+};
+
+/**
+ * Checks @a buffer address, @a len and @a offset are multiple of @a alignment required for
+ * direct I/O.
+ */
+inline bool check_alignment (void const * buffer, filesize_t len, filesize_t offset
+    , std::size_t alignment, error * perr)
+{
+    if (reinterpret_cast<std::uintptr_t>(buffer) % alignment != 0
+            || len % alignment != 0 || offset % alignment != 0) {
+        pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
+            , tr::f_("buffer, size or offset is not aligned to {} bytes for direct I/O"
+                , alignment));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Buffer descriptor for scatter (vectored) read.
+ */
+struct io_buffer
+{
+    char * data;
+    std::size_t size;
+
+    io_buffer (char * d, std::size_t n) noexcept
+        : data(d), size(n)
+    {}
+};
+
+/**
+ * Buffer descriptor for gather (vectored) write.
+ */
+struct const_io_buffer
+{
+    char const * data;
+    std::size_t size;
+
+    const_io_buffer (char const * d, std::size_t n) noexcept
+        : data(d), size(n)
+    {}
+
+    const_io_buffer (io_buffer const & b) noexcept
+        : data(b.data), size(b.size)
+    {}
+};
+
+/**
+ * Make buffer descriptor for the trivially copyable @a value (see `read<T>()`/`write<T>()`).
+ */
+template <typename T>
+inline io_buffer make_io_buffer (T & value) noexcept
+{
+    return io_buffer{reinterpret_cast<char *>(& value), sizeof(T)};
+}
+
+template <typename T>
+inline const_io_buffer make_io_buffer (T const & value) noexcept
+{
+    return const_io_buffer{reinterpret_cast<char const *>(& value), sizeof(T)};
+}
+
 template <typename HandleType, typename FilePath>
 class file_provider
 {
@@ -28,14 +226,210 @@ public:
     using read_result_type = std::pair<filesize_type, bool>;
     using write_result_type = std::pair<filesize_type, bool>;
 
+    /**
+     * Read-only view of the file region mapped into memory. Region is unmapped on view destruction.
+     */
+    class mapped_view
+    {
+        friend class file_provider;
+
+        void * _base {nullptr};       // Start of the mapping (aligned to the page/allocation granularity)
+        std::size_t _base_size {0};   // Size of the mapping
+        char const * _data {nullptr}; // Start of the requested region
+        std::size_t _size {0};        // Size of the requested region
+        std::shared_ptr<void> _owner; // Source of the region if it is not mapped (e.g. memory file storage)
+
+    public:
+        mapped_view () = default;
+        mapped_view (mapped_view const &) = delete;
+        mapped_view & operator = (mapped_view const &) = delete;
+
+        mapped_view (mapped_view && other) noexcept
+        {
+            swap(other);
+        }
+
+        mapped_view & operator = (mapped_view && other) noexcept
+        {
+            if (this != & other) {
+                mapped_view tmp {std::move(other)};
+                swap(tmp);
+            }
+
+            return *this;
+        }
+
+        ~mapped_view ()
+        {
+            if (_base != nullptr)
+                file_provider::unmap(*this);
+        }
+
+        char const * data () const noexcept
+        {
+            return _data;
+        }
+
+        std::size_t size () const noexcept
+        {
+            return _size;
+        }
+
+        bool empty () const noexcept
+        {
+            return _size == 0;
+        }
+
+        char const * begin () const noexcept
+        {
+            return _data;
+        }
+
+        char const * end () const noexcept
+        {
+            return _data + _size;
+        }
+
+        char operator [] (std::size_t index) const noexcept
+        {
+            return _data[index];
+        }
+
+        void swap (mapped_view & other) noexcept
+        {
+            std::swap(_base, other._base);
+            std::swap(_base_size, other._base_size);
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            _owner.swap(other._owner);
+        }
+    };
+
 public:
     static IONIK__EXPORT handle_type invalid () noexcept;
     static IONIK__EXPORT bool is_invalid (handle_type const & h) noexcept;
     static IONIK__EXPORT filesize_type size (filepath_type const & path, error * perr);
     static IONIK__EXPORT handle_type open_read_only (filepath_type const & path, error * perr);
+    static IONIK__EXPORT handle_type open_read_only (filepath_type const & path, direct_io_enum direct
+        , error * perr);
+
+    /**
+     * Opens regular file for reading and obtains its metadata by single request for the opened
+     * handle (no extra path lookups).
+     */
+    static IONIK__EXPORT handle_type open_read_only (filepath_type const & path, direct_io_enum direct
+        , file_stat & st, error * perr);
+
+    /**
+     * Opens directory @a path to access its entries by relative paths (see `open_read_only_at()`
+     * and `stat_at()`). Handle is released by `close()`.
+     */
+    static IONIK__EXPORT handle_type open_directory (filepath_type const & path, error * perr);
+
+    /**
+     * Same as `open_read_only()`, but relative @a path is resolved starting from the directory
+     * @a dir opened by `open_directory()`, so only the remaining path components are looked up.
+     * Absolute @a path is opened as is.
+     */
+    static IONIK__EXPORT handle_type open_read_only_at (handle_type const & dir
+        , filepath_type const & path, file_stat & st, error * perr);
+
+    /**
+     * Obtains metadata of the entry @a path (symbolic links are followed) relative to the
+     * directory @a dir opened by `open_directory()` without opening it.
+     */
+    static IONIK__EXPORT bool stat_at (handle_type const & dir, filepath_type const & path
+        , file_stat & st, error * perr);
+
     static IONIK__EXPORT handle_type open_write_only (filepath_type const & path, truncate_enum trunc
         , filesize_type initial_size, error * perr);
+    static IONIK__EXPORT handle_type open_write_only (filepath_type const & path, truncate_enum trunc
+        , filesize_type initial_size, direct_io_enum direct, error * perr);
+
+    /**
+     * Opens file for writing. If @a trunc is @c on, file is resized to @a initial_size with
+     * disk blocks allocated if @a prealloc is @c on.
+     */
+    static IONIK__EXPORT handle_type open_write_only (filepath_type const & path, truncate_enum trunc
+        , filesize_type initial_size, preallocate_enum prealloc, direct_io_enum direct, error * perr);
+
+    /**
+     * Alignment required for buffer addresses, sizes and file offsets in direct I/O mode.
+     * Returns conservative value (4096) if it can not be obtained from the system.
+     */
+    static IONIK__EXPORT std::size_t direct_io_alignment (handle_type const & h) noexcept;
+
     static IONIK__EXPORT void close (handle_type & h);
+
+    /**
+     * Obtains metadata of the opened file.
+     */
+    static IONIK__EXPORT bool stat (handle_type const & h, file_stat & st, error * perr);
+
+    /**
+     * Flushes file data and metadata to the storage device (if @a data_only is @c true,
+     * metadata not needed to read the data, e.g. modification time, is not flushed).
+     */
+    static IONIK__EXPORT bool sync (handle_type & h, bool data_only, error * perr);
+
+    /**
+     * Flushes the directory containing @a path to the storage device, so that created or
+     * renamed entry @a path survives power failure. Does nothing on Windows.
+     */
+    static IONIK__EXPORT bool sync_directory (filepath_type const & path, error * perr);
+
+    /**
+     * Creates new unique file for writing in the same directory as @a path (with permissions
+     * of @a path if it exists).
+     *
+     * @param temp_path Path of the created file.
+     */
+    static IONIK__EXPORT handle_type open_temporary (filepath_type const & path
+        , filepath_type & temp_path, error * perr);
+
+    /**
+     * Renames @a from to @a to replacing existing file atomically.
+     */
+    static IONIK__EXPORT bool rename (filepath_type const & from, filepath_type const & to
+        , error * perr);
+
+    static IONIK__EXPORT bool remove (filepath_type const & path, error * perr);
+
+    /**
+     * Announces expected access pattern for the region [@a offset, @a offset + @a len) (zero
+     * @a len means up to the end of file). Advice is a hint only: it is ignored if the platform
+     * does not support it.
+     */
+    static IONIK__EXPORT bool advise (handle_type const & h, filesize_type offset
+        , filesize_type len, advice_enum advice, error * perr);
+
+    /**
+     * Initiates reading of the region [@a offset, @a offset + @a len) into the page cache
+     * without blocking until data is read.
+     */
+    static IONIK__EXPORT bool readahead (handle_type const & h, filesize_type offset
+        , filesize_type len, error * perr);
+
+    /**
+     * Sets file size to @a size allocating disk blocks if @a prealloc is @c on (otherwise file
+     * extended by sparse region).
+     */
+    static IONIK__EXPORT bool resize (handle_type & h, filesize_type size, preallocate_enum prealloc
+        , error * perr);
+
+    /**
+     * Allocates disk blocks for region [@a offset, @a offset + @a len) without changing file size.
+     * Does nothing if the platform or file system does not support allocation.
+     */
+    static IONIK__EXPORT bool reserve (handle_type & h, filesize_type offset, filesize_type len
+        , error * perr);
+
+    /**
+     * Deallocates disk blocks of region [@a offset, @a offset + @a len) without changing file
+     * size. Subsequent reads of the region return zeros.
+     */
+    static IONIK__EXPORT bool punch_hole (handle_type & h, filesize_type offset, filesize_type len
+        , error * perr);
     static IONIK__EXPORT offset_result_type offset (handle_type const & h, error * perr);
     static IONIK__EXPORT bool set_pos (handle_type & h, filesize_type offset, error * perr);
 
@@ -48,6 +442,104 @@ public:
      */
     static IONIK__EXPORT read_result_type read (handle_type & h, char * buffer, filesize_type len, error * perr);
     static IONIK__EXPORT write_result_type write (handle_type & h, char const * buffer, filesize_type len, error * perr);
+
+    /**
+     * Read data from file at specified @a offset into buffer. Can be called concurrently
+     * for the same handle.
+     *
+     * @return Same as for `read()`.
+     *
+     * @note File position is not changed on POSIX systems, but is undefined on Windows
+     *       after the call.
+     */
+    static IONIK__EXPORT read_result_type read_at (handle_type const & h, filesize_type offset
+        , char * buffer, filesize_type len, error * perr);
+
+    /**
+     * Write data from buffer into file at specified @a offset. Can be called concurrently
+     * for the same handle.
+     *
+     * @note File position is not changed on POSIX systems, but is undefined on Windows
+     *       after the call.
+     */
+    static IONIK__EXPORT write_result_type write_at (handle_type & h, filesize_type offset
+        , char const * buffer, filesize_type len, error * perr);
+
+    /**
+     * Non-throwing versions of `read()`, `write()`, `read_at()`, `write_at()`, `offset()` and
+     * `set_pos()` for hot paths: failure is reported by error code in the result, error message
+     * is neither formatted nor allocated. Interrupted (`EINTR`) calls are not restarted.
+     */
+    static IONIK__EXPORT io_result try_read (handle_type & h, char * buffer, filesize_type len);
+    static IONIK__EXPORT io_result try_write (handle_type & h, char const * buffer, filesize_type len);
+    static IONIK__EXPORT io_result try_read_at (handle_type const & h, filesize_type offset
+        , char * buffer, filesize_type len);
+    static IONIK__EXPORT io_result try_write_at (handle_type & h, filesize_type offset
+        , char const * buffer, filesize_type len);
+    static IONIK__EXPORT io_result try_offset (handle_type const & h);
+    static IONIK__EXPORT io_result try_set_pos (handle_type & h, filesize_type offset);
+
+    /**
+     * Read data from file into @a count buffers (scatter read) by single call if supported by
+     * the platform. Buffers are filled in order.
+     *
+     * @return Total read size and success flag (see `read()`). Total size may be less than sum
+     *         of buffer sizes (end of file reached or too many buffers specified).
+     */
+    static IONIK__EXPORT read_result_type read_v (handle_type & h, io_buffer const * bufs
+        , std::size_t count, error * perr);
+
+    /**
+     * Write data from @a count buffers into file (gather write) by single call if supported by
+     * the platform.
+     *
+     * @return Total written size and success flag. Total size may be less than sum of buffer
+     *         sizes (partial write).
+     */
+    static IONIK__EXPORT write_result_type write_v (handle_type & h, const_io_buffer const * bufs
+        , std::size_t count, error * perr);
+
+    /**
+     * Positional version of `read_v()` (see `read_at()`).
+     */
+    static IONIK__EXPORT read_result_type read_v_at (handle_type const & h, filesize_type offset
+        , io_buffer const * bufs, std::size_t count, error * perr);
+
+    /**
+     * Positional version of `write_v()` (see `write_at()`).
+     */
+    static IONIK__EXPORT write_result_type write_v_at (handle_type & h, filesize_type offset
+        , const_io_buffer const * bufs, std::size_t count, error * perr);
+
+    /**
+     * Copies @a len bytes of @a src started from @a offset to @a dst at its current position
+     * (position is advanced). Data is copied inside the kernel if possible (`copy_file_range()`,
+     * then `sendfile()`), and through the user space buffer otherwise.
+     *
+     * @return Copied size (less than @a len if end of @a src reached) and success flag.
+     */
+    static IONIK__EXPORT write_result_type copy (handle_type const & src, filesize_type offset
+        , handle_type & dst, filesize_type len, error * perr);
+
+    /**
+     * Makes @a dst content the copy-on-write clone of the whole @a src content (reflink).
+     * Supported by some file systems only (e.g. Btrfs, XFS).
+     *
+     * @return @c false and `std::errc::operation_not_supported` error if cloning is not supported
+     *         for these files.
+     */
+    static IONIK__EXPORT bool clone (handle_type const & src, handle_type & dst, error * perr);
+
+    /**
+     * Map file region [@a offset, @a offset + @a len) into memory for reading. Caller is
+     * responsible for the region to be within the file bounds.
+     *
+     * @return Mapped view, empty view if @a len is zero or on failure.
+     */
+    static IONIK__EXPORT mapped_view map_read_only (handle_type const & h, filesize_type offset
+        , filesize_type len, advice_enum advice, error * perr);
+
+    static IONIK__EXPORT void unmap (mapped_view & view) noexcept;
 };
 
 } // namespace ionik
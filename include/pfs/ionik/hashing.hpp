@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.16 Moved-from `xxh3_64` is usable.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include "file.hpp"
+#include <pfs/numeric_cast.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ionik {
+
+/**
+ * Updates CRC-32C (Castagnoli) checksum @a crc by @a len bytes of @a data. Pass zero as @a crc
+ * for the first chunk, so `crc32c_update(crc32c_update(0, a, n), b, m)` is a checksum of
+ * concatenated chunks.
+ *
+ * @details Hardware instructions are used if supported by the CPU (SSE 4.2 on x86, CRC32
+ *          extension on ARMv8), slicing-by-8 table otherwise.
+ */
+IONIK__EXPORT std::uint32_t crc32c_update (std::uint32_t crc, void const * data
+    , std::size_t len) noexcept;
+
+/**
+ * Checks CRC-32C is computed by hardware instructions.
+ */
+IONIK__EXPORT bool crc32c_hardware () noexcept;
+
+/**
+ * Incremental CRC-32C hasher.
+ */
+class crc32c
+{
+public:
+    using digest_type = std::uint32_t;
+
+private:
+    digest_type _crc {0};
+
+public:
+    void update (char const * data, std::size_t len) noexcept
+    {
+        _crc = crc32c_update(_crc, data, len);
+    }
+
+    digest_type digest () const noexcept
+    {
+        return _crc;
+    }
+
+    void reset () noexcept
+    {
+        _crc = 0;
+    }
+
+public: // static
+    static digest_type compute (char const * data, std::size_t len) noexcept
+    {
+        return crc32c_update(0, data, len);
+    }
+};
+
+#if IONIK__HAS_XXHASH
+/**
+ * Incremental 64-bit XXH3 hasher (non-cryptographic, much faster than CRC-32C without
+ * hardware support).
+ *
+ * @note Hasher moved from by construction has no state (null pointer): `update()` and
+ *       `reset()` do nothing and `digest()` returns digest of empty data. It can be assigned
+ *       a new hasher. Move assignment swaps the states.
+ */
+class xxh3_64
+{
+public:
+    using digest_type = std::uint64_t;
+
+private:
+    void * _state {nullptr}; // XXH3_state_t
+
+public:
+    /**
+     * @throws std::bad_alloc on allocation failure.
+     */
+    IONIK__EXPORT xxh3_64 ();
+    IONIK__EXPORT ~xxh3_64 ();
+
+    xxh3_64 (xxh3_64 const &) = delete;
+    xxh3_64 & operator = (xxh3_64 const &) = delete;
+
+    xxh3_64 (xxh3_64 && other) noexcept
+    {
+        std::swap(_state, other._state);
+    }
+
+    xxh3_64 & operator = (xxh3_64 && other) noexcept
+    {
+        std::swap(_state, other._state);
+        return *this;
+    }
+
+    IONIK__EXPORT void update (char const * data, std::size_t len) noexcept;
+    IONIK__EXPORT digest_type digest () const noexcept;
+    IONIK__EXPORT void reset () noexcept;
+
+public: // static
+    static IONIK__EXPORT digest_type compute (char const * data, std::size_t len) noexcept;
+};
+#endif
+
+/**
+ * Reader hashing data read from the file by @a Hasher (`crc32c`, `xxh3_64`), so integrity
+ * is checked in the same pass with processing of the data.
+ */
+template <typename Hasher, typename FileProvider>
+class hashing_reader
+{
+public:
+    using file_type = file<FileProvider>;
+    using filesize_type = typename file_type::filesize_type;
+    using read_result_type = typename file_type::read_result_type;
+    using digest_type = typename Hasher::digest_type;
+
+private:
+    file_type * _f {nullptr};
+    Hasher _hasher;
+
+public:
+    hashing_reader (file_type & f)
+        : _f(& f)
+    {}
+
+    hashing_reader (hashing_reader const &) = delete;
+    hashing_reader & operator = (hashing_reader const &) = delete;
+    hashing_reader (hashing_reader &&) = default;
+    hashing_reader & operator = (hashing_reader &&) = default;
+
+    /**
+     * Reads data chunk from the current position of the file and hashes it.
+     */
+    read_result_type read (char * buffer, filesize_type len, error * perr = nullptr)
+    {
+        auto res = _f->read(buffer, len, perr);
+
+        if (res.second && res.first > 0)
+            _hasher.update(buffer, pfs::numeric_cast<std::size_t>(res.first));
+
+        return res;
+    }
+
+    template <typename T>
+    read_result_type read (T & value, error * perr = nullptr)
+    {
+        return read(reinterpret_cast<char *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Reads and hashes the rest of the file by blocks of @a block_size (e.g. data not needed
+     * for processing, but covered by the digest).
+     *
+     * @return Number of read bytes and success flag.
+     */
+    read_result_type consume (std::size_t block_size = 64 * 1024, error * perr = nullptr)
+    {
+        std::vector<char> buffer((std::max)(block_size, std::size_t{1}));
+        filesize_type total = 0;
+
+        for (;;) {
+            auto res = read(buffer.data(), buffer.size(), perr);
+
+            if (!res.second)
+                return read_result_type{total, false};
+
+            if (res.first == 0)
+                break;
+
+            total += res.first;
+        }
+
+        return read_result_type{total, true};
+    }
+
+    Hasher & hasher () noexcept
+    {
+        return _hasher;
+    }
+
+    digest_type digest () const noexcept
+    {
+        return _hasher.digest();
+    }
+};
+
+/**
+ * Writer hashing data written to the file by @a Hasher (`crc32c`, `xxh3_64`).
+ */
+template <typename Hasher, typename FileProvider>
+class hashing_writer
+{
+public:
+    using file_type = file<FileProvider>;
+    using filesize_type = typename file_type::filesize_type;
+    using write_result_type = typename file_type::write_result_type;
+    using digest_type = typename Hasher::digest_type;
+
+private:
+    file_type * _f {nullptr};
+    Hasher _hasher;
+
+public:
+    hashing_writer (file_type & f)
+        : _f(& f)
+    {}
+
+    hashing_writer (hashing_writer const &) = delete;
+    hashing_writer & operator = (hashing_writer const &) = delete;
+    hashing_writer (hashing_writer &&) = default;
+    hashing_writer & operator = (hashing_writer &&) = default;
+
+    /**
+     * Writes data chunk at the current position of the file and hashes the written part.
+     */
+    write_result_type write (char const * buffer, filesize_type len, error * perr = nullptr)
+    {
+        auto res = _f->write(buffer, len, perr);
+
+        if (res.first > 0)
+            _hasher.update(buffer, pfs::numeric_cast<std::size_t>(res.first));
+
+        return res;
+    }
+
+    template <typename T>
+    write_result_type write (T const & value, error * perr = nullptr)
+    {
+        return write(reinterpret_cast<char const *>(& value), sizeof(T), perr);
+    }
+
+    Hasher & hasher () noexcept
+    {
+        return _hasher;
+    }
+
+    digest_type digest () const noexcept
+    {
+        return _hasher.digest();
+    }
+};
+
+} // namespace ionik
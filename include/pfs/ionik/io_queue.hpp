@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include "file_provider.hpp"
+#include "local_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+namespace ionik {
+
+struct io_queue_rep;
+
+struct io_completion
+{
+    std::uint64_t user_data;
+
+    // Transferred bytes on success or negated system error code on failure
+    std::int64_t result;
+
+    bool ok () const noexcept
+    {
+        return result >= 0;
+    }
+
+    std::error_code error_code () const noexcept
+    {
+        return result < 0
+            ? std::error_code(static_cast<int>(-result), std::system_category())
+            : std::error_code{};
+    }
+};
+
+/**
+ * Asynchronous positional I/O queue for local files.
+ *
+ * @details Requests are prepared by `prepare_*()` calls, passed to the kernel by `submit()` as
+ *          a batch and reaped by `poll()` or `wait()`. On Linux the queue is backed by io_uring
+ *          if it is supported by the running kernel, otherwise requests are executed by the pool
+ *          of threads using `file_provider::read_at()`/`write_at()`.
+ *
+ *          The queue is not thread-safe: single thread is expected to prepare, submit and reap
+ *          requests. Buffers must stay valid until the request is completed.
+ */
+class io_queue
+{
+public:
+    using handle_type = local_file_handle;
+
+    enum class backend_enum: std::int8_t { io_uring, thread_pool };
+
+private:
+    io_queue_rep * _rep {nullptr};
+
+public:
+    /**
+     * Constructs queue using the best backend available.
+     *
+     * @param queue_depth Maximum number of prepared but not submitted requests.
+     * @param thread_count Number of threads of the thread pool backend (0 - number of hardware
+     *        threads), ignored by io_uring backend.
+     */
+    IONIK__EXPORT io_queue (std::size_t queue_depth = 256, std::size_t thread_count = 0
+        , error * perr = nullptr);
+
+    /**
+     * Constructs queue using the specified @a backend.
+     */
+    IONIK__EXPORT io_queue (std::size_t queue_depth, backend_enum backend
+        , std::size_t thread_count = 0, error * perr = nullptr);
+
+    IONIK__EXPORT ~io_queue ();
+
+    io_queue (io_queue const &) = delete;
+    io_queue (io_queue &&) = delete;
+    io_queue & operator = (io_queue const &) = delete;
+    io_queue & operator = (io_queue &&) = delete;
+
+    operator bool () const noexcept
+    {
+        return _rep != nullptr;
+    }
+
+    IONIK__EXPORT backend_enum backend () const noexcept;
+
+    /**
+     * Prepares read request of @a len bytes at @a offset into @a buffer.
+     *
+     * @return @c false if queue is full (`submit()` must be called before) or not initialized.
+     */
+    IONIK__EXPORT bool prepare_read (handle_type h, filesize_t offset, char * buffer
+        , std::size_t len, std::uint64_t user_data);
+
+    IONIK__EXPORT bool prepare_write (handle_type h, filesize_t offset, char const * buffer
+        , std::size_t len, std::uint64_t user_data);
+
+    bool prepare_read (local_file const & f, filesize_t offset, char * buffer
+        , std::size_t len, std::uint64_t user_data)
+    {
+        return prepare_read(f.native(), offset, buffer, len, user_data);
+    }
+
+    bool prepare_write (local_file const & f, filesize_t offset, char const * buffer
+        , std::size_t len, std::uint64_t user_data)
+    {
+        return prepare_write(f.native(), offset, buffer, len, user_data);
+    }
+
+    /**
+     * Prepares read request for the registered file (by @a file_index, see `register_files()`)
+     * into the registered buffer (by @a buffer_index, see `register_buffers()`). @a buffer and
+     * @a len must specify range inside the registered buffer.
+     *
+     * @return @c false if queue is full or indices are out of range.
+     */
+    IONIK__EXPORT bool prepare_read_fixed (std::size_t file_index, filesize_t offset
+        , std::size_t buffer_index, char * buffer, std::size_t len, std::uint64_t user_data);
+
+    IONIK__EXPORT bool prepare_write_fixed (std::size_t file_index, filesize_t offset
+        , std::size_t buffer_index, char const * buffer, std::size_t len, std::uint64_t user_data);
+
+    /**
+     * Submits all prepared requests.
+     *
+     * @return Number of submitted requests.
+     */
+    IONIK__EXPORT std::size_t submit (error * perr = nullptr);
+
+    /**
+     * Reaps up to @a max_count completed requests without blocking.
+     *
+     * @return Number of completions stored in @a completions.
+     */
+    IONIK__EXPORT std::size_t poll (io_completion * completions, std::size_t max_count);
+
+    /**
+     * Reaps up to @a max_count completed requests, blocks until at least @a min_count requests
+     * completed (or there are no more requests in flight).
+     *
+     * @return Number of completions stored in @a completions.
+     */
+    IONIK__EXPORT std::size_t wait (io_completion * completions, std::size_t max_count
+        , std::size_t min_count = 1, error * perr = nullptr);
+
+    /**
+     * Registers buffers for `prepare_*_fixed()` requests. Replaces previously registered
+     * buffers. Must not be called while fixed requests are in flight.
+     */
+    IONIK__EXPORT bool register_buffers (io_buffer const * bufs, std::size_t count
+        , error * perr = nullptr);
+
+    /**
+     * Registers files for `prepare_*_fixed()` requests. Replaces previously registered
+     * files. Must not be called while fixed requests are in flight.
+     */
+    IONIK__EXPORT bool register_files (handle_type const * files, std::size_t count
+        , error * perr = nullptr);
+};
+
+} // namespace ionik
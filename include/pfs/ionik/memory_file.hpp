@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "file.hpp"
+#include "file_provider.hpp"
+#include "pfs/ionik/exports.hpp"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ionik {
+
+struct memory_file_context;
+
+/**
+ * In-process byte buffer used as a "path" for the memory file provider.
+ *
+ * @details Copies of the buffer share the same storage. Storage is either owned (and grows
+ *          on writing beyond its end) or external (fixed size region provided by the caller,
+ *          must outlive all buffers and opened files referring to it).
+ */
+class memory_buffer
+{
+    friend class file_provider<memory_file_context *, memory_buffer>;
+
+    struct storage
+    {
+        std::vector<char> owned;    // Used if storage is not external
+        char * data {nullptr};
+        filesize_t size {0};
+        filesize_t capacity {0};    // Capacity of external region
+        bool external {false};
+        bool read_only {false};
+        std::chrono::system_clock::time_point ctime {std::chrono::system_clock::now()};
+    };
+
+    std::shared_ptr<storage> _s;
+
+public:
+    /**
+     * Constructs empty owned growable buffer.
+     */
+    memory_buffer ()
+        : _s(std::make_shared<storage>())
+    {}
+
+    /**
+     * Constructs owned growable buffer initialized by @a data.
+     */
+    explicit memory_buffer (std::vector<char> data)
+        : _s(std::make_shared<storage>())
+    {
+        _s->owned = std::move(data);
+        _s->data = _s->owned.data();
+        _s->size = _s->owned.size();
+    }
+
+    char const * data () const noexcept
+    {
+        return _s->data;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return static_cast<std::size_t>(_s->size);
+    }
+
+    bool growable () const noexcept
+    {
+        return !_s->external;
+    }
+
+    bool read_only () const noexcept
+    {
+        return _s->read_only;
+    }
+
+public: // static
+    /**
+     * Makes fixed size buffer over external writable region.
+     */
+    static memory_buffer wrap (char * data, std::size_t size)
+    {
+        memory_buffer result;
+        result._s->data = data;
+        result._s->size = size;
+        result._s->capacity = size;
+        result._s->external = true;
+        return result;
+    }
+
+    /**
+     * Makes read-only buffer over external region (e.g. already loaded or mapped file content).
+     */
+    static memory_buffer wrap (char const * data, std::size_t size)
+    {
+        auto result = wrap(const_cast<char *>(data), size);
+        result._s->read_only = true;
+        return result;
+    }
+};
+
+/**
+ * Provider of files stored in the process memory. Operations do not involve system calls,
+ * so memory files can be used for parsing already loaded data, as fast storage for hot files
+ * and for deterministic testing and benchmarking.
+ *
+ * @note Concurrent positional reads of the same buffer are safe, writes must be synchronized
+ *       externally. Mapped views refer to the buffer data directly, so they reflect subsequent
+ *       writes and are invalidated by growing of the owned buffer (writing beyond its end or
+ *       resizing).
+ */
+using memory_file_handle = memory_file_context *;
+using memory_file_provider = file_provider<memory_file_handle, memory_buffer>;
+using memory_file = file<memory_file_provider>;
+
+} // namespace ionik
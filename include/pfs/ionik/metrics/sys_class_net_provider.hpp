@@ -5,9 +5,11 @@
 //
 // Changelog:
 //      2024.10.19 Initial version.
+//      2026.10.15 Statistics are read relative to the directory opened once.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "basic_net_statistics.hpp"
+#include <pfs/ionik/directory_handle.hpp>
 #include <pfs/ionik/error.hpp>
 #include <pfs/filesystem.hpp>
 #include <string>
@@ -20,10 +22,12 @@ class sys_class_net_provider: public basic_net_statistics
 private:
     std::string _iface;         // network interface name (subdirectory name in /sys/class/net)
     std::string _readable_name;
-    pfs::filesystem::path _rx_bytes_path;
-    pfs::filesystem::path _tx_bytes_path;
+    pfs::filesystem::path _statistics_path; // /sys/class/net/<iface>/statistics
+    directory_handle _statistics_dir;
+    std::string _buffer;              // Reusable buffer for counter file content
 
 private:
+    bool read_counters (std::int64_t & rx_bytes, std::int64_t & tx_bytes, error * perr);
     bool read (std::int64_t & rx_bytes, std::int64_t & tx_bytes, error * perr);
     bool read_all (error * perr);
 
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include "local_file.hpp"
+#include "pfs/filesystem.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ionik {
+
+/**
+ * Synchronization policy of the segmented log.
+ */
+enum class log_sync_enum: std::int8_t
+{
+      none    // Never synchronize with the storage device explicitly (fastest, data written
+              // since the last write-back of the page cache is lost on power failure).
+    , segment // Synchronize the segment when it is sealed (filled up) or closed.
+    , commit  // Synchronize on each commit. Concurrent commits are grouped: single
+              // synchronization makes durable the records of all threads waiting for it.
+};
+
+struct segmented_log_options
+{
+    std::size_t segment_size {64 * 1024 * 1024}; // Segments are preallocated to this size
+    std::size_t batch_size {64 * 1024};          // Appended records are committed automatically
+                                                 // when their size exceeds this threshold
+    log_sync_enum sync {log_sync_enum::commit};
+};
+
+/**
+ * Record of the segmented log.
+ */
+struct log_record
+{
+    std::uint64_t seq {0};       // Sequence number of the record (starts from zero)
+    char const * data {nullptr};
+    std::size_t size {0};
+};
+
+/**
+ * Append-only log of binary records stored in the directory as sequence of fixed-size segment
+ * files named by the sequence number of the first record (e.g. `00000000000000000000.log`).
+ *
+ * @details Each record is stored as header (32-bit little-endian payload size and CRC-32C of
+ *          the payload) followed by payload. Segments are preallocated, so end of data in the
+ *          active segment is marked by zero size. Sealed segments are truncated to the data size.
+ *          Record with checksum mismatch (torn by crash) is treated as end of data.
+ *
+ *          Appended records are accumulated in memory and written by single request on commit
+ *          (explicit or automatic when the batch size is exceeded), then synchronized according
+ *          to the sync policy. Log is thread-safe.
+ *
+ *          Opening of the existing log continues after the last record of the last segment.
+ */
+class segmented_log
+{
+public:
+    using filepath_type = pfs::filesystem::path;
+
+    static constexpr std::size_t RECORD_HEADER_SIZE = 2 * sizeof(std::uint32_t);
+
+private:
+    filepath_type _dir;
+    segmented_log_options _opts;
+    mutable std::mutex _mtx;
+    std::condition_variable _sync_cond;
+    local_file _segment;
+    std::uint64_t _segment_base {0}; // Sequence number of the first record in the segment
+    filesize_t _segment_used {0};    // Written bytes in the segment
+    std::vector<char> _batch;        // Appended but not written records
+    std::uint64_t _next_seq {0};     // Sequence number of the next appended record
+    std::uint64_t _written_seq {0};  // Records before this sequence number are written
+    std::uint64_t _synced_seq {0};   // Records before this sequence number are synchronized
+    bool _syncing {false};
+
+public:
+    /**
+     * Opens log in the directory @a dir (created if not exists).
+     */
+    IONIK__EXPORT segmented_log (filepath_type const & dir, segmented_log_options const & opts
+        = segmented_log_options{}, error * perr = nullptr);
+
+    /**
+     * Commits pending records (errors are ignored, call `commit()` explicitly to handle them).
+     */
+    IONIK__EXPORT ~segmented_log ();
+
+    segmented_log (segmented_log const &) = delete;
+    segmented_log (segmented_log &&) = delete;
+    segmented_log & operator = (segmented_log const &) = delete;
+    segmented_log & operator = (segmented_log &&) = delete;
+
+    operator bool () const noexcept
+    {
+        return static_cast<bool>(_segment);
+    }
+
+    /**
+     * Appends record. Empty record and record larger than segment are not allowed.
+     *
+     * @return Sequence number of the record and success flag (@c false also if automatic commit
+     *         failed, the record remains pending in this case).
+     */
+    IONIK__EXPORT std::pair<std::uint64_t, bool> append (char const * data, std::size_t len
+        , error * perr = nullptr);
+
+    /**
+     * Writes appended records and synchronizes them according to the sync policy.
+     */
+    IONIK__EXPORT bool commit (error * perr = nullptr);
+
+    /**
+     * Sequence number of the next appended record (number of records in the log).
+     */
+    IONIK__EXPORT std::uint64_t next_seq () const;
+
+    /**
+     * Number of records committed with synchronization (durable records).
+     */
+    IONIK__EXPORT std::uint64_t synced_seq () const;
+
+private:
+    bool open_segment (std::uint64_t base, error * perr);
+    bool roll (std::unique_lock<std::mutex> & locker, error * perr);
+    bool write_batch (error * perr);
+    bool sync_written (std::unique_lock<std::mutex> & locker, error * perr);
+};
+
+/**
+ * Reader iterating records of the segmented log. Segments are mapped into memory, so records
+ * are not copied: record data is valid until the reader moves to the next segment.
+ *
+ * @note Reader sees records written before the segment is mapped.
+ */
+class segmented_log_reader
+{
+public:
+    using filepath_type = pfs::filesystem::path;
+
+private:
+    std::vector<std::pair<std::uint64_t, filepath_type>> _segments; // Base sequence number and path
+    std::size_t _index {0};             // Index of the current segment
+    bool _mapped {false};               // Current segment is mapped
+    local_file::mapped_view_type _view;
+    std::size_t _offset {0};            // Offset of the next record in the view
+    std::uint64_t _seq {0};             // Sequence number of the next record
+
+public:
+    IONIK__EXPORT segmented_log_reader (filepath_type const & dir, error * perr = nullptr);
+
+    /**
+     * Positions reader to the record with sequence number @a seq.
+     */
+    IONIK__EXPORT bool seek (std::uint64_t seq, error * perr = nullptr);
+
+    /**
+     * Reads next record.
+     *
+     * @return @c false at the end of the log or on failure.
+     */
+    IONIK__EXPORT bool next (log_record & rec, error * perr = nullptr);
+
+    /**
+     * Calls @a f for each record starting from the current one.
+     *
+     * @return Number of visited records.
+     */
+    template <typename F>
+    std::uint64_t for_each (F && f, error * perr = nullptr)
+    {
+        log_record rec;
+        std::uint64_t count = 0;
+
+        for (; next(rec, perr); count++)
+            f(rec);
+
+        return count;
+    }
+
+private:
+    bool map_segment (std::size_t index, error * perr);
+};
+
+} // namespace ionik
@@ -0,0 +1,773 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/ionik/audio/sample_kernels.hpp"
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#   define IONIK__SAMPLE_KERNELS_X86 1
+#   include <immintrin.h>
+#   if _MSC_VER
+#       include <intrin.h>
+#       define IONIK__TARGET_AVX2
+#   else
+#       define IONIK__TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define IONIK__SAMPLE_KERNELS_NEON 1
+#   include <arm_neon.h>
+#endif
+
+namespace ionik {
+namespace audio {
+
+namespace {
+
+// Statistics of samples in raw units
+template <typename Sum, typename SumSquares, typename Value>
+struct raw_stats
+{
+    std::size_t count {0};
+    Sum sum {0};
+    SumSquares sum_squares {0};
+    Value min {(std::numeric_limits<Value>::max)()};
+    Value max {std::numeric_limits<Value>::lowest()};
+
+    void add (Value v) noexcept
+    {
+        count++;
+        sum += v;
+        sum_squares += static_cast<SumSquares>(v) * static_cast<SumSquares>(v);
+
+        if (v < min)
+            min = v;
+
+        if (v > max)
+            max = v;
+    }
+
+    void merge (raw_stats const & other) noexcept
+    {
+        count += other.count;
+        sum += other.sum;
+        sum_squares += other.sum_squares;
+        min = (std::min)(min, other.min);
+        max = (std::max)(max, other.max);
+    }
+
+    void emit (double scale, sample_stats & stats) const noexcept
+    {
+        if (count == 0)
+            return;
+
+        sample_stats s;
+        s.count = count;
+        s.sum = static_cast<double>(sum) * scale;
+        s.sum_squares = static_cast<double>(sum_squares) * scale * scale;
+        s.min = static_cast<float>(min * scale);
+        s.max = static_cast<float>(max * scale);
+        stats.merge(s);
+    }
+};
+
+// Integer samples are reduced exactly, so result does not depend on the kernel
+using int_stats = raw_stats<std::int64_t, std::uint64_t, int>;
+using float_stats = raw_stats<double, double, float>;
+
+constexpr double SCALE_16 = 1.0 / 32767;
+constexpr double SCALE_8 = 1.0 / 255;
+constexpr int MIN_16 = -32767;
+
+// Kernels reduce `n` interleaved samples into `acc[0]` (even samples) and `acc[1]`
+// (odd samples), i.e. into left and right channels for stereo data.
+using s16_kernel = void (*) (std::int16_t const *, std::size_t, int_stats *);
+using u8_kernel = void (*) (std::uint8_t const *, std::size_t, int_stats *);
+using f32_kernel = void (*) (float const *, std::size_t, float_stats *);
+
+// Number of vector iterations before 32-bit partial sums may overflow
+constexpr std::size_t MAX_BLOCK_ITERATIONS = 16384;
+
+void reduce_s16_scalar (std::int16_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    for (std::size_t i = 0; i < n; i++)
+        acc[i & 1].add((std::max)(static_cast<int>(p[i]), MIN_16));
+}
+
+void reduce_u8_scalar (std::uint8_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    for (std::size_t i = 0; i < n; i++)
+        acc[i & 1].add(static_cast<int>(p[i]) - 128);
+}
+
+void reduce_f32_scalar (float const * p, std::size_t n, float_stats * acc) noexcept
+{
+    for (std::size_t i = 0; i < n; i++)
+        acc[i & 1].add(p[i]);
+}
+
+#if IONIK__SAMPLE_KERNELS_X86
+////////////////////////////////////////////////////////////////////////////////
+// SSE2 (baseline for x86-64)
+////////////////////////////////////////////////////////////////////////////////
+struct sse2_s16_state
+{
+    __m128i min;
+    __m128i max;
+    __m128i sum_even;   // 4 x int32
+    __m128i sum_odd;    // 4 x int32
+    __m128i sq_even;    // 2 x uint64
+    __m128i sq_odd;     // 2 x uint64
+};
+
+inline void sse2_init (sse2_s16_state & st) noexcept
+{
+    st.min = _mm_set1_epi16(32767);
+    st.max = _mm_set1_epi16(-32768);
+    st.sq_even = st.sq_odd = _mm_setzero_si128();
+}
+
+// Accumulates 8 samples (4 even and 4 odd)
+inline void sse2_step (sse2_s16_state & st, __m128i v) noexcept
+{
+    auto const zero = _mm_setzero_si128();
+    auto const low_mask = _mm_set1_epi32(0xFFFF);
+
+    st.min = _mm_min_epi16(st.min, v);
+    st.max = _mm_max_epi16(st.max, v);
+
+    // Sign extended even and odd samples
+    st.sum_even = _mm_add_epi32(st.sum_even, _mm_srai_epi32(_mm_slli_epi32(v, 16), 16));
+    st.sum_odd = _mm_add_epi32(st.sum_odd, _mm_srai_epi32(v, 16));
+
+    // Each 32-bit product is in [0, 32767^2], so it is safe to widen with zeros
+    auto even = _mm_and_si128(v, low_mask);
+    auto odd = _mm_srli_epi32(v, 16);
+    auto sq_even = _mm_madd_epi16(even, even);
+    auto sq_odd = _mm_madd_epi16(odd, odd);
+
+    st.sq_even = _mm_add_epi64(st.sq_even, _mm_unpacklo_epi32(sq_even, zero));
+    st.sq_even = _mm_add_epi64(st.sq_even, _mm_unpackhi_epi32(sq_even, zero));
+    st.sq_odd = _mm_add_epi64(st.sq_odd, _mm_unpacklo_epi32(sq_odd, zero));
+    st.sq_odd = _mm_add_epi64(st.sq_odd, _mm_unpackhi_epi32(sq_odd, zero));
+}
+
+inline void sse2_flush_sums (sse2_s16_state & st, int_stats * acc) noexcept
+{
+    alignas(16) std::int32_t even[4];
+    alignas(16) std::int32_t odd[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(even), st.sum_even);
+    _mm_store_si128(reinterpret_cast<__m128i *>(odd), st.sum_odd);
+
+    for (int i = 0; i < 4; i++) {
+        acc[0].sum += even[i];
+        acc[1].sum += odd[i];
+    }
+
+    st.sum_even = st.sum_odd = _mm_setzero_si128();
+}
+
+inline void sse2_finish (sse2_s16_state & st, std::size_t n, int_stats * acc) noexcept
+{
+    alignas(16) std::int16_t min[8];
+    alignas(16) std::int16_t max[8];
+    alignas(16) std::uint64_t sq_even[2];
+    alignas(16) std::uint64_t sq_odd[2];
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(min), st.min);
+    _mm_store_si128(reinterpret_cast<__m128i *>(max), st.max);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sq_even), st.sq_even);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sq_odd), st.sq_odd);
+
+    for (int i = 0; i < 8; i++) {
+        acc[i & 1].min = (std::min)(acc[i & 1].min, static_cast<int>(min[i]));
+        acc[i & 1].max = (std::max)(acc[i & 1].max, static_cast<int>(max[i]));
+    }
+
+    acc[0].sum_squares += sq_even[0] + sq_even[1];
+    acc[1].sum_squares += sq_odd[0] + sq_odd[1];
+    acc[0].count += n / 2;
+    acc[1].count += n / 2;
+}
+
+void reduce_s16_sse2 (std::int16_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const floor = _mm_set1_epi16(MIN_16);
+    auto bulk = n & ~std::size_t{7};
+
+    if (bulk > 0) {
+        sse2_s16_state st;
+        sse2_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 8);
+            st.sum_even = st.sum_odd = _mm_setzero_si128();
+
+            for (; i < block_end; i += 8) {
+                auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i));
+                sse2_step(st, _mm_max_epi16(v, floor));
+            }
+
+            sse2_flush_sums(st, acc);
+        }
+
+        sse2_finish(st, bulk, acc);
+    }
+
+    reduce_s16_scalar(p + bulk, n - bulk, acc);
+}
+
+void reduce_u8_sse2 (std::uint8_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const zero = _mm_setzero_si128();
+    auto const bias = _mm_set1_epi16(128);
+    auto bulk = n & ~std::size_t{15};
+
+    if (bulk > 0) {
+        sse2_s16_state st;
+        sse2_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 16);
+            st.sum_even = st.sum_odd = _mm_setzero_si128();
+
+            for (; i < block_end; i += 16) {
+                auto v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i));
+                sse2_step(st, _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), bias));
+                sse2_step(st, _mm_sub_epi16(_mm_unpackhi_epi8(v, zero), bias));
+            }
+
+            sse2_flush_sums(st, acc);
+        }
+
+        sse2_finish(st, bulk, acc);
+    }
+
+    reduce_u8_scalar(p + bulk, n - bulk, acc);
+}
+
+void reduce_f32_sse2 (float const * p, std::size_t n, float_stats * acc) noexcept
+{
+    auto bulk = n & ~std::size_t{3};
+
+    if (bulk > 0) {
+        auto min = _mm_set1_ps((std::numeric_limits<float>::max)());
+        auto max = _mm_set1_ps(std::numeric_limits<float>::lowest());
+        auto sum = _mm_setzero_pd();    // even, odd
+        auto sq = _mm_setzero_pd();     // even, odd
+
+        for (std::size_t i = 0; i < bulk; i += 4) {
+            auto v = _mm_loadu_ps(p + i);
+            min = _mm_min_ps(min, v);
+            max = _mm_max_ps(max, v);
+
+            auto lo = _mm_cvtps_pd(v);
+            auto hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+            sum = _mm_add_pd(sum, _mm_add_pd(lo, hi));
+            sq = _mm_add_pd(sq, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+        }
+
+        alignas(16) float mins[4];
+        alignas(16) float maxs[4];
+        alignas(16) double sums[2];
+        alignas(16) double sqs[2];
+
+        _mm_store_ps(mins, min);
+        _mm_store_ps(maxs, max);
+        _mm_store_pd(sums, sum);
+        _mm_store_pd(sqs, sq);
+
+        for (int i = 0; i < 4; i++) {
+            acc[i & 1].min = (std::min)(acc[i & 1].min, mins[i]);
+            acc[i & 1].max = (std::max)(acc[i & 1].max, maxs[i]);
+        }
+
+        for (int i = 0; i < 2; i++) {
+            acc[i].sum += sums[i];
+            acc[i].sum_squares += sqs[i];
+            acc[i].count += bulk / 2;
+        }
+    }
+
+    reduce_f32_scalar(p + bulk, n - bulk, acc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2
+////////////////////////////////////////////////////////////////////////////////
+struct avx2_s16_state
+{
+    __m256i min;
+    __m256i max;
+    __m256i sum_even;
+    __m256i sum_odd;
+    __m256i sq_even;
+    __m256i sq_odd;
+};
+
+IONIK__TARGET_AVX2
+inline void avx2_init (avx2_s16_state & st) noexcept
+{
+    st.min = _mm256_set1_epi16(32767);
+    st.max = _mm256_set1_epi16(-32768);
+    st.sq_even = st.sq_odd = _mm256_setzero_si256();
+}
+
+// Accumulates 16 samples (8 even and 8 odd)
+IONIK__TARGET_AVX2
+inline void avx2_step (avx2_s16_state & st, __m256i v) noexcept
+{
+    auto const zero = _mm256_setzero_si256();
+    auto const low_mask = _mm256_set1_epi32(0xFFFF);
+
+    st.min = _mm256_min_epi16(st.min, v);
+    st.max = _mm256_max_epi16(st.max, v);
+
+    st.sum_even = _mm256_add_epi32(st.sum_even, _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16));
+    st.sum_odd = _mm256_add_epi32(st.sum_odd, _mm256_srai_epi32(v, 16));
+
+    auto even = _mm256_and_si256(v, low_mask);
+    auto odd = _mm256_srli_epi32(v, 16);
+    auto sq_even = _mm256_madd_epi16(even, even);
+    auto sq_odd = _mm256_madd_epi16(odd, odd);
+
+    st.sq_even = _mm256_add_epi64(st.sq_even, _mm256_unpacklo_epi32(sq_even, zero));
+    st.sq_even = _mm256_add_epi64(st.sq_even, _mm256_unpackhi_epi32(sq_even, zero));
+    st.sq_odd = _mm256_add_epi64(st.sq_odd, _mm256_unpacklo_epi32(sq_odd, zero));
+    st.sq_odd = _mm256_add_epi64(st.sq_odd, _mm256_unpackhi_epi32(sq_odd, zero));
+}
+
+IONIK__TARGET_AVX2
+inline void avx2_flush_sums (avx2_s16_state & st, int_stats * acc) noexcept
+{
+    alignas(32) std::int32_t even[8];
+    alignas(32) std::int32_t odd[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(even), st.sum_even);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(odd), st.sum_odd);
+
+    for (int i = 0; i < 8; i++) {
+        acc[0].sum += even[i];
+        acc[1].sum += odd[i];
+    }
+
+    st.sum_even = st.sum_odd = _mm256_setzero_si256();
+}
+
+IONIK__TARGET_AVX2
+inline void avx2_finish (avx2_s16_state & st, std::size_t n, int_stats * acc) noexcept
+{
+    alignas(32) std::int16_t min[16];
+    alignas(32) std::int16_t max[16];
+    alignas(32) std::uint64_t sq_even[4];
+    alignas(32) std::uint64_t sq_odd[4];
+
+    _mm256_store_si256(reinterpret_cast<__m256i *>(min), st.min);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(max), st.max);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sq_even), st.sq_even);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sq_odd), st.sq_odd);
+
+    for (int i = 0; i < 16; i++) {
+        acc[i & 1].min = (std::min)(acc[i & 1].min, static_cast<int>(min[i]));
+        acc[i & 1].max = (std::max)(acc[i & 1].max, static_cast<int>(max[i]));
+    }
+
+    for (int i = 0; i < 4; i++) {
+        acc[0].sum_squares += sq_even[i];
+        acc[1].sum_squares += sq_odd[i];
+    }
+
+    acc[0].count += n / 2;
+    acc[1].count += n / 2;
+}
+
+IONIK__TARGET_AVX2
+void reduce_s16_avx2 (std::int16_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const floor = _mm256_set1_epi16(MIN_16);
+    auto bulk = n & ~std::size_t{15};
+
+    if (bulk > 0) {
+        avx2_s16_state st;
+        avx2_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 16);
+            st.sum_even = st.sum_odd = _mm256_setzero_si256();
+
+            for (; i < block_end; i += 16) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + i));
+                avx2_step(st, _mm256_max_epi16(v, floor));
+            }
+
+            avx2_flush_sums(st, acc);
+        }
+
+        avx2_finish(st, bulk, acc);
+    }
+
+    reduce_s16_scalar(p + bulk, n - bulk, acc);
+}
+
+IONIK__TARGET_AVX2
+void reduce_u8_avx2 (std::uint8_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const bias = _mm256_set1_epi16(128);
+    auto bulk = n & ~std::size_t{31};
+
+    if (bulk > 0) {
+        avx2_s16_state st;
+        avx2_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 32);
+            st.sum_even = st.sum_odd = _mm256_setzero_si256();
+
+            for (; i < block_end; i += 32) {
+                auto lo = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i));
+                auto hi = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + i + 16));
+                avx2_step(st, _mm256_sub_epi16(_mm256_cvtepu8_epi16(lo), bias));
+                avx2_step(st, _mm256_sub_epi16(_mm256_cvtepu8_epi16(hi), bias));
+            }
+
+            avx2_flush_sums(st, acc);
+        }
+
+        avx2_finish(st, bulk, acc);
+    }
+
+    reduce_u8_scalar(p + bulk, n - bulk, acc);
+}
+
+IONIK__TARGET_AVX2
+void reduce_f32_avx2 (float const * p, std::size_t n, float_stats * acc) noexcept
+{
+    auto bulk = n & ~std::size_t{7};
+
+    if (bulk > 0) {
+        auto min = _mm256_set1_ps((std::numeric_limits<float>::max)());
+        auto max = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+        auto sum = _mm256_setzero_pd();    // even, odd, even, odd
+        auto sq = _mm256_setzero_pd();
+
+        for (std::size_t i = 0; i < bulk; i += 8) {
+            auto v = _mm256_loadu_ps(p + i);
+            min = _mm256_min_ps(min, v);
+            max = _mm256_max_ps(max, v);
+
+            auto lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+            auto hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+            sum = _mm256_add_pd(sum, _mm256_add_pd(lo, hi));
+            sq = _mm256_add_pd(sq, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+        }
+
+        alignas(32) float mins[8];
+        alignas(32) float maxs[8];
+        alignas(32) double sums[4];
+        alignas(32) double sqs[4];
+
+        _mm256_store_ps(mins, min);
+        _mm256_store_ps(maxs, max);
+        _mm256_store_pd(sums, sum);
+        _mm256_store_pd(sqs, sq);
+
+        for (int i = 0; i < 8; i++) {
+            acc[i & 1].min = (std::min)(acc[i & 1].min, mins[i]);
+            acc[i & 1].max = (std::max)(acc[i & 1].max, maxs[i]);
+        }
+
+        for (int i = 0; i < 4; i++) {
+            acc[i & 1].sum += sums[i];
+            acc[i & 1].sum_squares += sqs[i];
+        }
+
+        acc[0].count += bulk / 2;
+        acc[1].count += bulk / 2;
+    }
+
+    reduce_f32_scalar(p + bulk, n - bulk, acc);
+}
+
+bool avx2_supported () noexcept
+{
+#   if _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+
+    // OSXSAVE and AVX, then YMM state is enabled by OS
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#   else
+    return __builtin_cpu_supports("avx2");
+#   endif
+}
+#endif // IONIK__SAMPLE_KERNELS_X86
+
+#if IONIK__SAMPLE_KERNELS_NEON
+////////////////////////////////////////////////////////////////////////////////
+// NEON (mandatory for AArch64)
+////////////////////////////////////////////////////////////////////////////////
+struct neon_s16_state
+{
+    int16x8_t min[2];
+    int16x8_t max[2];
+    int32x4_t sum[2];
+    uint64x2_t sq[2];
+};
+
+inline void neon_init (neon_s16_state & st) noexcept
+{
+    for (int k = 0; k < 2; k++) {
+        st.min[k] = vdupq_n_s16(32767);
+        st.max[k] = vdupq_n_s16(-32768);
+        st.sq[k] = vdupq_n_u64(0);
+    }
+}
+
+// Accumulates 8 samples of channel `k`
+inline void neon_step (neon_s16_state & st, int k, int16x8_t v) noexcept
+{
+    st.min[k] = vminq_s16(st.min[k], v);
+    st.max[k] = vmaxq_s16(st.max[k], v);
+    st.sum[k] = vpadalq_s16(st.sum[k], v);
+
+    auto lo = vreinterpretq_u32_s32(vmull_s16(vget_low_s16(v), vget_low_s16(v)));
+    auto hi = vreinterpretq_u32_s32(vmull_high_s16(v, v));
+    st.sq[k] = vpadalq_u32(st.sq[k], lo);
+    st.sq[k] = vpadalq_u32(st.sq[k], hi);
+}
+
+inline void neon_flush_sums (neon_s16_state & st, int_stats * acc) noexcept
+{
+    for (int k = 0; k < 2; k++) {
+        acc[k].sum += vaddlvq_s32(st.sum[k]);
+        st.sum[k] = vdupq_n_s32(0);
+    }
+}
+
+inline void neon_finish (neon_s16_state & st, std::size_t n, int_stats * acc) noexcept
+{
+    for (int k = 0; k < 2; k++) {
+        acc[k].min = (std::min)(acc[k].min, static_cast<int>(vminvq_s16(st.min[k])));
+        acc[k].max = (std::max)(acc[k].max, static_cast<int>(vmaxvq_s16(st.max[k])));
+        acc[k].sum_squares += vaddvq_u64(st.sq[k]);
+        acc[k].count += n / 2;
+    }
+}
+
+void reduce_s16_neon (std::int16_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const floor = vdupq_n_s16(MIN_16);
+    auto bulk = n & ~std::size_t{15};
+
+    if (bulk > 0) {
+        neon_s16_state st;
+        neon_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 16);
+            st.sum[0] = st.sum[1] = vdupq_n_s32(0);
+
+            for (; i < block_end; i += 16) {
+                // De-interleaves even and odd samples
+                auto v = vld2q_s16(p + i);
+                neon_step(st, 0, vmaxq_s16(v.val[0], floor));
+                neon_step(st, 1, vmaxq_s16(v.val[1], floor));
+            }
+
+            neon_flush_sums(st, acc);
+        }
+
+        neon_finish(st, bulk, acc);
+    }
+
+    reduce_s16_scalar(p + bulk, n - bulk, acc);
+}
+
+void reduce_u8_neon (std::uint8_t const * p, std::size_t n, int_stats * acc) noexcept
+{
+    auto const bias = vdup_n_u8(128);
+    auto bulk = n & ~std::size_t{15};
+
+    if (bulk > 0) {
+        neon_s16_state st;
+        neon_init(st);
+
+        for (std::size_t i = 0; i < bulk;) {
+            auto block_end = i + (std::min)(bulk - i, MAX_BLOCK_ITERATIONS * 16);
+            st.sum[0] = st.sum[1] = vdupq_n_s32(0);
+
+            for (; i < block_end; i += 16) {
+                // Widening subtraction wraps modulo 2^16, i.e. gives signed difference
+                auto v = vld2_u8(p + i);
+                neon_step(st, 0, vreinterpretq_s16_u16(vsubl_u8(v.val[0], bias)));
+                neon_step(st, 1, vreinterpretq_s16_u16(vsubl_u8(v.val[1], bias)));
+            }
+
+            neon_flush_sums(st, acc);
+        }
+
+        neon_finish(st, bulk, acc);
+    }
+
+    reduce_u8_scalar(p + bulk, n - bulk, acc);
+}
+
+void reduce_f32_neon (float const * p, std::size_t n, float_stats * acc) noexcept
+{
+    auto bulk = n & ~std::size_t{7};
+
+    if (bulk > 0) {
+        float32x4_t min[2];
+        float32x4_t max[2];
+        float64x2_t sum[2];
+        float64x2_t sq[2];
+
+        for (int k = 0; k < 2; k++) {
+            min[k] = vdupq_n_f32((std::numeric_limits<float>::max)());
+            max[k] = vdupq_n_f32(std::numeric_limits<float>::lowest());
+            sum[k] = sq[k] = vdupq_n_f64(0);
+        }
+
+        for (std::size_t i = 0; i < bulk; i += 8) {
+            auto v = vld2q_f32(p + i);
+
+            for (int k = 0; k < 2; k++) {
+                min[k] = vminq_f32(min[k], v.val[k]);
+                max[k] = vmaxq_f32(max[k], v.val[k]);
+
+                auto lo = vcvt_f64_f32(vget_low_f32(v.val[k]));
+                auto hi = vcvt_high_f64_f32(v.val[k]);
+                sum[k] = vaddq_f64(sum[k], vaddq_f64(lo, hi));
+                sq[k] = vfmaq_f64(sq[k], lo, lo);
+                sq[k] = vfmaq_f64(sq[k], hi, hi);
+            }
+        }
+
+        for (int k = 0; k < 2; k++) {
+            acc[k].min = (std::min)(acc[k].min, vminvq_f32(min[k]));
+            acc[k].max = (std::max)(acc[k].max, vmaxvq_f32(max[k]));
+            acc[k].sum += vaddvq_f64(sum[k]);
+            acc[k].sum_squares += vaddvq_f64(sq[k]);
+            acc[k].count += bulk / 2;
+        }
+    }
+
+    reduce_f32_scalar(p + bulk, n - bulk, acc);
+}
+#endif // IONIK__SAMPLE_KERNELS_NEON
+
+struct kernels
+{
+    simd_enum simd {simd_enum::scalar};
+    s16_kernel s16 {reduce_s16_scalar};
+    u8_kernel u8 {reduce_u8_scalar};
+    f32_kernel f32 {reduce_f32_scalar};
+};
+
+kernels select_kernels () noexcept
+{
+    kernels k;
+
+#if IONIK__SAMPLE_KERNELS_X86
+    if (avx2_supported()) {
+        k.simd = simd_enum::avx2;
+        k.s16 = reduce_s16_avx2;
+        k.u8 = reduce_u8_avx2;
+        k.f32 = reduce_f32_avx2;
+    } else {
+        k.simd = simd_enum::sse2;
+        k.s16 = reduce_s16_sse2;
+        k.u8 = reduce_u8_sse2;
+        k.f32 = reduce_f32_sse2;
+    }
+#elif IONIK__SAMPLE_KERNELS_NEON
+    k.simd = simd_enum::neon;
+    k.s16 = reduce_s16_neon;
+    k.u8 = reduce_u8_neon;
+    k.f32 = reduce_f32_neon;
+#endif
+
+    return k;
+}
+
+kernels const & active_kernels () noexcept
+{
+    static kernels const k = select_kernels();
+    return k;
+}
+
+template <typename Stats, typename T, typename Kernel, typename Convert>
+void reduce (T const * samples, std::size_t frame_count, std::size_t channels
+    , std::size_t frame_step, sample_stats * stats, Kernel kernel, Convert convert, double scale) noexcept
+{
+    if (frame_count == 0 || channels == 0)
+        return;
+
+    if (frame_step == 0)
+        frame_step = 1;
+
+    if (frame_step == 1 && channels <= 2) {
+        Stats acc[2];
+        kernel(samples, frame_count * channels, acc);
+
+        if (channels == 1) {
+            acc[0].merge(acc[1]);
+            acc[0].emit(scale, stats[0]);
+        } else {
+            acc[0].emit(scale, stats[0]);
+            acc[1].emit(scale, stats[1]);
+        }
+
+        return;
+    }
+
+    for (std::size_t c = 0; c < channels; c++) {
+        Stats acc;
+
+        for (std::size_t f = 0; f < frame_count; f += frame_step)
+            acc.add(convert(samples[f * channels + c]));
+
+        acc.emit(scale, stats[c]);
+    }
+}
+
+} // namespace
+
+simd_enum sample_kernels_simd () noexcept
+{
+    return active_kernels().simd;
+}
+
+void reduce_samples (std::int16_t const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept
+{
+    reduce<int_stats>(samples, frame_count, channels, frame_step, stats, active_kernels().s16
+        , [] (std::int16_t v) { return (std::max)(static_cast<int>(v), MIN_16); }, SCALE_16);
+}
+
+void reduce_samples (std::uint8_t const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept
+{
+    reduce<int_stats>(samples, frame_count, channels, frame_step, stats, active_kernels().u8
+        , [] (std::uint8_t v) { return static_cast<int>(v) - 128; }, SCALE_8);
+}
+
+void reduce_samples (float const * samples, std::size_t frame_count
+    , std::size_t channels, std::size_t frame_step, sample_stats * stats) noexcept
+{
+    reduce<float_stats>(samples, frame_count, channels, frame_step, stats, active_kernels().f32
+        , [] (float v) { return v; }, 1.0);
+}
+
+}} // namespace ionik::audio
@@ -5,6 +5,15 @@
 //
 // Changelog:
 //      2023.10.10 Initial version.
+//      2026.10.15 WAV header is parsed through buffered reader.
+//      2026.10.15 Sequential access to samples data is advised while decoding.
+//      2026.10.15 `wav_explorer` is generalized by file provider (`basic_wav_explorer`).
+//      2026.10.15 Added `compressed_wav_explorer`.
+//      2026.10.15 Decoding buffer is borrowed from `buffer_pool`.
+//      2026.10.15 Spectrum is built by vectorized sample kernels.
+//      2026.10.15 Added multi-threaded spectrum building.
+//      2026.10.15 Added envelope mode of `wav_spectrum_builder`.
+//      2026.10.15 Added decoding from memory mapped data.
 //
 // Sources:
 //      1. https://ru.stackoverflow.com/questions/878097/Как-нарисовать-графическое-представление-wav-файла
@@ -17,13 +26,22 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 #include "ionik/audio/wav_explorer.hpp"
+#include "ionik/audio/sample_kernels.hpp"
 #include <pfs/binary_istream.hpp>
 #include <pfs/endian.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/numeric_cast.hpp>
 #include <pfs/string_view.hpp>
+#include <pfs/ionik/buffered_file.hpp>
 #include <pfs/ionik/local_file.hpp>
+#include <pfs/ionik/memory_file.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace ionik {
 namespace audio {
@@ -60,40 +78,59 @@ struct wav_header
 //   1- 8 bits |   std::uint8_t  |           255  |               0
 //   9-16 bits |   std::int16_t  | 32767 (0x7FFF) | -32768 (-0x8000)
 
-static constexpr const local_file::filesize_type WAV_HEADER_SIZE
+static constexpr const filesize_t WAV_HEADER_SIZE
     = 7 * sizeof(std::uint32_t) + 4 * sizeof(std::uint16_t);
 
 // "fmt " chunk common size (really can be greater)
-static constexpr const local_file::filesize_type WAV_SUBCHUNK1_SIZE
+static constexpr const filesize_t WAV_SUBCHUNK1_SIZE
     = 2 * sizeof(std::uint32_t) + 4 * sizeof(std::uint16_t);
 
-wav_explorer::wav_explorer (local_file && wav_file)
-    : _wav_file(std::move(wav_file))
-{}
+// Mapping of compressed file decompresses the whole region into the heap, so reading by
+// blocks is preferred
+template <typename FileProvider>
+struct zero_copy_mapping: std::true_type {};
 
-wav_explorer::wav_explorer (pfs::filesystem::path const & path, error * perr)
-{
-    if (!pfs::filesystem::exists(path)) {
-        pfs::throw_or(perr
-            , std::make_error_code(std::errc::no_such_file_or_directory)
-            , pfs::utf8_encode_path(path));
+// Positional reads of compressed file are serialized and decompress the stream from the
+// nearest seek point, so concurrent reading of chunks is slower than sequential decoding
+template <typename FileProvider>
+struct concurrent_positional_reads: std::true_type {};
 
-        return;
-    }
+#if IONIK__HAS_ZSTD
+template <>
+struct zero_copy_mapping<compressed_file_provider>: std::false_type {};
 
-    _wav_file = local_file::open_read_only(path, perr);
+template <>
+struct concurrent_positional_reads<compressed_file_provider>: std::false_type {};
+#endif
 
-    if (!_wav_file)
-        return;
+template <typename FileProvider>
+basic_wav_explorer<FileProvider>::basic_wav_explorer (file_type && wav_file)
+    : _wav_file(std::move(wav_file))
+{}
+
+template <typename FileProvider>
+basic_wav_explorer<FileProvider>::basic_wav_explorer (filepath_type const & path, error * perr)
+{
+    _wav_file = file_type::open_read_only(path, perr);
 }
 
-pfs::optional<wav_info> wav_explorer::read_header (error * perr)
+template <typename FileProvider>
+pfs::optional<wav_info> basic_wav_explorer<FileProvider>::read_header (error * perr)
 {
     wav_info info;
     char buffer[WAV_HEADER_SIZE];
 
     error err;
-    auto res = _wav_file.read(buffer, WAV_HEADER_SIZE, & err);
+
+    // Header with extra chunks usually fits into one block, so it is read by single call
+    buffered_reader<FileProvider> reader {_wav_file, 4096, & err};
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return pfs::nullopt;
+    }
+
+    auto res = reader.read(buffer, WAV_HEADER_SIZE, & err);
 
     if (!res.second) {
         pfs::throw_or(perr, std::move(err));
@@ -176,7 +213,7 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
 
     // Skip data if common "fmt " subchunk is less than count specified in subchunk1_size
     if (header.subchunk1_size > WAV_SUBCHUNK1_SIZE) {
-        if (!_wav_file.skip(header.subchunk1_size - WAV_SUBCHUNK1_SIZE, & err)) {
+        if (!reader.skip(header.subchunk1_size - WAV_SUBCHUNK1_SIZE, & err)) {
             pfs::throw_or(perr, std::move(err));
             return pfs::nullopt;
         }
@@ -190,7 +227,7 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
         auto chunk_header_size = 2 * sizeof(std::uint32_t);
 
         // `buffer` already not need here, it can be reused.
-        res = _wav_file.read(buffer, chunk_header_size, & err);
+        res = reader.read(buffer, chunk_header_size, & err);
 
         if (!res.second) {
             pfs::throw_or(perr, std::move(err));
@@ -213,14 +250,9 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
         if (subchunk2_id == 0x64617461)
             break;
 
-        auto off_res = _wav_file.offset(& err);
+        auto chunk_offset = reader.offset();
 
-        if (!off_res.second) {
-            pfs::throw_or(perr, std::move(err));
-            return pfs::nullopt;
-        }
-
-        if (!_wav_file.skip(subchunk2_size, & err)) {
+        if (!reader.skip(subchunk2_size, & err)) {
             pfs::throw_or(perr, std::move(err));
             return pfs::nullopt;
         }
@@ -228,7 +260,7 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
         info.extra.emplace_back(wav_chunk_info {
               subchunk2_id
             , subchunk2_size
-            , pfs::numeric_cast<std::uint32_t>(off_res.first)
+            , pfs::numeric_cast<std::uint32_t>(chunk_offset)
         });
     } while(true);
 
@@ -239,18 +271,16 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
         return pfs::nullopt;
     }
 
-    // "data" subchunk
+    // "data" subchunk, file offset is set to the begining of samples data
     {
-        auto off_res = _wav_file.offset(& err);
-
-        if (!off_res.second) {
+        if (!reader.sync_pos(& err)) {
             pfs::throw_or(perr, std::move(err));
             return pfs::nullopt;
         }
 
         info.data.id = subchunk2_id;
         info.data.size = subchunk2_size;
-        info.data.start_offset = pfs::numeric_cast<std::uint32_t>(off_res.first);
+        info.data.start_offset = pfs::numeric_cast<std::uint32_t>(reader.offset());
     }
 
     info.byte_rate    = header.byte_rate;
@@ -264,7 +294,8 @@ pfs::optional<wav_info> wav_explorer::read_header (error * perr)
     return info;
 }
 
-bool wav_explorer::decode (std::size_t frames_chunk_size)
+template <typename FileProvider>
+bool basic_wav_explorer<FileProvider>::decode (std::size_t frames_chunk_size)
 {
     error err;
     auto hdr = read_header(& err);
@@ -288,7 +319,6 @@ bool wav_explorer::decode (std::size_t frames_chunk_size)
     if (!on_wav_info(*hdr, & frames_chunk_size))
         return false;
 
-    std::vector<char> raw_buffer;
     std::size_t raw_buffer_size = frames_chunk_size * hdr->num_channels;
     std::size_t remain_size = hdr->data.size;
 
@@ -299,7 +329,49 @@ bool wav_explorer::decode (std::size_t frames_chunk_size)
     else if (hdr->sample_size <= 32)
         raw_buffer_size *= 4;
 
-    raw_buffer.resize(raw_buffer_size);
+    if (_mapping == mapping_enum::on && zero_copy_mapping<FileProvider>::value
+            && raw_buffer_size > 0) {
+        // Data size is clipped by the file size as while reading
+        auto file_size = _wav_file.size();
+        auto start_offset = (std::min)(filesize_t{hdr->data.start_offset}, file_size);
+        auto data_size = (std::min)(filesize_t{hdr->data.size}, file_size - start_offset);
+
+        error map_err;
+        auto view = data_size > 0
+            ? _wav_file.map_read_only(start_offset, data_size, advice_enum::sequential, & map_err)
+            : typename file_type::mapped_view_type{};
+
+        // Decoded by blocks of the same size as while reading, fall back to reading if mapping
+        // failed
+        if (view.size() > 0) {
+            auto p = view.data();
+            auto remain = view.size();
+
+            while (remain > 0) {
+                auto n = (std::min)(remain, raw_buffer_size);
+
+                // Interrupted
+                if (!on_raw_data(p, n))
+                    return false;
+
+                p += n;
+                remain -= n;
+            }
+
+            return true;
+        }
+    }
+
+    // Buffer is reused between decodings (e.g. periodic decoding in long-lived process)
+    auto raw_buffer = _buffer_pool->acquire(raw_buffer_size);
+
+    // Samples data is read sequentially once, so larger readahead is useful. The advice is a
+    // hint only, so ignore the failure.
+    {
+        error advice_err;
+        _wav_file.advise(advice_enum::sequential, hdr->data.start_offset, hdr->data.size
+            , & advice_err);
+    }
 
     // File offset in the begining of samples data now.
 
@@ -331,71 +403,284 @@ bool wav_explorer::decode (std::size_t frames_chunk_size)
     return true;
 }
 
-pfs::optional<wav_spectrum>
-wav_spectrum_builder::operator () (std::size_t chunk_count, std::size_t frame_step, error * perr)
+template <typename FileProvider>
+bool basic_wav_explorer<FileProvider>::concurrent_reads () const noexcept
 {
-    if (chunk_count == 0) {
-        pfs::throw_or(perr, tr::_("chunk count must be greater than 0"));
-        return pfs::nullopt;
+    return concurrent_positional_reads<FileProvider>::value;
+}
+
+template class basic_wav_explorer<local_file_provider>;
+template class basic_wav_explorer<memory_file_provider>;
+
+#if IONIK__HAS_ZSTD
+template class basic_wav_explorer<compressed_file_provider>;
+#endif
+
+bool wav_spectrum_builder::prepare (builder_context & ctx, wav_info const & info
+    , std::size_t chunk_count, std::size_t * frames_chunk_size)
+{
+    ctx.spectrum.max_frame = std::make_pair(-1.0f, -1.0f);
+    ctx.spectrum.min_frame = std::make_pair( 1.0f,  1.0f);
+    ctx.spectrum.info = info;
+
+    if (ctx.spectrum.info.sample_size > 16) {
+        ctx.err = error {tr::_("sample size greater than 16")};
+        return false;
     }
 
-    builder_context ctx;
-    ctx.frame_step = frame_step;
+    if (is_mono8(ctx.spectrum.info)) {
+        _build_proc = & wav_spectrum_builder::build_from_mono8;
+    } else if (is_stereo8(ctx.spectrum.info)) {
+        _build_proc = & wav_spectrum_builder::build_from_stereo8;
+    } else if (is_mono16(ctx.spectrum.info)) {
+        _build_proc = & wav_spectrum_builder::build_from_mono16;
+    } else if (is_stereo16(ctx.spectrum.info)) {
+        _build_proc = & wav_spectrum_builder::build_from_stereo16;
+    } else {
+        ctx.err = error {tr::f_("8/16 bits and mono/stereo only")};
+        return false;
+    }
+
+    *frames_chunk_size = ctx.spectrum.info.frame_count / chunk_count;
+    auto tail_size = ctx.spectrum.info.frame_count % chunk_count;
+
+    if (tail_size != 0) {
+        *frames_chunk_size = (ctx.spectrum.info.frame_count - tail_size)
+            / (chunk_count - 1);
+    }
+
+    // Adjust frame_step
+    if (ctx.frame_step == (std::numeric_limits<decltype(ctx.frame_step)>::max)()) {
+        if (*frames_chunk_size < 1000)
+            ctx.frame_step = 1;
+        else if (*frames_chunk_size < 10000)
+            ctx.frame_step = 10;
+        else if (*frames_chunk_size < 100000)
+            ctx.frame_step = 100;
+        else
+            ctx.frame_step = 500;
+    }
 
+    if (ctx.envelope) {
+        ctx.frame_step = 1;
+        ctx.spectrum.envelope.channels.resize(static_cast<std::size_t>(info.num_channels));
+
+        for (auto & ch: ctx.spectrum.envelope.channels) {
+            ch.min.reserve(chunk_count);
+            ch.max.reserve(chunk_count);
+            ch.rms.reserve(chunk_count);
+        }
+    }
+
+    return true;
+}
+
+bool wav_spectrum_builder::build_sequential (builder_context & ctx, std::size_t chunk_count)
+{
     _explorer->on_error = [& ctx] (error const & e) { ctx.err = e; };
 
     _explorer->on_wav_info = [this, & ctx, chunk_count] (ionik::audio::wav_info const & info
             , std::size_t * frames_chunk_size) {
-        ctx.spectrum.max_frame = std::make_pair(-1.0f, -1.0f);
-        ctx.spectrum.min_frame = std::make_pair( 1.0f,  1.0f);
-        ctx.spectrum.info = info;
+        return prepare(ctx, info, chunk_count, frames_chunk_size);
+    };
 
-        if (ctx.spectrum.info.sample_size > 16) {
-            ctx.err = error {tr::_("sample size greater than 16")};
-            return false;
+    _explorer->on_raw_data = [this, & ctx] (char const * raw_samples, std::size_t size) {
+        return (this->*_build_proc)(ctx, raw_samples, size);
+    };
+
+    return _explorer->decode();
+}
+
+bool wav_spectrum_builder::build_parallel (builder_context & ctx, std::size_t chunk_count
+    , std::size_t thread_count)
+{
+    auto hdr = _explorer->read_header(& ctx.err);
+
+    if (!hdr)
+        return false;
+
+    // Same checks as while decoding
+    if (hdr->audio_format != 1) { // PCM
+        ctx.err = error {tr::_("only PCM format supported for decoding")};
+        return false;
+    }
+
+    std::size_t frames_chunk_size = 0;
+
+    if (!prepare(ctx, *hdr, chunk_count, & frames_chunk_size))
+        return false;
+
+    std::size_t frame_size = hdr->num_channels * (hdr->sample_size <= 8 ? 1 : 2);
+    std::size_t raw_chunk_size = frames_chunk_size * frame_size;
+    std::size_t data_size = hdr->data.size;
+
+    if (raw_chunk_size == 0 || data_size == 0)
+        return true;
+
+    struct chunk_result
+    {
+        std::size_t size {0};
+        wav_spectrum::unified_frame frame;
+        float min[2];
+        float max[2];
+        float rms[2];
+    };
+
+    auto channels = ctx.spectrum.envelope.channels.size();
+
+    // Chunks are claimed by workers one by one and results are merged in order. Each worker
+    // has its own context to track minimum and maximum.
+    std::vector<chunk_result> results((data_size + raw_chunk_size - 1) / raw_chunk_size);
+    thread_count = (std::min)(thread_count, results.size());
+    std::vector<builder_context> contexts(thread_count);
+    std::atomic<std::size_t> next_chunk {0};
+    std::atomic<bool> failed {false};
+
+    auto worker = [&] (builder_context & local) {
+        try {
+            auto buffer = _explorer->get_buffer_pool().acquire(raw_chunk_size);
+            local.spectrum.data.reserve(1);
+
+            while (!failed.load(std::memory_order_relaxed)) {
+                auto index = next_chunk.fetch_add(1, std::memory_order_relaxed);
+
+                if (index >= results.size())
+                    break;
+
+                auto offset = index * raw_chunk_size;
+                auto len = (std::min)(raw_chunk_size, data_size - offset);
+                std::size_t size = 0;
+
+                while (size < len) {
+                    auto res = _explorer->read_at(hdr->data.start_offset + offset + size
+                        , buffer.data() + size, len - size, & local.err);
+
+                    if (!res.second) {
+                        failed = true;
+                        return;
+                    }
+
+                    if (res.first == 0)
+                        break;
+
+                    size += pfs::numeric_cast<std::size_t>(res.first);
+                }
+
+                results[index].size = size;
+
+                if (size == 0)
+                    continue;
+
+                local.spectrum.data.clear();
+
+                for (auto & ch: local.spectrum.envelope.channels) {
+                    ch.min.clear();
+                    ch.max.clear();
+                    ch.rms.clear();
+                }
+
+                if (!(this->*_build_proc)(local, buffer.data(), size)) {
+                    failed = true;
+                    return;
+                }
+
+                auto & r = results[index];
+                r.frame = local.spectrum.data.back();
+
+                for (std::size_t c = 0; c < channels; c++) {
+                    auto const & ch = local.spectrum.envelope.channels[c];
+                    r.min[c] = ch.min.back();
+                    r.max[c] = ch.max.back();
+                    r.rms[c] = ch.rms.back();
+                }
+            }
+        } catch (std::bad_alloc const &) {
+            local.err = error {std::make_error_code(std::errc::not_enough_memory)};
+            failed = true;
         }
+    };
 
-        if (is_mono8(ctx.spectrum.info)) {
-            _build_proc = & wav_spectrum_builder::build_from_mono8;
-        } else if (is_stereo8(ctx.spectrum.info)) {
-            _build_proc = & wav_spectrum_builder::build_from_stereo8;
-        } else if (is_mono16(ctx.spectrum.info)) {
-            _build_proc = & wav_spectrum_builder::build_from_mono16;
-        } else if (is_stereo16(ctx.spectrum.info)) {
-            _build_proc = & wav_spectrum_builder::build_from_stereo16;
-        } else {
-            ctx.err = error {tr::f_("8/16 bits and mono/stereo only")};
-            return false;
+    for (auto & local: contexts) {
+        local.frame_step = ctx.frame_step;
+        local.envelope = ctx.envelope;
+        local.spectrum.envelope.channels.resize(channels);
+        local.spectrum.max_frame = ctx.spectrum.max_frame;
+        local.spectrum.min_frame = ctx.spectrum.min_frame;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(thread_count - 1);
+
+    for (std::size_t i = 1; i < thread_count; i++) {
+        try {
+            workers.emplace_back(worker, std::ref(contexts[i]));
+        } catch (std::system_error const &) {
+            // Remaining chunks are processed by started threads
+            break;
         }
+    }
+
+    worker(contexts[0]);
 
-        *frames_chunk_size = ctx.spectrum.info.frame_count / chunk_count;
-        auto tail_size = ctx.spectrum.info.frame_count % chunk_count;
+    for (auto & t: workers)
+        t.join();
 
-        if (tail_size != 0) {
-            *frames_chunk_size = (ctx.spectrum.info.frame_count - tail_size)
-                / (chunk_count - 1);
+    for (auto & local: contexts) {
+        if (local.err) {
+            ctx.err = std::move(local.err);
+            return false;
         }
 
-        // Adjust frame_step
-        if (ctx.frame_step == (std::numeric_limits<decltype(ctx.frame_step)>::max)()) {
-            if (*frames_chunk_size < 1000)
-                ctx.frame_step = 1;
-            else if (*frames_chunk_size < 10000)
-                ctx.frame_step = 10;
-            else if (*frames_chunk_size < 100000)
-                ctx.frame_step = 100;
-            else
-                ctx.frame_step = 500;
+        auto & max_frame = ctx.spectrum.max_frame;
+        auto & min_frame = ctx.spectrum.min_frame;
+
+        max_frame.first  = (std::max)(max_frame.first, local.spectrum.max_frame.first);
+        max_frame.second = (std::max)(max_frame.second, local.spectrum.max_frame.second);
+        min_frame.first  = (std::min)(min_frame.first, local.spectrum.min_frame.first);
+        min_frame.second = (std::min)(min_frame.second, local.spectrum.min_frame.second);
+    }
+
+    ctx.spectrum.data.reserve(results.size());
+
+    // Data is truncated by the first empty chunk as while sequential decoding
+    for (auto const & r: results) {
+        if (r.size == 0)
+            break;
+
+        ctx.spectrum.data.push_back(r.frame);
+
+        for (std::size_t c = 0; c < channels; c++) {
+            auto & ch = ctx.spectrum.envelope.channels[c];
+            ch.min.push_back(r.min[c]);
+            ch.max.push_back(r.max[c]);
+            ch.rms.push_back(r.rms[c]);
         }
+    }
 
-        return true;
-    };
+    return true;
+}
 
-    _explorer->on_raw_data = [this, & ctx] (char const * raw_samples, std::size_t size) {
-        return (this->*_build_proc)(ctx, raw_samples, size);
-    };
+pfs::optional<wav_spectrum>
+wav_spectrum_builder::operator () (std::size_t chunk_count, std::size_t frame_step, error * perr)
+{
+    if (chunk_count == 0) {
+        pfs::throw_or(perr, tr::_("chunk count must be greater than 0"));
+        return pfs::nullopt;
+    }
+
+    builder_context ctx;
+    ctx.frame_step = frame_step;
+    ctx.envelope = _envelope == envelope_enum::on;
 
-    if (!_explorer->decode()) {
+    auto thread_count = _thread_count > 0
+        ? _thread_count
+        : static_cast<std::size_t>((std::max)(1U, std::thread::hardware_concurrency()));
+
+    auto success = thread_count > 1 && _explorer->concurrent_reads()
+        ? build_parallel(ctx, chunk_count, thread_count)
+        : build_sequential(ctx, chunk_count);
+
+    if (!success) {
         pfs::throw_or(perr, std::move(ctx.err));
         return pfs::nullopt;
     }
@@ -403,30 +688,57 @@ wav_spectrum_builder::operator () (std::size_t chunk_count, std::size_t frame_st
     return ctx.spectrum;
 }
 
-inline float normalize_sample8 (std::uint8_t value)
+static void append_envelope (wav_envelope & envelope, sample_stats const * stats)
+{
+    for (std::size_t c = 0; c < envelope.channels.size(); c++) {
+        auto & ch = envelope.channels[c];
+        auto empty = stats[c].count == 0;
+
+        ch.min.push_back(empty ? 0.f : stats[c].min);
+        ch.max.push_back(empty ? 0.f : stats[c].max);
+        ch.rms.push_back(stats[c].rms());
+    }
+}
+
+static void append_mono (wav_spectrum & spectrum, sample_stats const & stats)
 {
-    float res = (value - 128.0f) / 255.0f;
+    if (stats.count > 0) {
+        float sample = stats.mean();
 
-    if (res > 1.0f)
-        res = 1.0f;
+        if (sample > spectrum.max_frame.first)
+            spectrum.max_frame.first = sample;
 
-    if (res < -1.0f)
-        res = -1.0f;
+        if (sample < spectrum.min_frame.first)
+            spectrum.min_frame.first = sample;
 
-    return res;
+        spectrum.data.push_back(std::make_pair(sample, 0.f));
+    } else {
+        spectrum.data.push_back(std::make_pair(0.f, 0.f));
+    }
 }
 
-inline float normalize_sample16 (std::int16_t value)
+static void append_stereo (wav_spectrum & spectrum, sample_stats const (& stats)[2])
 {
-    float res = value / 32767.0f;
+    if (stats[0].count > 0) {
+        float left  = stats[0].mean();
+        float right = stats[1].mean();
+
+        if (left > spectrum.max_frame.first)
+            spectrum.max_frame.first = left;
+
+        if (right > spectrum.max_frame.second)
+            spectrum.max_frame.second = right;
 
-    if (res > 1.0f)
-        res = 1.0f;
+        if (left < spectrum.min_frame.first)
+            spectrum.min_frame.first = left;
 
-    if (res < -1.0f)
-        res = -1.0f;
+        if (right < spectrum.min_frame.second)
+            spectrum.min_frame.second = right;
 
-    return res;
+        spectrum.data.push_back(std::make_pair(left, right));
+    } else {
+        spectrum.data.push_back(std::make_pair(0.f, 0.f));
+    }
 }
 
 bool wav_spectrum_builder::build_from_mono8 (builder_context & ctx
@@ -439,33 +751,13 @@ bool wav_spectrum_builder::build_from_mono8 (builder_context & ctx
         return false;
     }
 
-    using frame_iterator = ionik::audio::u8_mono_frame_iterator;
-    frame_iterator pos {raw_samples};
-    frame_iterator last {raw_samples + size};
-    frame_iterator::value_type frame;
-    std::size_t count = 0;
-    float sum = 0;
-
-    for (; pos < last; pos += ctx.frame_step) {
-        frame = *pos;
-        float sample  = normalize_sample8(frame.sample);
-        sum += sample;
-        count++;
-    }
-
-    if (count > 0) {
-        float sample  = sum / count;
+    sample_stats stats[1];
+    reduce_samples(reinterpret_cast<std::uint8_t const *>(raw_samples), samples_count, 1
+        , ctx.frame_step, stats);
+    append_mono(ctx.spectrum, stats[0]);
 
-        if (sample > ctx.spectrum.max_frame.first)
-            ctx.spectrum.max_frame.first = sample;
-
-        if (sample < ctx.spectrum.min_frame.first)
-            ctx.spectrum.min_frame.first = sample;
-
-        ctx.spectrum.data.push_back(std::make_pair(sample, 0.f));
-    } else {
-        ctx.spectrum.data.push_back(std::make_pair(0.f, 0.f));
-    }
+    if (ctx.envelope)
+        append_envelope(ctx.spectrum.envelope, stats);
 
     return true;
 }
@@ -473,7 +765,6 @@ bool wav_spectrum_builder::build_from_mono8 (builder_context & ctx
 bool wav_spectrum_builder::build_from_stereo8 (builder_context & ctx
     , char const * raw_samples, std::size_t size)
 {
-    // HERE-----------------------------------v
     auto samples_count = size / sizeof(std::uint8_t);
 
     if (size % samples_count != 0) {
@@ -481,47 +772,13 @@ bool wav_spectrum_builder::build_from_stereo8 (builder_context & ctx
         return false;
     }
 
-    // HERE------------------------------------------v
-    using frame_iterator = ionik::audio::u8_stereo_frame_iterator;
-    frame_iterator pos {raw_samples};
-    frame_iterator last {raw_samples + size};
-    frame_iterator::value_type frame;
-    std::size_t count = 0;
-    float left_sum = 0;
-    float right_sum = 0;
-
-    for (; pos < last; pos += ctx.frame_step) {
-        frame = *pos;
-
-        // HERE----------------v
-        float left  = normalize_sample8(frame.left);
-        float right = normalize_sample8(frame.right);
-
-        left_sum += left;
-        right_sum += right;
-        count++;
-    }
-
-    if (count > 0) {
-        float left  = left_sum / count;
-        float right = right_sum / count;
-
-        if (left > ctx.spectrum.max_frame.first)
-            ctx.spectrum.max_frame.first = left;
+    sample_stats stats[2];
+    reduce_samples(reinterpret_cast<std::uint8_t const *>(raw_samples), samples_count / 2, 2
+        , ctx.frame_step, stats);
+    append_stereo(ctx.spectrum, stats);
 
-        if (right > ctx.spectrum.max_frame.second)
-            ctx.spectrum.max_frame.second = right;
-
-        if (left < ctx.spectrum.min_frame.first)
-            ctx.spectrum.min_frame.first = left;
-
-        if (right < ctx.spectrum.min_frame.second)
-            ctx.spectrum.min_frame.second = right;
-
-        ctx.spectrum.data.push_back(std::make_pair(left, right));
-    } else {
-        ctx.spectrum.data.push_back(std::make_pair(0.f, 0.f));
-    }
+    if (ctx.envelope)
+        append_envelope(ctx.spectrum.envelope, stats);
 
     return true;
 }
@@ -536,33 +793,13 @@ bool wav_spectrum_builder::build_from_mono16 (builder_context & ctx
         return false;
     }
 
-    using frame_iterator = ionik::audio::s16_mono_frame_iterator;
-    frame_iterator pos {raw_samples};
-    frame_iterator last {raw_samples + size};
-    frame_iterator::value_type frame;
-    std::size_t count = 0;
-    float sum = 0;
+    sample_stats stats[1];
+    reduce_samples(reinterpret_cast<std::int16_t const *>(raw_samples), samples_count, 1
+        , ctx.frame_step, stats);
+    append_mono(ctx.spectrum, stats[0]);
 
-    for (; pos < last; pos += ctx.frame_step) {
-        frame = *pos;
-        float sample  = normalize_sample16(frame.sample);
-        sum += sample;
-        count++;
-    }
-
-    if (count > 0) {
-        float sample  = sum / count;
-
-        if (sample > ctx.spectrum.max_frame.first)
-            ctx.spectrum.max_frame.first = sample;
-
-        if (sample < ctx.spectrum.min_frame.first)
-            ctx.spectrum.min_frame.first = sample;
-
-        ctx.spectrum.data.push_back(std::make_pair(sample, 0.f));
-    } else {
-        ctx.spectrum.data.push_back(std::make_pair(0.f, 0.f));
-    }
+    if (ctx.envelope)
+        append_envelope(ctx.spectrum.envelope, stats);
 
     return true;
 }
@@ -576,44 +813,14 @@ bool wav_spectrum_builder::build_from_stereo16 (builder_context & ctx
         ctx.err = error {tr::_("bad data format or data may be corrupted")};
         return false;
     }
-    using frame_iterator = ionik::audio::s16_stereo_frame_iterator;
-    frame_iterator pos {raw_samples};
-    frame_iterator last {raw_samples + size};
-    frame_iterator::value_type frame;
-    std::size_t count = 0;
-    float left_sum = 0;
-    float right_sum = 0;
-
-    for (; pos < last; pos += ctx.frame_step) {
-        frame = *pos;
-        float left  = normalize_sample16(frame.left);
-        float right = normalize_sample16(frame.right);
-
-        left_sum += left;
-        right_sum += right;
-        count++;
-    }
-
-    if (count > 0) {
-        float left  = left_sum / count;
-        float right = right_sum / count;
 
-        if (left > ctx.spectrum.max_frame.first)
-            ctx.spectrum.max_frame.first = left;
+    sample_stats stats[2];
+    reduce_samples(reinterpret_cast<std::int16_t const *>(raw_samples), samples_count / 2, 2
+        , ctx.frame_step, stats);
+    append_stereo(ctx.spectrum, stats);
 
-        if (right > ctx.spectrum.max_frame.second)
-            ctx.spectrum.max_frame.second = right;
-
-        if (left < ctx.spectrum.min_frame.first)
-            ctx.spectrum.min_frame.first = left;
-
-        if (right < ctx.spectrum.min_frame.second)
-            ctx.spectrum.min_frame.second = right;
-
-        ctx.spectrum.data.push_back(std::make_pair(left, right));
-    } else {
-        ctx.spectrum.data.push_back(std::make_pair(0.f, 0.f));
-    }
+    if (ctx.envelope)
+        append_envelope(ctx.spectrum.envelope, stats);
 
     return true;
 }
@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/i18n.hpp"
+#include "pfs/ionik/audio/sample_kernels.hpp"
+#include "pfs/ionik/audio/waveform_pyramid.hpp"
+#include "pfs/ionik/hashing.hpp"
+#include "pfs/ionik/local_file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace fs = pfs::filesystem;
+
+namespace ionik {
+namespace audio {
+
+constexpr std::size_t waveform_pyramid::DEFAULT_BASE_FRAMES;
+
+// Sidecar file layout (little-endian):
+//      magic "IWFP", version (u32), channels (u32), base frames (u32), frame count (u64),
+//      CRC-32C of payload (u32), reserved (u32), WAV file size (u64), WAV file modification
+//      time in nanoseconds since epoch (i64);
+//      payload: for each level, for each channel min, max and RMS arrays of floats.
+static char const SIDECAR_MAGIC[4] = {'I', 'W', 'F', 'P'};
+static constexpr std::uint32_t SIDECAR_VERSION = 2;
+static constexpr std::size_t SIDECAR_HEADER_SIZE = 48;
+static char const * const SIDECAR_SUFFIX = ".wfp";
+
+static void put_u32 (char * p, std::uint32_t value) noexcept
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+static std::uint32_t get_u32 (char const * p) noexcept
+{
+    std::uint32_t result = 0;
+
+    for (int i = 0; i < 4; i++)
+        result |= static_cast<std::uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+
+    return result;
+}
+
+static void put_u64 (char * p, std::uint64_t value) noexcept
+{
+    put_u32(p, static_cast<std::uint32_t>(value & 0xFFFFFFFF));
+    put_u32(p + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+static std::uint64_t get_u64 (char const * p) noexcept
+{
+    return get_u32(p) | std::uint64_t{get_u32(p + 4)} << 32;
+}
+
+static void put_floats (std::string & out, std::vector<float> const & values)
+{
+    char buf[4];
+
+    for (auto v: values) {
+        std::uint32_t bits;
+        std::memcpy(& bits, & v, 4);
+        put_u32(buf, bits);
+        out.append(buf, 4);
+    }
+}
+
+static char const * get_floats (char const * p, std::size_t n, std::vector<float> & values)
+{
+    values.resize(n);
+
+    for (std::size_t i = 0; i < n; i++, p += 4) {
+        auto bits = get_u32(p);
+        std::memcpy(& values[i], & bits, 4);
+    }
+
+    return p;
+}
+
+static void throw_corrupted (fs::path const & path, std::string const & reason, error * perr)
+{
+    pfs::throw_or(perr, std::make_error_code(std::errc::illegal_byte_sequence)
+        , tr::f_("corrupted waveform file: {}: {}", pfs::utf8_encode_path(path), reason));
+}
+
+static void append_point (wav_envelope::channel_data & ch, float min, float max, float rms)
+{
+    ch.min.push_back(min);
+    ch.max.push_back(max);
+    ch.rms.push_back(rms);
+}
+
+std::size_t waveform_pyramid::chunk_frames (std::size_t level, std::size_t index) const noexcept
+{
+    std::uint64_t width = std::uint64_t{_base_frames} << level;
+    std::uint64_t first = width * index;
+
+    return first >= _frame_count
+        ? 0
+        : static_cast<std::size_t>((std::min)(width, _frame_count - first));
+}
+
+void waveform_pyramid::build_levels ()
+{
+    while (_levels.back().size() > 1) {
+        auto level = _levels.size() - 1;
+        auto const & prev = _levels.back();
+        auto n = prev.size();
+
+        wav_envelope next;
+        next.channels.resize(_channels);
+
+        for (std::size_t c = 0; c < _channels; c++) {
+            auto const & src = prev.channels[c];
+            auto & dst = next.channels[c];
+
+            dst.min.reserve((n + 1) / 2);
+            dst.max.reserve((n + 1) / 2);
+            dst.rms.reserve((n + 1) / 2);
+
+            for (std::size_t i = 0; i < n; i += 2) {
+                if (i + 1 == n) {
+                    append_point(dst, src.min[i], src.max[i], src.rms[i]);
+                    continue;
+                }
+
+                // Mean squares are weighted by number of frames (the last chunk is incomplete)
+                double wa = static_cast<double>(chunk_frames(level, i));
+                double wb = static_cast<double>(chunk_frames(level, i + 1));
+                double ms = (double{src.rms[i]} * src.rms[i] * wa
+                    + double{src.rms[i + 1]} * src.rms[i + 1] * wb) / (wa + wb);
+
+                append_point(dst, (std::min)(src.min[i], src.min[i + 1])
+                    , (std::max)(src.max[i], src.max[i + 1]), static_cast<float>(std::sqrt(ms)));
+            }
+        }
+
+        _levels.push_back(std::move(next));
+    }
+}
+
+wav_envelope waveform_pyramid::query (std::uint64_t first_frame, std::uint64_t last_frame
+    , std::size_t count) const
+{
+    wav_envelope result;
+    result.channels.resize(_channels);
+
+    last_frame = (std::min)(last_frame, _frame_count);
+
+    if (count == 0 || first_frame >= last_frame || _levels.empty())
+        return result;
+
+    for (auto & ch: result.channels) {
+        ch.min.reserve(count);
+        ch.max.reserve(count);
+        ch.rms.reserve(count);
+    }
+
+    auto span = last_frame - first_frame;
+    auto point_frames = (std::max)(span / count, std::uint64_t{1});
+
+    // Coarsest level which chunks are not wider than the point, so the point is built from
+    // a few chunks only
+    std::size_t level = 0;
+
+    while (level + 1 < _levels.size()
+            && (std::uint64_t{_base_frames} << (level + 1)) <= point_frames) {
+        level++;
+    }
+
+    auto width = std::uint64_t{_base_frames} << level;
+    auto const & env = _levels[level];
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto a = first_frame + span * i / count;
+        auto b = (std::max)(first_frame + span * (i + 1) / count, a + 1);
+        auto lo = static_cast<std::size_t>(a / width);
+        auto hi = static_cast<std::size_t>((b - 1) / width) + 1;
+
+        for (std::size_t c = 0; c < _channels; c++) {
+            auto const & src = env.channels[c];
+            auto min = src.min[lo];
+            auto max = src.max[lo];
+            double ms = 0;
+            double weight = 0;
+
+            for (auto k = lo; k < hi; k++) {
+                double w = static_cast<double>(chunk_frames(level, k));
+                min = (std::min)(min, src.min[k]);
+                max = (std::max)(max, src.max[k]);
+                ms += double{src.rms[k]} * src.rms[k] * w;
+                weight += w;
+            }
+
+            append_point(result.channels[c], min, max
+                , static_cast<float>(std::sqrt(ms / weight)));
+        }
+    }
+
+    return result;
+}
+
+bool waveform_pyramid::save (fs::path const & path, error * perr) const
+{
+    std::string payload;
+
+    for (auto const & env: _levels) {
+        for (auto const & ch: env.channels) {
+            put_floats(payload, ch.min);
+            put_floats(payload, ch.max);
+            put_floats(payload, ch.rms);
+        }
+    }
+
+    std::string content(SIDECAR_HEADER_SIZE, '\0');
+    auto p = & content[0];
+
+    std::memcpy(p, SIDECAR_MAGIC, 4);
+    put_u32(p + 4, SIDECAR_VERSION);
+    put_u32(p + 8, static_cast<std::uint32_t>(_channels));
+    put_u32(p + 12, static_cast<std::uint32_t>(_base_frames));
+    put_u64(p + 16, _frame_count);
+    put_u32(p + 24, crc32c::compute(payload.data(), payload.size()));
+    put_u64(p + 32, _source_size);
+    put_u64(p + 40, static_cast<std::uint64_t>(_source_mtime));
+
+    content += payload;
+
+    return local_file::rewrite(path, content, rewrite_policy_enum::atomic, perr);
+}
+
+namespace {
+
+// Restores decoder callbacks of the explorer on scope exit
+class callbacks_guard
+{
+    wav_explorer_base & _explorer;
+    decltype(wav_explorer_base::on_error) _on_error;
+    decltype(wav_explorer_base::on_wav_info) _on_wav_info;
+    decltype(wav_explorer_base::on_raw_data) _on_raw_data;
+
+public:
+    callbacks_guard (wav_explorer_base & explorer)
+        : _explorer(explorer)
+        , _on_error(explorer.on_error)
+        , _on_wav_info(explorer.on_wav_info)
+        , _on_raw_data(explorer.on_raw_data)
+    {}
+
+    ~callbacks_guard ()
+    {
+        _explorer.on_error = std::move(_on_error);
+        _explorer.on_wav_info = std::move(_on_wav_info);
+        _explorer.on_raw_data = std::move(_on_raw_data);
+    }
+};
+
+} // namespace
+
+pfs::optional<waveform_pyramid> waveform_pyramid::build (wav_explorer_base & explorer
+    , std::size_t base_frames, error * perr)
+{
+    if (base_frames == 0) {
+        pfs::throw_or(perr, tr::_("number of base frames must be greater than 0"));
+        return pfs::nullopt;
+    }
+
+    waveform_pyramid result;
+    result._base_frames = base_frames;
+
+    error err;
+    int sample_size = 0;
+    std::size_t frame_size = 0;
+    std::size_t chunk_fill = 0; // Frames accumulated in the current chunk of level 0
+    sample_stats chunk[2];
+    wav_envelope level0;
+
+    auto flush_chunk = [&] () {
+        for (std::size_t c = 0; c < result._channels; c++) {
+            append_point(level0.channels[c], chunk[c].min, chunk[c].max, chunk[c].rms());
+            chunk[c] = sample_stats{};
+        }
+
+        chunk_fill = 0;
+    };
+
+    callbacks_guard guard {explorer};
+
+    explorer.on_error = [& err] (error const & e) { err = e; };
+
+    explorer.on_wav_info = [&] (wav_info const & info, std::size_t * frames_chunk_size) {
+        if (!(is_mono8(info) || is_stereo8(info) || is_mono16(info) || is_stereo16(info))) {
+            err = error {tr::f_("8/16 bits and mono/stereo only")};
+            return false;
+        }
+
+        result._channels = static_cast<std::size_t>(info.num_channels);
+        sample_size = info.sample_size;
+        frame_size = result._channels * (sample_size <= 8 ? 1 : 2);
+        level0.channels.resize(result._channels);
+
+        // Whole number of chunks is decoded at once
+        *frames_chunk_size = base_frames * (std::max)(std::size_t{1}, 65536 / base_frames);
+        return true;
+    };
+
+    explorer.on_raw_data = [&] (char const * raw_samples, std::size_t size) {
+        auto frames = size / frame_size;
+
+        while (frames > 0) {
+            auto n = (std::min)(frames, base_frames - chunk_fill);
+
+            if (sample_size <= 8) {
+                reduce_samples(reinterpret_cast<std::uint8_t const *>(raw_samples), n
+                    , result._channels, 1, chunk);
+            } else {
+                reduce_samples(reinterpret_cast<std::int16_t const *>(raw_samples), n
+                    , result._channels, 1, chunk);
+            }
+
+            raw_samples += n * frame_size;
+            frames -= n;
+            chunk_fill += n;
+            result._frame_count += n;
+
+            if (chunk_fill == base_frames)
+                flush_chunk();
+        }
+
+        return true;
+    };
+
+    if (!explorer.decode()) {
+        pfs::throw_or(perr, std::move(err));
+        return pfs::nullopt;
+    }
+
+    if (chunk_fill > 0)
+        flush_chunk();
+
+    if (result._frame_count > 0) {
+        result._levels.push_back(std::move(level0));
+        result.build_levels();
+    }
+
+    return result;
+}
+
+pfs::optional<waveform_pyramid> waveform_pyramid::load (fs::path const & path, error * perr)
+{
+    error err;
+    std::string content;
+    auto res = local_file::read_all(path, content, & err);
+
+    if (!res.second) {
+        pfs::throw_or(perr, std::move(err));
+        return pfs::nullopt;
+    }
+
+    if (content.size() < SIDECAR_HEADER_SIZE || std::memcmp(content.data(), SIDECAR_MAGIC, 4) != 0) {
+        throw_corrupted(path, tr::_("bad header"), perr);
+        return pfs::nullopt;
+    }
+
+    auto p = content.data();
+
+    if (get_u32(p + 4) != SIDECAR_VERSION) {
+        throw_corrupted(path, tr::f_("unsupported version: {}", get_u32(p + 4)), perr);
+        return pfs::nullopt;
+    }
+
+    waveform_pyramid result;
+    result._channels = get_u32(p + 8);
+    result._base_frames = get_u32(p + 12);
+    result._frame_count = get_u64(p + 16);
+    result._source_size = get_u64(p + 32);
+    result._source_mtime = static_cast<std::int64_t>(get_u64(p + 40));
+
+    if (result._channels < 1 || result._channels > 2 || result._base_frames == 0) {
+        throw_corrupted(path, tr::_("bad header"), perr);
+        return pfs::nullopt;
+    }
+
+    // Expected payload size is calculated from the header
+    std::uint64_t points = 0;
+    std::uint64_t n = result._frame_count == 0
+        ? 0
+        : (result._frame_count + result._base_frames - 1) / result._base_frames;
+    std::vector<std::size_t> level_sizes;
+
+    while (n > 0) {
+        level_sizes.push_back(static_cast<std::size_t>(n));
+        points += n;
+        n = n > 1 ? (n + 1) / 2 : 0;
+    }
+
+    auto payload_size = content.size() - SIDECAR_HEADER_SIZE;
+
+    if (points * result._channels * 3 * 4 != payload_size) {
+        throw_corrupted(path, tr::_("bad size"), perr);
+        return pfs::nullopt;
+    }
+
+    p += SIDECAR_HEADER_SIZE;
+
+    if (get_u32(content.data() + 24) != crc32c::compute(p, payload_size)) {
+        throw_corrupted(path, tr::_("checksum mismatch"), perr);
+        return pfs::nullopt;
+    }
+
+    result._levels.resize(level_sizes.size());
+
+    for (std::size_t level = 0; level < level_sizes.size(); level++) {
+        auto & env = result._levels[level];
+        env.channels.resize(result._channels);
+
+        for (auto & ch: env.channels) {
+            p = get_floats(p, level_sizes[level], ch.min);
+            p = get_floats(p, level_sizes[level], ch.max);
+            p = get_floats(p, level_sizes[level], ch.rms);
+        }
+    }
+
+    return result;
+}
+
+fs::path waveform_pyramid::sidecar_path (fs::path const & wav_path)
+{
+    auto path = wav_path;
+    path += pfs::utf8_decode_path(SIDECAR_SUFFIX);
+    return path;
+}
+
+pfs::optional<waveform_pyramid> waveform_pyramid::open (fs::path const & wav_path
+    , std::size_t base_frames, error * perr)
+{
+    error err;
+    auto wav_file = local_file::open_read_only(wav_path, & err);
+
+    if (!wav_file) {
+        pfs::throw_or(perr, std::move(err));
+        return pfs::nullopt;
+    }
+
+    auto source_size = wav_file.stat().size;
+    std::int64_t source_mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        wav_file.stat().mtime.time_since_epoch()).count();
+
+    auto path = sidecar_path(wav_path);
+
+    {
+        // Stale or damaged sidecar is rebuilt
+        error load_err;
+        auto pyramid = load(path, & load_err);
+
+        if (pyramid && pyramid->_base_frames == base_frames
+                && pyramid->_source_size == source_size
+                && pyramid->_source_mtime == source_mtime) {
+            return pyramid;
+        }
+    }
+
+    wav_explorer explorer {std::move(wav_file)};
+    auto pyramid = build(explorer, base_frames, perr);
+
+    if (pyramid) {
+        pyramid->_source_size = source_size;
+        pyramid->_source_mtime = source_mtime;
+
+        error save_err;
+        pyramid->save(path, & save_err);
+    }
+
+    return pyramid;
+}
+
+}} // namespace ionik::audio
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/ionik/buffer_pool.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ionik {
+
+constexpr std::size_t buffer_pool::DEFAULT_ALIGNMENT;
+constexpr std::size_t buffer_pool::DEFAULT_MAX_CACHED;
+constexpr std::size_t buffer_pool::DEFAULT_MAX_CACHED_BYTES;
+constexpr std::size_t buffer_pool::DEFAULT_MAX_BUFFER_SIZE;
+
+static std::size_t round_up_pow2 (std::size_t n) noexcept
+{
+    std::size_t result = 1;
+
+    while (result < n)
+        result <<= 1;
+
+    return result;
+}
+
+void pooled_buffer::resize (std::size_t size)
+{
+    if (size <= _buf.size()) {
+        _size = size;
+        return;
+    }
+
+    auto pool = _pool != nullptr ? _pool : & buffer_pool::shared();
+    auto larger = pool->acquire(size);
+
+    if (_size > 0)
+        std::memcpy(larger.data(), _buf.data(), _size);
+
+    swap(larger);
+}
+
+void pooled_buffer::release () noexcept
+{
+    if (_pool != nullptr && !_buf.empty())
+        _pool->recycle(std::move(_buf));
+
+    _buf = aligned_buffer{};
+    _size = 0;
+}
+
+buffer_pool::buffer_pool (std::size_t alignment, huge_pages_enum huge, std::size_t max_cached
+    , std::size_t max_cached_bytes, std::size_t max_buffer_size)
+    : _alignment(alignment)
+    , _huge(huge)
+    , _max_cached(max_cached)
+    , _max_cached_bytes(max_cached_bytes)
+    , _max_buffer_size(max_buffer_size)
+{
+    // Recycling must not allocate
+    _cache.reserve(_max_cached);
+}
+
+pooled_buffer buffer_pool::acquire (std::size_t size)
+{
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+
+        auto pos = _cache.end();
+
+        for (auto it = _cache.begin(); it != _cache.end(); ++it) {
+            if (it->size() >= size && (pos == _cache.end() || it->size() < pos->size()))
+                pos = it;
+        }
+
+        if (pos != _cache.end()) {
+            aligned_buffer buf {std::move(*pos)};
+            _cache.erase(pos);
+            _cached_bytes -= buf.size();
+            return pooled_buffer{this, std::move(buf), size};
+        }
+    }
+
+    auto capacity = round_up_pow2((std::max)(size, _alignment));
+
+    // Buffer will not be cached, so there is no reason to round it up to power of two
+    if (capacity > _max_buffer_size || capacity > _max_cached_bytes)
+        capacity = (std::max)((size + _alignment - 1) / _alignment * _alignment, _alignment);
+
+    // Huge pages are worth for buffers of at least one huge page only
+    auto huge = capacity >= aligned_buffer::HUGE_PAGE_SIZE ? _huge : huge_pages_enum::off;
+
+    return pooled_buffer{this, aligned_buffer{capacity, _alignment, huge}, size};
+}
+
+std::size_t buffer_pool::cached () const
+{
+    std::unique_lock<std::mutex> locker{_mtx};
+    return _cache.size();
+}
+
+std::size_t buffer_pool::cached_bytes () const
+{
+    std::unique_lock<std::mutex> locker{_mtx};
+    return _cached_bytes;
+}
+
+void buffer_pool::clear ()
+{
+    std::vector<aligned_buffer> cache;
+    cache.reserve(_max_cached);
+
+    std::unique_lock<std::mutex> locker{_mtx};
+    _cache.swap(cache);
+    _cached_bytes = 0;
+}
+
+void buffer_pool::recycle (aligned_buffer && buf) noexcept
+{
+    // Not moved buffer is freed by the caller
+    if (buf.size() > _max_buffer_size || buf.size() > _max_cached_bytes)
+        return;
+
+    std::unique_lock<std::mutex> locker{_mtx};
+
+    // Pool is full: evict smaller buffers, larger ones satisfy more requests
+    while (_cache.size() >= _max_cached || _cached_bytes + buf.size() > _max_cached_bytes) {
+        auto pos = std::min_element(_cache.begin(), _cache.end()
+            , [] (aligned_buffer const & a, aligned_buffer const & b) { return a.size() < b.size(); });
+
+        if (pos == _cache.end() || pos->size() >= buf.size())
+            return;
+
+        _cached_bytes -= pos->size();
+        _cache.erase(pos);
+    }
+
+    _cached_bytes += buf.size();
+    _cache.push_back(std::move(buf));
+}
+
+buffer_pool & buffer_pool::shared ()
+{
+    static buffer_pool pool;
+    return pool;
+}
+
+} // namespace ionik
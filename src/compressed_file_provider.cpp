@@ -0,0 +1,1247 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.15 Added non-throwing `try_*` I/O calls.
+//      2026.10.16 Non-throwing calls report error code without formatting the message.
+//      2026.10.16 Seek table is removed on opening for appending.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/i18n.hpp"
+#include "pfs/ionik/compressed_file.hpp"
+#include "pfs/ionik/error.hpp"
+#include "pfs/ionik/local_file.hpp"
+#include <pfs/numeric_cast.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define ZSTD_STATIC_LINKING_ONLY // For ZSTD_getFrameHeader()
+#include <zstd.h>
+
+namespace fs = pfs::filesystem;
+
+namespace ionik {
+
+using file_provider_t = compressed_file_provider;
+using filepath_t = file_provider_t::filepath_type;
+using filesize_t = file_provider_t::filesize_type;
+using handle_t = file_provider_t::handle_type;
+using native_provider_t = local_file_provider;
+using native_handle_t = native_provider_t::handle_type;
+
+// Seek table layout of the zstd seekable format (see zstd/contrib/seekable_format):
+//      skippable frame header: magic (u32), frame size (u32);
+//      entries: compressed size (u32), decompressed size (u32) [, checksum (u32)];
+//      footer: number of frames (u32), descriptor (u8), seekable magic (u32).
+// All integers are little-endian.
+static constexpr std::uint32_t SKIPPABLE_FRAME_MAGIC = 0x184D2A5E;
+static constexpr std::uint32_t SEEKABLE_MAGIC = 0x8F92EAB1;
+static constexpr std::size_t SKIPPABLE_HEADER_SIZE = 8;
+static constexpr std::size_t SEEK_TABLE_FOOTER_SIZE = 9;
+static constexpr std::uint8_t CHECKSUM_FLAG = 0x80;
+static constexpr std::uint8_t RESERVED_BITS = 0x7C;
+
+static constexpr std::size_t MIN_FRAME_SIZE = 4 * 1024;
+static constexpr std::size_t MAX_FRAME_SIZE = 1024 * 1024 * 1024;
+static constexpr std::size_t OUTPUT_CHUNK_SIZE = 256 * 1024;
+static constexpr std::size_t NO_FRAME = (std::numeric_limits<std::size_t>::max)();
+
+struct frame_entry
+{
+    filesize_t offset;          // Offset of the compressed frame in the file
+    filesize_t compressed_size;
+    filesize_t data_offset;     // Offset of the frame content in the uncompressed data
+    filesize_t size;            // Uncompressed size
+};
+
+struct compressed_file_context
+{
+    native_handle_t h {native_provider_t::invalid()};
+    filepath_t path;
+    bool writable {false};
+    std::vector<frame_entry> frames;
+    filesize_t size {0};     // Uncompressed size (including pending data)
+    filesize_t data_end {0}; // End of the compressed frames (start of the seek table)
+    filesize_t pos {0};
+    std::size_t frame_size {0};
+
+    // Decompression state, guarded by mutex since positional reads can be concurrent
+    std::mutex mtx;
+    ZSTD_DCtx * dctx {nullptr};
+    std::size_t frame {NO_FRAME}; // Frame being decompressed
+    filesize_t in_offset {0};     // File offset of the next compressed chunk
+    std::vector<char> in;
+    std::size_t in_pos {0};
+    std::size_t in_size {0};
+    std::vector<char> out;        // Recently decompressed chunk
+    filesize_t out_offset {0};    // Uncompressed offset of the chunk
+    std::size_t out_size {0};
+
+    // Compression state
+    ZSTD_CCtx * cctx {nullptr};
+    std::vector<char> pending;    // Data of the frame not compressed yet
+    std::vector<char> compressed;
+    bool index_dirty {false};     // Seek table must be (re)written
+
+    ~compressed_file_context ()
+    {
+        ZSTD_freeDCtx(dctx);
+        ZSTD_freeCCtx(cctx);
+
+        if (!native_provider_t::is_invalid(h))
+            native_provider_t::close(h);
+    }
+};
+
+static void put_u32 (char * p, std::uint32_t value) noexcept
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+static std::uint32_t get_u32 (char const * p) noexcept
+{
+    std::uint32_t result = 0;
+
+    for (int i = 0; i < 4; i++)
+        result |= static_cast<std::uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+
+    return result;
+}
+
+static void throw_corrupted (filepath_t const & path, std::string const & reason, error * perr)
+{
+    pfs::throw_or(perr, std::make_error_code(std::errc::illegal_byte_sequence)
+        , tr::f_("corrupted compressed file: {}: {}", pfs::utf8_encode_path(path.path), reason));
+}
+
+// Failure of reading or writing data reported without formatting the message, so non-throwing
+// calls do not allocate. Descriptions are static strings.
+struct data_failure
+{
+    std::error_code ec;
+    char const * what {nullptr};
+    char const * detail {nullptr}; // zstd error name
+};
+
+static bool fail (data_failure & f, std::errc ec, char const * what, char const * detail = nullptr)
+{
+    f.ec = std::make_error_code(ec);
+    f.what = what;
+    f.detail = detail;
+    return false;
+}
+
+static void throw_failure (compressed_file_context const & c, data_failure const & f, error * perr)
+{
+    auto what = f.detail == nullptr ? tr::_(f.what) : tr::f_("{}: {}", tr::_(f.what), f.detail);
+
+    if (f.ec == std::errc::illegal_byte_sequence)
+        throw_corrupted(c.path, what, perr);
+    else
+        pfs::throw_or(perr, f.ec, what);
+}
+
+static bool read_fully (native_handle_t h, filesize_t offset, char * buffer, filesize_t len
+    , data_failure & f)
+{
+    while (len > 0) {
+        auto res = native_provider_t::try_read_at(h, offset, buffer, len);
+
+        if (!res) {
+            f.ec = res.ec;
+            f.what = "read from compressed file";
+            f.detail = nullptr;
+            return false;
+        }
+
+        if (res.size == 0)
+            return fail(f, std::errc::illegal_byte_sequence, "unexpected end of file");
+
+        offset += res.size;
+        buffer += res.size;
+        len -= res.size;
+    }
+
+    return true;
+}
+
+static bool read_fully (compressed_file_context const & c, native_handle_t h, filesize_t offset
+    , char * buffer, filesize_t len, error * perr)
+{
+    data_failure f;
+
+    if (!read_fully(h, offset, buffer, len, f)) {
+        throw_failure(c, f, perr);
+        return false;
+    }
+
+    return true;
+}
+
+static bool write_fully (native_handle_t & h, filesize_t offset, char const * buffer
+    , filesize_t len, data_failure & f)
+{
+    while (len > 0) {
+        auto res = native_provider_t::try_write_at(h, offset, buffer, len);
+
+        if (!res) {
+            f.ec = res.ec;
+            f.what = "write into compressed file";
+            f.detail = nullptr;
+            return false;
+        }
+
+        if (res.size == 0)
+            return fail(f, std::errc::io_error, "write into compressed file: no data written");
+
+        offset += res.size;
+        buffer += res.size;
+        len -= res.size;
+    }
+
+    return true;
+}
+
+static bool read_seek_table (compressed_file_context & c, native_handle_t h, filesize_t file_size
+    , char const * footer, error * perr)
+{
+    auto count = static_cast<filesize_t>(get_u32(footer));
+    auto descriptor = static_cast<std::uint8_t>(footer[4]);
+
+    if (descriptor & RESERVED_BITS) {
+        throw_corrupted(c.path, tr::_("reserved bits are set in seek table descriptor"), perr);
+        return false;
+    }
+
+    filesize_t entry_size = (descriptor & CHECKSUM_FLAG) ? 12 : 8;
+    auto table_size = count * entry_size + SEEK_TABLE_FOOTER_SIZE;
+
+    if (table_size + SKIPPABLE_HEADER_SIZE > file_size) {
+        throw_corrupted(c.path, tr::_("seek table is out of file bounds"), perr);
+        return false;
+    }
+
+    std::vector<char> table(pfs::numeric_cast<std::size_t>(table_size + SKIPPABLE_HEADER_SIZE));
+    auto table_offset = file_size - table.size();
+
+    if (!read_fully(c, h, table_offset, table.data(), table.size(), perr))
+        return false;
+
+    if (get_u32(table.data()) != SKIPPABLE_FRAME_MAGIC || get_u32(table.data() + 4) != table_size) {
+        throw_corrupted(c.path, tr::_("bad seek table header"), perr);
+        return false;
+    }
+
+    filesize_t offset = 0;
+    filesize_t data_offset = 0;
+    auto p = table.data() + SKIPPABLE_HEADER_SIZE;
+
+    c.frames.reserve(pfs::numeric_cast<std::size_t>(count));
+
+    for (filesize_t i = 0; i < count; i++, p += entry_size) {
+        frame_entry e {offset, get_u32(p), data_offset, get_u32(p + 4)};
+        c.frames.push_back(e);
+        offset += e.compressed_size;
+        data_offset += e.size;
+    }
+
+    if (offset != table_offset) {
+        throw_corrupted(c.path, tr::_("seek table does not match frames"), perr);
+        return false;
+    }
+
+    c.data_end = offset;
+    c.size = data_offset;
+    return true;
+}
+
+// Measures uncompressed size of the frame without content size in the header
+static bool measure_frame (compressed_file_context & c, native_handle_t h, frame_entry & e
+    , error * perr)
+{
+    std::unique_ptr<ZSTD_DCtx, decltype(& ZSTD_freeDCtx)> dctx {ZSTD_createDCtx(), & ZSTD_freeDCtx};
+    std::vector<char> in(ZSTD_DStreamInSize());
+    std::vector<char> out(ZSTD_DStreamOutSize());
+    auto in_offset = e.offset;
+    auto in_end = e.offset + e.compressed_size;
+
+    e.size = 0;
+
+    while (in_offset < in_end) {
+        auto n = (std::min)(static_cast<filesize_t>(in.size()), in_end - in_offset);
+
+        if (!read_fully(c, h, in_offset, in.data(), n, perr))
+            return false;
+
+        in_offset += n;
+        ZSTD_inBuffer ib {in.data(), static_cast<std::size_t>(n), 0};
+
+        while (ib.pos < ib.size) {
+            ZSTD_outBuffer ob {out.data(), out.size(), 0};
+            auto rc = ZSTD_decompressStream(dctx.get(), & ob, & ib);
+
+            if (ZSTD_isError(rc)) {
+                throw_corrupted(c.path, ZSTD_getErrorName(rc), perr);
+                return false;
+            }
+
+            e.size += ob.pos;
+        }
+    }
+
+    return true;
+}
+
+// Builds frame index by walking frame and block headers (file without seek table)
+static bool scan_frames (compressed_file_context & c, native_handle_t h, filesize_t file_size
+    , error * perr)
+{
+    filesize_t offset = 0;
+    filesize_t data_offset = 0;
+    char header[ZSTD_FRAMEHEADERSIZE_MAX];
+
+    while (offset < file_size) {
+        auto n = (std::min)(static_cast<filesize_t>(sizeof(header)), file_size - offset);
+
+        if (!read_fully(c, h, offset, header, n, perr))
+            return false;
+
+        ZSTD_frameHeader zfh;
+        auto rc = ZSTD_getFrameHeader(& zfh, header, static_cast<std::size_t>(n));
+
+        if (rc != 0) {
+            throw_corrupted(c.path, ZSTD_isError(rc) ? ZSTD_getErrorName(rc)
+                : tr::_("incomplete frame header"), perr);
+            return false;
+        }
+
+        if (zfh.frameType == ZSTD_skippableFrame) {
+            offset += zfh.headerSize + zfh.frameContentSize;
+            continue;
+        }
+
+        auto p = offset + zfh.headerSize;
+
+        for (;;) {
+            char bh[3];
+
+            if (!read_fully(c, h, p, bh, sizeof(bh), perr))
+                return false;
+
+            // Block header is 3 bytes (little-endian)
+            auto value = static_cast<std::uint32_t>(static_cast<unsigned char>(bh[0]))
+                | static_cast<std::uint32_t>(static_cast<unsigned char>(bh[1])) << 8
+                | static_cast<std::uint32_t>(static_cast<unsigned char>(bh[2])) << 16;
+            auto block_type = (value >> 1) & 3;
+            auto block_size = value >> 3;
+
+            if (block_type == 3) {
+                throw_corrupted(c.path, tr::_("reserved block type"), perr);
+                return false;
+            }
+
+            // RLE block contains single byte
+            p += sizeof(bh) + (block_type == 1 ? 1 : block_size);
+
+            if (value & 1) // Last block
+                break;
+        }
+
+        if (zfh.checksumFlag)
+            p += 4;
+
+        if (p > file_size) {
+            throw_corrupted(c.path, tr::_("unexpected end of file"), perr);
+            return false;
+        }
+
+        frame_entry e {offset, p - offset, data_offset, zfh.frameContentSize};
+
+        if (zfh.frameContentSize == ZSTD_CONTENTSIZE_UNKNOWN) {
+            if (!measure_frame(c, h, e, perr))
+                return false;
+        }
+
+        c.frames.push_back(e);
+        data_offset += e.size;
+        offset = p;
+    }
+
+    c.data_end = offset;
+    c.size = data_offset;
+    return true;
+}
+
+static bool read_index (compressed_file_context & c, native_handle_t h, filesize_t file_size
+    , error * perr)
+{
+    if (file_size >= SKIPPABLE_HEADER_SIZE + SEEK_TABLE_FOOTER_SIZE) {
+        char footer[SEEK_TABLE_FOOTER_SIZE];
+
+        if (!read_fully(c, h, file_size - sizeof(footer), footer, sizeof(footer), perr))
+            return false;
+
+        if (get_u32(footer + 5) == SEEKABLE_MAGIC)
+            return read_seek_table(c, h, file_size, footer, perr);
+    }
+
+    return scan_frames(c, h, file_size, perr);
+}
+
+static bool compress_pending (compressed_file_context & c, data_failure & f)
+{
+    if (c.pending.empty())
+        return true;
+
+    auto bound = ZSTD_compressBound(c.pending.size());
+
+    if (c.compressed.size() < bound)
+        c.compressed.resize(bound);
+
+    auto rc = ZSTD_compressCCtx(c.cctx, c.compressed.data(), bound, c.pending.data()
+        , c.pending.size(), c.path.level);
+
+    if (ZSTD_isError(rc))
+        return fail(f, std::errc::io_error, "compress frame", ZSTD_getErrorName(rc));
+
+    if (!write_fully(c.h, c.data_end, c.compressed.data(), rc, f))
+        return false;
+
+    c.frames.push_back(frame_entry{c.data_end, rc, c.size - c.pending.size(), c.pending.size()});
+    c.data_end += rc;
+    c.pending.clear();
+    c.index_dirty = true;
+    return true;
+}
+
+static bool write_index (compressed_file_context & c, error * perr)
+{
+    data_failure f;
+
+    if (!compress_pending(c, f)) {
+        throw_failure(c, f, perr);
+        return false;
+    }
+
+    if (!c.index_dirty)
+        return true;
+
+    auto table_size = c.frames.size() * 8 + SEEK_TABLE_FOOTER_SIZE;
+    std::vector<char> table(SKIPPABLE_HEADER_SIZE + table_size);
+    auto p = table.data();
+
+    put_u32(p, SKIPPABLE_FRAME_MAGIC);
+    put_u32(p + 4, static_cast<std::uint32_t>(table_size));
+    p += SKIPPABLE_HEADER_SIZE;
+
+    for (auto const & e: c.frames) {
+        put_u32(p, static_cast<std::uint32_t>(e.compressed_size));
+        put_u32(p + 4, static_cast<std::uint32_t>(e.size));
+        p += 8;
+    }
+
+    put_u32(p, static_cast<std::uint32_t>(c.frames.size()));
+    p[4] = 0; // No checksums
+    put_u32(p + 5, SEEKABLE_MAGIC);
+
+    if (!write_fully(c.h, c.data_end, table.data(), table.size(), f)) {
+        throw_failure(c, f, perr);
+        return false;
+    }
+
+    // Cut off the rest of the previous seek table
+    if (!native_provider_t::resize(c.h, c.data_end + table.size(), preallocate_enum::off, perr))
+        return false;
+
+    c.index_dirty = false;
+    return true;
+}
+
+static void start_frame (compressed_file_context & c, std::size_t frame)
+{
+    ZSTD_DCtx_reset(c.dctx, ZSTD_reset_session_only);
+    c.frame = frame;
+    c.in_offset = c.frames[frame].offset;
+    c.in_pos = c.in_size = 0;
+    c.out_offset = c.frames[frame].data_offset;
+    c.out_size = 0;
+}
+
+// Decompresses next chunk of the current frame replacing the previous one
+static bool decompress_chunk (compressed_file_context & c, data_failure & f)
+{
+    auto const & e = c.frames[c.frame];
+    auto in_end = e.offset + e.compressed_size;
+    auto out_end = e.data_offset + e.size;
+
+    c.out_offset += c.out_size;
+    c.out_size = 0;
+
+    ZSTD_outBuffer ob {c.out.data(), c.out.size(), 0};
+
+    while (ob.pos < ob.size && c.out_offset + ob.pos < out_end) {
+        if (c.in_pos == c.in_size) {
+            auto n = (std::min)(static_cast<filesize_t>(c.in.size()), in_end - c.in_offset);
+
+            if (n == 0)
+                break;
+
+            if (!read_fully(c.h, c.in_offset, c.in.data(), n, f))
+                return false;
+
+            c.in_offset += n;
+            c.in_pos = 0;
+            c.in_size = static_cast<std::size_t>(n);
+        }
+
+        ZSTD_inBuffer ib {c.in.data(), c.in_size, c.in_pos};
+        auto rc = ZSTD_decompressStream(c.dctx, & ob, & ib);
+        c.in_pos = ib.pos;
+
+        if (ZSTD_isError(rc))
+            return fail(f, std::errc::illegal_byte_sequence, "decompress frame"
+                , ZSTD_getErrorName(rc));
+
+        if (rc == 0) // End of frame
+            break;
+    }
+
+    c.out_size = ob.pos;
+
+    if (c.out_size == 0) {
+        return fail(f, std::errc::illegal_byte_sequence
+            , "frame is shorter than specified in the index");
+    }
+
+    return true;
+}
+
+// Index of the frame containing uncompressed @a offset (must be less than the data size)
+static std::size_t find_frame (compressed_file_context const & c, filesize_t offset)
+{
+    auto pos = std::upper_bound(c.frames.cbegin(), c.frames.cend(), offset
+        , [] (filesize_t off, frame_entry const & e) { return off < e.data_offset; });
+
+    return static_cast<std::size_t>(pos - c.frames.cbegin()) - 1;
+}
+
+// Compressed region containing uncompressed region [offset, offset + len)
+static std::pair<filesize_t, filesize_t> compressed_region (compressed_file_context const & c
+    , filesize_t offset, filesize_t len)
+{
+    if (offset >= c.size || c.frames.empty())
+        return std::make_pair(filesize_t{0}, filesize_t{0});
+
+    auto last = len == 0 || len > c.size - offset ? c.size - 1 : offset + len - 1;
+    auto const & first_frame = c.frames[find_frame(c, offset)];
+    auto const & last_frame = c.frames[find_frame(c, last)];
+
+    return std::make_pair(first_frame.offset
+        , last_frame.offset + last_frame.compressed_size - first_frame.offset);
+}
+
+static handle_t make_writer (native_handle_t h, filepath_t const & path, error * perr)
+{
+    std::unique_ptr<compressed_file_context> c {new compressed_file_context};
+
+    c->h = h;
+    c->path = path;
+    c->writable = true;
+    c->frame_size = (std::max)(MIN_FRAME_SIZE, (std::min)(path.frame_size, MAX_FRAME_SIZE));
+    c->cctx = ZSTD_createCCtx();
+
+    if (c->cctx == nullptr) {
+        pfs::throw_or(perr, make_error_code(std::errc::not_enough_memory)
+            , tr::_("create compression context"));
+        return nullptr;
+    }
+
+    c->pending.reserve(c->frame_size);
+    return c.release();
+}
+
+template <>
+handle_t file_provider_t::invalid () noexcept
+{
+    return nullptr;
+}
+
+template <>
+bool file_provider_t::is_invalid (handle_type const & h) noexcept
+{
+    return h == nullptr;
+}
+
+template <>
+void file_provider_t::close (handle_t & h)
+{
+    if (h == nullptr)
+        return;
+
+    if (h->writable) {
+        error err;
+        write_index(*h, & err);
+    }
+
+    delete h;
+    h = nullptr;
+}
+
+template <>
+bool file_provider_t::stat (handle_t const & h, file_stat & st, error * perr)
+{
+    if (!native_provider_t::stat(h->h, st, perr))
+        return false;
+
+    st.size = h->size;
+    st.block_size = static_cast<std::uint32_t>(h->frame_size);
+    return true;
+}
+
+static filesize_t read_data (compressed_file_context & c, filesize_t offset, char * buffer
+    , filesize_t len, data_failure & f)
+{
+    if (c.writable) {
+        fail(f, std::errc::bad_file_descriptor, "read from compressed file opened for writing");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> locker {c.mtx};
+    filesize_t total = 0;
+
+    while (total < len && offset + total < c.size) {
+        auto pos = offset + total;
+
+        if (pos >= c.out_offset && pos < c.out_offset + c.out_size) {
+            auto n = (std::min)(len - total, c.out_offset + c.out_size - pos);
+            std::memcpy(buffer + total, c.out.data() + (pos - c.out_offset), static_cast<std::size_t>(n));
+            total += n;
+            continue;
+        }
+
+        auto frame = find_frame(c, pos);
+
+        // Frames are decompressed forward only
+        if (frame != c.frame || pos < c.out_offset)
+            start_frame(c, frame);
+
+        if (!decompress_chunk(c, f)) {
+            c.frame = NO_FRAME;
+            c.out_size = 0;
+            return 0;
+        }
+    }
+
+    return total;
+}
+
+static filesize_t write_data (compressed_file_context & c, filesize_t offset, char const * buffer
+    , filesize_t len, data_failure & f)
+{
+    if (!c.writable) {
+        fail(f, std::errc::bad_file_descriptor, "write into compressed file opened for reading");
+        return 0;
+    }
+
+    if (offset != c.size) {
+        fail(f, std::errc::operation_not_supported
+            , "compressed file can be written sequentially only");
+        return 0;
+    }
+
+    filesize_t total = 0;
+
+    while (total < len) {
+        auto n = (std::min)(len - total, static_cast<filesize_t>(c.frame_size - c.pending.size()));
+        c.pending.insert(c.pending.end(), buffer + total, buffer + total + n);
+        c.size += n;
+        total += n;
+
+        if (c.pending.size() == c.frame_size && !compress_pending(c, f)) {
+            // Failed piece is not accepted, so the size matches the data reported as written
+            c.pending.resize(c.pending.size() - static_cast<std::size_t>(n));
+            c.size -= n;
+            total -= n;
+
+            // Short write, failure is reported by the next write
+            if (total > 0)
+                f = data_failure{};
+
+            return total;
+        }
+    }
+
+    return total;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_at (handle_t const & h, filesize_t offset
+    , char * buffer, filesize_t len, error * perr)
+{
+    data_failure f;
+    auto n = read_data(*h, offset, buffer, len, f);
+
+    if (f.ec) {
+        throw_failure(*h, f, perr);
+        return std::make_pair(filesize_t{0}, false);
+    }
+
+    return std::make_pair(n, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_at (handle_t & h, filesize_t offset
+    , char const * buffer, filesize_t len, error * perr)
+{
+    data_failure f;
+    auto n = write_data(*h, offset, buffer, len, f);
+
+    if (f.ec) {
+        throw_failure(*h, f, perr);
+        return std::make_pair(filesize_t{0}, false);
+    }
+
+    return std::make_pair(n, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::offset (handle_t const & h, error *)
+{
+    return std::make_pair(h->pos, true);
+}
+
+template <>
+bool file_provider_t::set_pos (handle_t & h, filesize_t pos, error * perr)
+{
+    if (h->writable && pos != h->size) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("compressed file can be written sequentially only"));
+        return false;
+    }
+
+    h->pos = pos;
+    return true;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read (handle_t & h, char * buffer
+    , filesize_t len, error * perr)
+{
+    auto res = read_at(h, h->pos, buffer, len, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write (handle_t & h, char const * buffer
+    , filesize_t len, error * perr)
+{
+    auto res = write_at(h, h->pos, buffer, len, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+static io_result make_io_result (io_op_enum op, filesize_t size, std::error_code ec = {}) noexcept
+{
+    io_result result;
+    result.size = size;
+    result.ec = ec;
+    result.op = op;
+    return result;
+}
+
+template <>
+io_result file_provider_t::try_read (handle_t & h, char * buffer, filesize_t len)
+{
+    data_failure f;
+    auto n = read_data(*h, h->pos, buffer, len, f);
+    h->pos += n;
+    return make_io_result(io_op_enum::read, n, f.ec);
+}
+
+template <>
+io_result file_provider_t::try_write (handle_t & h, char const * buffer, filesize_t len)
+{
+    data_failure f;
+    auto n = write_data(*h, h->pos, buffer, len, f);
+    h->pos += n;
+    return make_io_result(io_op_enum::write, n, f.ec);
+}
+
+template <>
+io_result file_provider_t::try_read_at (handle_t const & h, filesize_t offset, char * buffer
+    , filesize_t len)
+{
+    data_failure f;
+    auto n = read_data(*h, offset, buffer, len, f);
+    return make_io_result(io_op_enum::read_at, n, f.ec);
+}
+
+template <>
+io_result file_provider_t::try_write_at (handle_t & h, filesize_t offset, char const * buffer
+    , filesize_t len)
+{
+    data_failure f;
+    auto n = write_data(*h, offset, buffer, len, f);
+    return make_io_result(io_op_enum::write_at, n, f.ec);
+}
+
+template <>
+io_result file_provider_t::try_offset (handle_t const & h)
+{
+    return make_io_result(io_op_enum::offset, h->pos);
+}
+
+template <>
+io_result file_provider_t::try_set_pos (handle_t & h, filesize_t pos)
+{
+    if (h->writable && pos != h->size) {
+        return make_io_result(io_op_enum::set_pos, 0
+            , std::make_error_code(std::errc::operation_not_supported));
+    }
+
+    h->pos = pos;
+    return make_io_result(io_op_enum::set_pos, pos);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v_at (handle_t const & h, filesize_t offset
+    , io_buffer const * bufs, std::size_t count, error * perr)
+{
+    filesize_t total = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto res = read_at(h, offset + total, bufs[i].data, bufs[i].size, perr);
+
+        if (!res.second)
+            return res;
+
+        total += res.first;
+
+        if (res.first < bufs[i].size)
+            break;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v_at (handle_t & h, filesize_t offset
+    , const_io_buffer const * bufs, std::size_t count, error * perr)
+{
+    filesize_t total = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto res = write_at(h, offset + total, bufs[i].data, bufs[i].size, perr);
+
+        if (!res.second)
+            return total > 0 ? std::make_pair(total, true) : res;
+
+        total += res.first;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v (handle_t & h, io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+    auto res = read_v_at(h, h->pos, bufs, count, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v (handle_t & h, const_io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+    auto res = write_v_at(h, h->pos, bufs, count, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+bool file_provider_t::resize (handle_t & h, filesize_t size, preallocate_enum, error * perr)
+{
+    auto & c = *h;
+
+    if (!c.writable) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::bad_file_descriptor)
+            , tr::_("resize compressed file opened for reading"));
+        return false;
+    }
+
+    if (size == 0) {
+        c.frames.clear();
+        c.pending.clear();
+        c.size = 0;
+        c.data_end = 0;
+        c.pos = 0;
+        c.index_dirty = true;
+        return native_provider_t::resize(c.h, 0, preallocate_enum::off, perr);
+    }
+
+    if (size < c.size) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("shrink compressed file"));
+        return false;
+    }
+
+    // Extend by zeros
+    std::vector<char> zeros((std::min)(static_cast<filesize_t>(c.frame_size), size - c.size));
+
+    while (c.size < size) {
+        auto n = (std::min)(static_cast<filesize_t>(zeros.size()), size - c.size);
+
+        if (!write_at(h, c.size, zeros.data(), n, perr).second)
+            return false;
+    }
+
+    return true;
+}
+
+template <>
+bool file_provider_t::reserve (handle_t &, filesize_t, filesize_t, error *)
+{
+    // Compressed size is unknown in advance
+    return true;
+}
+
+template <>
+bool file_provider_t::punch_hole (handle_t &, filesize_t, filesize_t, error * perr)
+{
+    pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+        , tr::_("punch hole in compressed file"));
+    return false;
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , file_stat & st, error * perr)
+{
+    if (direct == direct_io_enum::on) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("direct I/O is not supported by compressed file"));
+        return nullptr;
+    }
+
+    std::unique_ptr<compressed_file_context> c {new compressed_file_context};
+    c->path = path;
+    c->h = native_provider_t::open_read_only(path.path, direct_io_enum::off, st, perr);
+
+    if (native_provider_t::is_invalid(c->h))
+        return nullptr;
+
+    if (!read_index(*c, c->h, st.size, perr))
+        return nullptr;
+
+    c->dctx = ZSTD_createDCtx();
+
+    if (c->dctx == nullptr) {
+        pfs::throw_or(perr, make_error_code(std::errc::not_enough_memory)
+            , tr::_("create decompression context"));
+        return nullptr;
+    }
+
+    c->in.resize(ZSTD_DStreamInSize());
+    c->out.resize(OUTPUT_CHUNK_SIZE);
+    c->frame_size = path.frame_size;
+
+    for (auto const & e: c->frames)
+        c->frame_size = (std::max)(c->frame_size, static_cast<std::size_t>(e.size));
+
+    st.size = c->size;
+    st.block_size = static_cast<std::uint32_t>((std::min)(c->frame_size, MAX_FRAME_SIZE));
+
+    return c.release();
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , error * perr)
+{
+    file_stat st;
+    return open_read_only(path, direct, st, perr);
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, error * perr)
+{
+    return open_read_only(path, direct_io_enum::off, perr);
+}
+
+template <>
+filesize_t file_provider_t::size (filepath_t const & path, error * perr)
+{
+    auto h = open_read_only(path, perr);
+
+    if (h == nullptr)
+        return 0;
+
+    auto result = h->size;
+    close(h);
+    return result;
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type, preallocate_enum, direct_io_enum direct, error * perr)
+{
+    if (direct == direct_io_enum::on) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("direct I/O is not supported by compressed file"));
+        return nullptr;
+    }
+
+    auto nh = native_provider_t::open_write_only(path.path, trunc, 0, perr);
+
+    if (native_provider_t::is_invalid(nh))
+        return nullptr;
+
+    std::unique_ptr<compressed_file_context> c {make_writer(nh, path, perr)};
+
+    if (!c) {
+        native_provider_t::close(nh);
+        return nullptr;
+    }
+
+    if (trunc == truncate_enum::off) {
+        // Continue existing file: load its index to append new frames after the last one
+        file_stat st;
+
+        if (!native_provider_t::stat(c->h, st, perr))
+            return nullptr;
+
+        if (st.size > 0) {
+            auto rh = native_provider_t::open_read_only(path.path, perr);
+
+            if (native_provider_t::is_invalid(rh))
+                return nullptr;
+
+            auto success = read_index(*c, rh, st.size, perr);
+            native_provider_t::close(rh);
+
+            if (!success)
+                return nullptr;
+
+            auto too_large = std::any_of(c->frames.cbegin(), c->frames.cend()
+                , [] (frame_entry const & e) {
+                    return e.size > (std::numeric_limits<std::uint32_t>::max)()
+                        || e.compressed_size > (std::numeric_limits<std::uint32_t>::max)();
+                });
+
+            if (too_large) {
+                pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+                    , tr::f_("append to compressed file with frames exceeding 4 GiB: {}"
+                        , pfs::utf8_encode_path(path.path)));
+                return nullptr;
+            }
+
+            // Seek table is cut off before appending new frames and rewritten on closing, so
+            // the file remains readable by scanning frame headers if writing is interrupted
+            if (c->data_end < st.size) {
+                if (!native_provider_t::resize(c->h, c->data_end, preallocate_enum::off, perr))
+                    return nullptr;
+
+                c->index_dirty = true;
+            }
+
+            c->pos = c->size;
+        }
+    }
+
+    return c.release();
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, direct_io_enum direct, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct, perr);
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct_io_enum::off, perr);
+}
+
+template <>
+std::size_t file_provider_t::direct_io_alignment (handle_t const &) noexcept
+{
+    return 1;
+}
+
+template <>
+bool file_provider_t::sync (handle_t & h, bool data_only, error * perr)
+{
+    if (!h->writable)
+        return true;
+
+    if (!write_index(*h, perr))
+        return false;
+
+    return native_provider_t::sync(h->h, data_only, perr);
+}
+
+template <>
+bool file_provider_t::sync_directory (filepath_t const & path, error * perr)
+{
+    return native_provider_t::sync_directory(path.path, perr);
+}
+
+template <>
+handle_t file_provider_t::open_temporary (filepath_t const & path, filepath_t & temp_path
+    , error * perr)
+{
+    fs::path native_temp_path;
+    auto nh = native_provider_t::open_temporary(path.path, native_temp_path, perr);
+
+    if (native_provider_t::is_invalid(nh))
+        return nullptr;
+
+    auto h = make_writer(nh, path, perr);
+
+    if (h == nullptr) {
+        native_provider_t::close(nh);
+        native_provider_t::remove(native_temp_path, nullptr);
+        return nullptr;
+    }
+
+    temp_path = filepath_t{native_temp_path, path.level, path.frame_size};
+    return h;
+}
+
+template <>
+bool file_provider_t::rename (filepath_t const & from, filepath_t const & to, error * perr)
+{
+    return native_provider_t::rename(from.path, to.path, perr);
+}
+
+template <>
+bool file_provider_t::remove (filepath_t const & path, error * perr)
+{
+    return native_provider_t::remove(path.path, perr);
+}
+
+template <>
+bool file_provider_t::advise (handle_t const & h, filesize_t offset, filesize_t len
+    , advice_enum advice, error * perr)
+{
+    if (h->writable)
+        return true;
+
+    auto region = compressed_region(*h, offset, len);
+    return region.second == 0
+        || native_provider_t::advise(h->h, region.first, region.second, advice, perr);
+}
+
+template <>
+bool file_provider_t::readahead (handle_t const & h, filesize_t offset, filesize_t len
+    , error * perr)
+{
+    if (h->writable)
+        return true;
+
+    auto region = compressed_region(*h, offset, len);
+    return region.second == 0
+        || native_provider_t::readahead(h->h, region.first, region.second, perr);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::copy (handle_t const & src, filesize_t offset
+    , handle_t & dst, filesize_t len, error * perr)
+{
+    static constexpr std::size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+    std::vector<char> buffer(static_cast<std::size_t>((std::min)(len, filesize_t{COPY_BUFFER_SIZE})));
+    filesize_t total = 0;
+
+    while (total < len) {
+        auto n = (std::min)(static_cast<filesize_t>(buffer.size()), len - total);
+        auto res = read_at(src, offset + total, buffer.data(), n, perr);
+
+        if (!res.second)
+            return res;
+
+        if (res.first == 0)
+            break;
+
+        auto wres = write(dst, buffer.data(), res.first, perr);
+
+        if (!wres.second)
+            return wres;
+
+        total += res.first;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+bool file_provider_t::clone (handle_t const &, handle_t &, error * perr)
+{
+    pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+        , tr::_("clone compressed file"));
+    return false;
+}
+
+template <>
+file_provider_t::mapped_view file_provider_t::map_read_only (handle_t const & h, filesize_t offset
+    , filesize_t len, advice_enum, error * perr)
+{
+    mapped_view view;
+
+    if (len == 0 || offset >= h->size)
+        return view;
+
+    // Region is decompressed into the heap buffer owned by the view
+    len = (std::min)(len, h->size - offset);
+    std::unique_ptr<char[]> data {new char[static_cast<std::size_t>(len)]};
+    auto res = read_at(h, offset, data.get(), len, perr);
+
+    if (!res.second)
+        return view;
+
+    view._base_size = static_cast<std::size_t>(len);
+    view._data = data.get();
+    view._size = static_cast<std::size_t>(res.first);
+    view._base = data.release();
+
+    return view;
+}
+
+template <>
+void file_provider_t::unmap (mapped_view & view) noexcept
+{
+    delete [] static_cast<char *>(view._base);
+
+    view._base = nullptr;
+    view._base_size = 0;
+    view._data = nullptr;
+    view._size = 0;
+}
+
+} // namespace ionik
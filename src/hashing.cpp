@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/ionik/hashing.hpp"
+#include <cstring>
+#include <new>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define IONIK__CRC32C_X86 1
+#   include <nmmintrin.h>
+#   if _MSC_VER
+#       include <intrin.h>
+#   endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(__ARM_FEATURE_CRC32)
+#   define IONIK__CRC32C_ARM 1
+#   include <arm_acle.h>
+#endif
+
+#if IONIK__HAS_XXHASH
+#   define XXH_INLINE_ALL
+#   include <xxhash.h>
+#endif
+
+namespace ionik {
+
+using crc32c_fn = std::uint32_t (*) (std::uint32_t, unsigned char const *, std::size_t);
+
+// Castagnoli polynomial (reversed)
+static constexpr std::uint32_t CRC32C_POLY = 0x82F63B78;
+
+static std::uint32_t crc32c_sw (std::uint32_t crc, unsigned char const * p, std::size_t len)
+{
+    // Slicing-by-8: table[k][i] is CRC of byte i followed by k zero bytes
+    static struct crc_tables
+    {
+        std::uint32_t values[8][256];
+
+        crc_tables ()
+        {
+            for (std::uint32_t i = 0; i < 256; i++) {
+                auto crc = i;
+
+                for (int k = 0; k < 8; k++)
+                    crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+
+                values[0][i] = crc;
+            }
+
+            for (std::uint32_t i = 0; i < 256; i++) {
+                for (int k = 1; k < 8; k++)
+                    values[k][i] = (values[k - 1][i] >> 8) ^ values[0][values[k - 1][i] & 0xFF];
+            }
+        }
+    } const tables;
+
+    auto const & t = tables.values;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        auto lo = crc ^ (static_cast<std::uint32_t>(p[0])
+            | static_cast<std::uint32_t>(p[1]) << 8
+            | static_cast<std::uint32_t>(p[2]) << 16
+            | static_cast<std::uint32_t>(p[3]) << 24);
+
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+            ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+
+    for (; len > 0; p++, len--)
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+
+    return crc;
+}
+
+#if IONIK__CRC32C_X86
+#   if !_MSC_VER
+__attribute__((target("sse4.2")))
+#   endif
+static std::uint32_t crc32c_hw (std::uint32_t crc, unsigned char const * p, std::size_t len)
+{
+    for (; len > 0 && (reinterpret_cast<std::uintptr_t>(p) & 7) != 0; p++, len--)
+        crc = _mm_crc32_u8(crc, *p);
+
+#   if defined(__x86_64__) || defined(_M_X64)
+    std::uint64_t crc64 = crc;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        std::uint64_t v;
+        std::memcpy(& v, p, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+
+    crc = static_cast<std::uint32_t>(crc64);
+#   else
+    for (; len >= 4; p += 4, len -= 4) {
+        std::uint32_t v;
+        std::memcpy(& v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+#   endif
+
+    for (; len > 0; p++, len--)
+        crc = _mm_crc32_u8(crc, *p);
+
+    return crc;
+}
+
+static bool crc32c_hw_supported () noexcept
+{
+#   if _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0; // SSE4.2
+#   else
+    return __builtin_cpu_supports("sse4.2");
+#   endif
+}
+#elif IONIK__CRC32C_ARM
+static std::uint32_t crc32c_hw (std::uint32_t crc, unsigned char const * p, std::size_t len)
+{
+    for (; len >= 8; p += 8, len -= 8) {
+        std::uint64_t v;
+        std::memcpy(& v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+
+    for (; len > 0; p++, len--)
+        crc = __crc32cb(crc, *p);
+
+    return crc;
+}
+
+// CRC32 extension is mandatory if the compiler targets it
+static bool crc32c_hw_supported () noexcept
+{
+    return true;
+}
+#endif
+
+static crc32c_fn select_crc32c () noexcept
+{
+#if IONIK__CRC32C_X86 || IONIK__CRC32C_ARM
+    if (crc32c_hw_supported())
+        return crc32c_hw;
+#endif
+
+    return crc32c_sw;
+}
+
+std::uint32_t crc32c_update (std::uint32_t crc, void const * data, std::size_t len) noexcept
+{
+    static crc32c_fn const impl = select_crc32c();
+    return ~impl(~crc, static_cast<unsigned char const *>(data), len);
+}
+
+bool crc32c_hardware () noexcept
+{
+    return select_crc32c() != crc32c_sw;
+}
+
+#if IONIK__HAS_XXHASH
+xxh3_64::xxh3_64 ()
+    : _state(XXH3_createState())
+{
+    if (_state == nullptr)
+        throw std::bad_alloc{};
+
+    reset();
+}
+
+xxh3_64::~xxh3_64 ()
+{
+    if (_state != nullptr)
+        XXH3_freeState(static_cast<XXH3_state_t *>(_state));
+}
+
+void xxh3_64::update (char const * data, std::size_t len) noexcept
+{
+    if (_state != nullptr)
+        XXH3_64bits_update(static_cast<XXH3_state_t *>(_state), data, len);
+}
+
+xxh3_64::digest_type xxh3_64::digest () const noexcept
+{
+    if (_state == nullptr)
+        return XXH3_64bits(nullptr, 0);
+
+    return XXH3_64bits_digest(static_cast<XXH3_state_t const *>(_state));
+}
+
+void xxh3_64::reset () noexcept
+{
+    if (_state != nullptr)
+        XXH3_64bits_reset(static_cast<XXH3_state_t *>(_state));
+}
+
+xxh3_64::digest_type xxh3_64::compute (char const * data, std::size_t len) noexcept
+{
+    return XXH3_64bits(data, len);
+}
+#endif
+
+} // namespace ionik
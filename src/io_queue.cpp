@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "io_queue_rep.hpp"
+#include <pfs/i18n.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ionik {
+
+class thread_pool_queue: public io_queue_rep
+{
+    std::size_t _queue_depth {0};
+    std::vector<io_request> _prepared;
+    std::vector<io_queue::handle_type> _files;
+    std::vector<io_buffer> _buffers;
+
+    std::mutex _mtx;
+    std::condition_variable _submitted_cond;
+    std::condition_variable _completed_cond;
+    std::deque<io_request> _submitted;
+    std::deque<io_completion> _completed;
+    std::size_t _inflight {0}; // Submitted but not reaped requests
+    bool _stopped {false};
+
+    std::vector<std::thread> _workers;
+
+public:
+    thread_pool_queue (std::size_t queue_depth, std::size_t thread_count)
+        : _queue_depth(queue_depth)
+    {
+        if (thread_count == 0)
+            thread_count = (std::max)(1U, std::thread::hardware_concurrency());
+
+        _prepared.reserve(queue_depth);
+
+        for (std::size_t i = 0; i < thread_count; i++)
+            _workers.emplace_back(& thread_pool_queue::run, this);
+    }
+
+    ~thread_pool_queue ()
+    {
+        {
+            std::unique_lock<std::mutex> locker{_mtx};
+            _stopped = true;
+        }
+
+        _submitted_cond.notify_all();
+
+        for (auto & w: _workers)
+            w.join();
+    }
+
+    io_queue::backend_enum backend () const noexcept override
+    {
+        return io_queue::backend_enum::thread_pool;
+    }
+
+    bool prepare (io_request const & req) override
+    {
+        if (_prepared.size() >= _queue_depth)
+            return false;
+
+        if (req.fixed) {
+            if (static_cast<std::size_t>(req.h) >= _files.size() || req.buffer_index >= _buffers.size())
+                return false;
+
+            auto const & buf = _buffers[req.buffer_index];
+
+            if (req.buffer < buf.data || req.buffer + req.len > buf.data + buf.size)
+                return false;
+
+            auto r = req;
+            r.h = _files[static_cast<std::size_t>(req.h)];
+            _prepared.push_back(r);
+        } else {
+            _prepared.push_back(req);
+        }
+
+        return true;
+    }
+
+    std::size_t submit (error *) override
+    {
+        auto n = _prepared.size();
+
+        if (n == 0)
+            return 0;
+
+        {
+            std::unique_lock<std::mutex> locker{_mtx};
+            _submitted.insert(_submitted.end(), _prepared.begin(), _prepared.end());
+            _inflight += n;
+        }
+
+        _prepared.clear();
+        _submitted_cond.notify_all();
+
+        return n;
+    }
+
+    std::size_t poll (io_completion * completions, std::size_t max_count) override
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+        return reap(completions, max_count);
+    }
+
+    std::size_t wait (io_completion * completions, std::size_t max_count, std::size_t min_count
+        , error *) override
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+
+        min_count = (std::min)(min_count, (std::min)(max_count, _inflight));
+
+        _completed_cond.wait(locker, [this, min_count] {
+            return _completed.size() >= min_count;
+        });
+
+        return reap(completions, max_count);
+    }
+
+    bool register_buffers (io_buffer const * bufs, std::size_t count, error *) override
+    {
+        _buffers.assign(bufs, bufs + count);
+        return true;
+    }
+
+    bool register_files (io_queue::handle_type const * files, std::size_t count, error *) override
+    {
+        _files.assign(files, files + count);
+        return true;
+    }
+
+private:
+    // Must be called under lock
+    std::size_t reap (io_completion * completions, std::size_t max_count)
+    {
+        auto n = (std::min)(max_count, _completed.size());
+
+        std::copy(_completed.begin(), _completed.begin() + n, completions);
+        _completed.erase(_completed.begin(), _completed.begin() + n);
+        _inflight -= n;
+
+        return n;
+    }
+
+    void run ()
+    {
+        for (;;) {
+            io_request req;
+
+            {
+                std::unique_lock<std::mutex> locker{_mtx};
+
+                _submitted_cond.wait(locker, [this] {
+                    return _stopped || !_submitted.empty();
+                });
+
+                if (_stopped)
+                    return;
+
+                req = _submitted.front();
+                _submitted.pop_front();
+            }
+
+            error err;
+            auto res = req.is_write
+                ? local_file_provider::write_at(req.h, req.offset, req.buffer, req.len, & err)
+                : local_file_provider::read_at(req.h, req.offset, req.buffer, req.len, & err);
+
+            io_completion c {req.user_data, res.second
+                ? static_cast<std::int64_t>(res.first)
+                : -static_cast<std::int64_t>(err.code().value())};
+
+            {
+                std::unique_lock<std::mutex> locker{_mtx};
+                _completed.push_back(c);
+            }
+
+            _completed_cond.notify_all();
+        }
+    }
+};
+
+io_queue_rep * make_thread_pool_queue (std::size_t queue_depth, std::size_t thread_count)
+{
+    return new thread_pool_queue(queue_depth, thread_count);
+}
+
+#if !IONIK__HAS_IO_URING
+io_queue_rep * make_io_uring_queue (std::size_t, error *)
+{
+    return nullptr;
+}
+#endif
+
+io_queue::io_queue (std::size_t queue_depth, std::size_t thread_count, error * perr)
+{
+    error err;
+    _rep = make_io_uring_queue(queue_depth, & err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    if (_rep == nullptr)
+        _rep = make_thread_pool_queue(queue_depth, thread_count);
+}
+
+io_queue::io_queue (std::size_t queue_depth, backend_enum backend, std::size_t thread_count
+    , error * perr)
+{
+    if (backend == backend_enum::thread_pool) {
+        _rep = make_thread_pool_queue(queue_depth, thread_count);
+        return;
+    }
+
+    error err;
+    _rep = make_io_uring_queue(queue_depth, & err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    if (_rep == nullptr) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("io_uring is not supported"));
+    }
+}
+
+io_queue::~io_queue ()
+{
+    delete _rep;
+}
+
+io_queue::backend_enum io_queue::backend () const noexcept
+{
+    return _rep != nullptr ? _rep->backend() : backend_enum::thread_pool;
+}
+
+bool io_queue::prepare_read (handle_type h, filesize_t offset, char * buffer
+    , std::size_t len, std::uint64_t user_data)
+{
+    return _rep != nullptr
+        && _rep->prepare(io_request{false, false, h, offset, buffer, len, 0, user_data});
+}
+
+bool io_queue::prepare_write (handle_type h, filesize_t offset, char const * buffer
+    , std::size_t len, std::uint64_t user_data)
+{
+    return _rep != nullptr
+        && _rep->prepare(io_request{true, false, h, offset, const_cast<char *>(buffer), len, 0, user_data});
+}
+
+bool io_queue::prepare_read_fixed (std::size_t file_index, filesize_t offset
+    , std::size_t buffer_index, char * buffer, std::size_t len, std::uint64_t user_data)
+{
+    return _rep != nullptr
+        && _rep->prepare(io_request{false, true, static_cast<handle_type>(file_index), offset
+            , buffer, len, buffer_index, user_data});
+}
+
+bool io_queue::prepare_write_fixed (std::size_t file_index, filesize_t offset
+    , std::size_t buffer_index, char const * buffer, std::size_t len, std::uint64_t user_data)
+{
+    return _rep != nullptr
+        && _rep->prepare(io_request{true, true, static_cast<handle_type>(file_index), offset
+            , const_cast<char *>(buffer), len, buffer_index, user_data});
+}
+
+std::size_t io_queue::submit (error * perr)
+{
+    return _rep != nullptr ? _rep->submit(perr) : 0;
+}
+
+std::size_t io_queue::poll (io_completion * completions, std::size_t max_count)
+{
+    return _rep != nullptr ? _rep->poll(completions, max_count) : 0;
+}
+
+std::size_t io_queue::wait (io_completion * completions, std::size_t max_count
+    , std::size_t min_count, error * perr)
+{
+    return _rep != nullptr ? _rep->wait(completions, max_count, min_count, perr) : 0;
+}
+
+bool io_queue::register_buffers (io_buffer const * bufs, std::size_t count, error * perr)
+{
+    return _rep != nullptr && _rep->register_buffers(bufs, count, perr);
+}
+
+bool io_queue::register_files (handle_type const * files, std::size_t count, error * perr)
+{
+    return _rep != nullptr && _rep->register_files(files, count, perr);
+}
+
+} // namespace ionik
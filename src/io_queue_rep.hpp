@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "ionik/io_queue.hpp"
+
+namespace ionik {
+
+struct io_request
+{
+    bool is_write;
+    bool fixed;
+    io_queue::handle_type h; // File handle or index of the registered file
+    filesize_t offset;
+    char * buffer;
+    std::size_t len;
+    std::size_t buffer_index;
+    std::uint64_t user_data;
+};
+
+struct io_queue_rep
+{
+    virtual ~io_queue_rep () = default;
+
+    virtual io_queue::backend_enum backend () const noexcept = 0;
+    virtual bool prepare (io_request const & req) = 0;
+    virtual std::size_t submit (error * perr) = 0;
+    virtual std::size_t poll (io_completion * completions, std::size_t max_count) = 0;
+    virtual std::size_t wait (io_completion * completions, std::size_t max_count
+        , std::size_t min_count, error * perr) = 0;
+    virtual bool register_buffers (io_buffer const * bufs, std::size_t count, error * perr) = 0;
+    virtual bool register_files (io_queue::handle_type const * files, std::size_t count
+        , error * perr) = 0;
+};
+
+/**
+ * @return io_uring based queue or @c nullptr if io_uring is not supported by the kernel.
+ */
+io_queue_rep * make_io_uring_queue (std::size_t queue_depth, error * perr);
+
+io_queue_rep * make_thread_pool_queue (std::size_t queue_depth, std::size_t thread_count);
+
+} // namespace ionik
@@ -0,0 +1,368 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//
+// Sources:
+//      1. [io_uring(7)](https://man7.org/linux/man-pages/man7/io_uring.7.html)
+//      2. [Efficient IO with io_uring](https://kernel.dk/io_uring.pdf)
+////////////////////////////////////////////////////////////////////////////////
+#include "io_queue_rep.hpp"
+#include <pfs/i18n.hpp>
+#include <pfs/numeric_cast.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ionik {
+
+// liburing is not required, io_uring is used through raw system calls.
+
+static int io_uring_setup (unsigned entries, io_uring_params * p)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int io_uring_enter (int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags
+        , nullptr, 0));
+}
+
+static int io_uring_register (int fd, unsigned opcode, void const * arg, unsigned nr_args)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+class io_uring_queue: public io_queue_rep
+{
+    int _fd {-1};
+
+    void * _sq_ptr {MAP_FAILED};
+    std::size_t _sq_size {0};
+    void * _cq_ptr {MAP_FAILED};
+    std::size_t _cq_size {0};
+    io_uring_sqe * _sqes {nullptr};
+    std::size_t _sqes_size {0};
+
+    unsigned * _sq_head {nullptr};
+    unsigned * _sq_tail {nullptr};
+    unsigned * _sq_array {nullptr};
+    unsigned _sq_mask {0};
+    unsigned _sq_entries {0};
+
+    unsigned * _cq_head {nullptr};
+    unsigned * _cq_tail {nullptr};
+    io_uring_cqe * _cqes {nullptr};
+    unsigned _cq_mask {0};
+
+    std::size_t _file_count {0};      // Number of registered files
+    std::vector<io_buffer> _buffers;  // Registered buffers
+
+    unsigned _sq_local_tail {0}; // Tail including prepared but not published entries
+    unsigned _to_submit {0};     // Published but not consumed by the kernel entries
+    std::size_t _inflight {0};   // Submitted but not reaped requests
+
+public:
+    io_uring_queue () = default;
+
+    ~io_uring_queue ()
+    {
+        if (_sqes != nullptr)
+            ::munmap(_sqes, _sqes_size);
+
+        if (_cq_ptr != MAP_FAILED && _cq_ptr != _sq_ptr)
+            ::munmap(_cq_ptr, _cq_size);
+
+        if (_sq_ptr != MAP_FAILED)
+            ::munmap(_sq_ptr, _sq_size);
+
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+
+    /**
+     * @return @c false if io_uring is not supported (@a perr is not set) or on failure.
+     */
+    bool init (std::size_t queue_depth, error * perr)
+    {
+        io_uring_params p;
+        std::memset(& p, 0, sizeof(p));
+
+        _fd = io_uring_setup(pfs::numeric_cast<unsigned>(queue_depth), & p);
+
+        if (_fd < 0) {
+            // Not supported by the kernel or disabled by administrator (see
+            // /proc/sys/kernel/io_uring_disabled) or by seccomp policy, rings can not be
+            // allocated (RLIMIT_MEMLOCK on kernels before 5.12) or parameters are not
+            // supported by the old kernel.
+            if (errno == ENOSYS || errno == EPERM || errno == EACCES || errno == ENOMEM
+                    || errno == EINVAL) {
+                return false;
+            }
+
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring setup"));
+            return false;
+        }
+
+        if (!probe())
+            return false;
+
+        _sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        _cq_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+            _sq_size = _cq_size = (std::max)(_sq_size, _cq_size);
+
+        _sq_ptr = ::mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+            , _fd, IORING_OFF_SQ_RING);
+
+        if (_sq_ptr == MAP_FAILED) {
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring submission queue mapping"));
+            return false;
+        }
+
+        if (p.features & IORING_FEAT_SINGLE_MMAP) {
+            _cq_ptr = _sq_ptr;
+        } else {
+            _cq_ptr = ::mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+                , _fd, IORING_OFF_CQ_RING);
+
+            if (_cq_ptr == MAP_FAILED) {
+                pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring completion queue mapping"));
+                return false;
+            }
+        }
+
+        _sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+        auto sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE
+            , _fd, IORING_OFF_SQES);
+
+        if (sqes == MAP_FAILED) {
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring submission entries mapping"));
+            return false;
+        }
+
+        _sqes = static_cast<io_uring_sqe *>(sqes);
+
+        auto sq = static_cast<char *>(_sq_ptr);
+        _sq_head    = reinterpret_cast<unsigned *>(sq + p.sq_off.head);
+        _sq_tail    = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+        _sq_array   = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+        _sq_mask    = *reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+        _sq_entries = *reinterpret_cast<unsigned *>(sq + p.sq_off.ring_entries);
+
+        auto cq = static_cast<char *>(_cq_ptr);
+        _cq_head = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+        _cq_tail = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+        _cqes    = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+        _cq_mask = *reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+
+        _sq_local_tail = *_sq_tail;
+
+        return true;
+    }
+
+    io_queue::backend_enum backend () const noexcept override
+    {
+        return io_queue::backend_enum::io_uring;
+    }
+
+    bool prepare (io_request const & req) override
+    {
+        if (req.fixed) {
+            if (static_cast<std::size_t>(req.h) >= _file_count || req.buffer_index >= _buffers.size())
+                return false;
+
+            auto const & buf = _buffers[req.buffer_index];
+
+            if (req.buffer < buf.data || req.buffer + req.len > buf.data + buf.size)
+                return false;
+        }
+
+        auto head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+
+        if (_sq_local_tail - head >= _sq_entries)
+            return false;
+
+        auto index = _sq_local_tail & _sq_mask;
+        auto sqe = & _sqes[index];
+
+        std::memset(sqe, 0, sizeof(*sqe));
+
+        if (req.fixed) {
+            sqe->opcode = req.is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->flags = IOSQE_FIXED_FILE;
+            sqe->buf_index = pfs::numeric_cast<decltype(sqe->buf_index)>(req.buffer_index);
+        } else {
+            sqe->opcode = req.is_write ? IORING_OP_WRITE : IORING_OP_READ;
+        }
+
+        sqe->fd = req.h;
+        sqe->off = req.offset;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(req.buffer);
+        sqe->len = pfs::numeric_cast<std::uint32_t>(req.len);
+        sqe->user_data = req.user_data;
+
+        _sq_array[index] = index;
+        _sq_local_tail++;
+
+        return true;
+    }
+
+    std::size_t submit (error * perr) override
+    {
+        auto tail = __atomic_load_n(_sq_tail, __ATOMIC_RELAXED);
+
+        _to_submit += _sq_local_tail - tail;
+        __atomic_store_n(_sq_tail, _sq_local_tail, __ATOMIC_RELEASE);
+
+        if (_to_submit == 0)
+            return 0;
+
+        int n = 0;
+
+        do {
+            n = io_uring_enter(_fd, _to_submit, 0, 0);
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) {
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring submit"));
+            return 0;
+        }
+
+        _to_submit -= static_cast<unsigned>(n);
+        _inflight += static_cast<std::size_t>(n);
+
+        return static_cast<std::size_t>(n);
+    }
+
+    std::size_t poll (io_completion * completions, std::size_t max_count) override
+    {
+        auto head = *_cq_head;
+        auto tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        std::size_t n = 0;
+
+        for (; head != tail && n < max_count; head++, n++) {
+            auto const & cqe = _cqes[head & _cq_mask];
+            completions[n].user_data = cqe.user_data;
+            completions[n].result = cqe.res;
+        }
+
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        _inflight -= n;
+
+        return n;
+    }
+
+    std::size_t wait (io_completion * completions, std::size_t max_count, std::size_t min_count
+        , error * perr) override
+    {
+        min_count = (std::min)(min_count, max_count);
+        auto n = poll(completions, max_count);
+
+        while (n < min_count && _inflight > 0) {
+            auto need = (std::min)(min_count - n, _inflight);
+            auto rc = io_uring_enter(_fd, 0, pfs::numeric_cast<unsigned>(need), IORING_ENTER_GETEVENTS);
+
+            if (rc < 0 && errno != EINTR) {
+                pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring wait completions"));
+                break;
+            }
+
+            n += poll(completions + n, max_count - n);
+        }
+
+        return n;
+    }
+
+    bool register_buffers (io_buffer const * bufs, std::size_t count, error * perr) override
+    {
+        std::vector<iovec> iov(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            iov[i].iov_base = bufs[i].data;
+            iov[i].iov_len = bufs[i].size;
+        }
+
+        // Ignore error (no buffers registered yet)
+        (void)io_uring_register(_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        _buffers.clear();
+
+        if (count == 0)
+            return true;
+
+        if (io_uring_register(_fd, IORING_REGISTER_BUFFERS, iov.data()
+                , pfs::numeric_cast<unsigned>(count)) < 0) {
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring register buffers"));
+            return false;
+        }
+
+        _buffers.assign(bufs, bufs + count);
+        return true;
+    }
+
+    bool register_files (io_queue::handle_type const * files, std::size_t count, error * perr) override
+    {
+        // Ignore error (no files registered yet)
+        (void)io_uring_register(_fd, IORING_UNREGISTER_FILES, nullptr, 0);
+        _file_count = 0;
+
+        if (count == 0)
+            return true;
+
+        if (io_uring_register(_fd, IORING_REGISTER_FILES, files, pfs::numeric_cast<unsigned>(count)) < 0) {
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("io_uring register files"));
+            return false;
+        }
+
+        _file_count = count;
+        return true;
+    }
+
+private:
+    /**
+     * Checks support of the used operations (IORING_OP_READ and IORING_OP_WRITE are available
+     * since Linux 5.6, as well as probing itself).
+     */
+    bool probe ()
+    {
+        static constexpr unsigned PROBE_OPS_COUNT = 256;
+
+        std::vector<char> buffer(sizeof(io_uring_probe) + PROBE_OPS_COUNT * sizeof(io_uring_probe_op), 0);
+        auto p = reinterpret_cast<io_uring_probe *>(buffer.data());
+
+        if (io_uring_register(_fd, IORING_REGISTER_PROBE, p, PROBE_OPS_COUNT) < 0)
+            return false;
+
+        for (auto op: {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED}) {
+            if (op > p->last_op || !(p->ops[op].flags & IO_URING_OP_SUPPORTED))
+                return false;
+        }
+
+        return true;
+    }
+};
+
+io_queue_rep * make_io_uring_queue (std::size_t queue_depth, error * perr)
+{
+    auto q = new io_uring_queue;
+
+    if (!q->init(queue_depth, perr)) {
+        delete q;
+        return nullptr;
+    }
+
+    return q;
+}
+
+} // namespace ionik
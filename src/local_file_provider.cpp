@@ -5,19 +5,39 @@
 //
 // Changelog:
 //      2023.03.27 Initial version.
+//      2026.10.15 Added memory-mapped read-only view.
+//      2026.10.15 Added positional read/write.
+//      2026.10.15 Added scatter/gather (vectored) read/write.
+//      2026.10.15 Added direct I/O mode.
+//      2026.10.15 Added preallocation and punching holes.
+//      2026.10.15 Added kernel-side copy.
+//      2026.10.15 Added synchronization and primitives for atomic rewrite.
+//      2026.10.15 Added access pattern advice and readahead.
+//      2026.10.15 `open_read_only()` opens file first and obtains metadata from the handle.
+//      2026.10.15 Added access to files relative to the opened directory.
+//      2026.10.15 Hot I/O calls are implemented by non-throwing `try_*` functions.
 ////////////////////////////////////////////////////////////////////////////////
 #include "pfs/i18n.hpp"
 #include "pfs/filesystem.hpp"
 #include "pfs/numeric_cast.hpp"
 #include "pfs/ionik/error.hpp"
 #include "pfs/ionik/file_provider.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
 
 #if _MSC_VER
+#   include <windows.h>
+#   include <winioctl.h>
 #   include <sys/types.h>
 #   include <sys/stat.h>
 #   include <fcntl.h>
 #   include <io.h>
+#   include <process.h>
 
 #   ifndef S_IRUSR
 #       define S_IRUSR _S_IREAD
@@ -27,9 +47,24 @@
 #       define S_IWUSR _S_IWRITE
 #   endif
 #else // _MSC_VER
+#   include <sys/mman.h>
+#   include <sys/stat.h>
 #   include <sys/types.h>
+#   include <sys/uio.h>
 #   include <fcntl.h>
+#   include <limits.h>
 #   include <unistd.h>
+
+#   if defined(__linux__) && (!defined(__ANDROID__) || __ANDROID_API__ >= 24)
+#       define IONIK__HAS_PREADV 1
+#   endif
+
+#   if defined(__linux__)
+#       include <linux/fs.h>
+#       include <sys/ioctl.h>
+#       include <sys/sendfile.h>
+#       include <sys/syscall.h>
+#   endif
 #endif // !_MSC_VER
 
 namespace ionik {
@@ -43,6 +78,82 @@ using filepath_t = file_provider_t::filepath_type;
 using filesize_t = file_provider_t::filesize_type;
 using handle_t = file_provider_t::handle_type;
 
+#if !_MSC_VER
+/**
+ * Converts buffer descriptors into `iovec` array avoiding heap allocation for small number of
+ * buffers. Number of buffers is limited by IOV_MAX.
+ */
+class iovec_array
+{
+    static constexpr std::size_t IOV_STACK_SIZE = 16;
+
+#   ifdef IOV_MAX
+    static constexpr std::size_t IOV_MAX_SIZE = IOV_MAX;
+#   else
+    static constexpr std::size_t IOV_MAX_SIZE = 1024;
+#   endif
+
+    iovec _stack[IOV_STACK_SIZE];
+    std::vector<iovec> _heap;
+    iovec * _data {_stack};
+    int _count {0};
+
+public:
+    template <typename Buffer>
+    iovec_array (Buffer const * bufs, std::size_t count)
+    {
+        count = (std::min)(count, std::size_t{IOV_MAX_SIZE});
+
+        if (count > IOV_STACK_SIZE) {
+            _heap.resize(count);
+            _data = _heap.data();
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            _data[i].iov_base = const_cast<char *>(bufs[i].data);
+            _data[i].iov_len = bufs[i].size;
+        }
+
+        _count = static_cast<int>(count);
+    }
+
+    iovec const * data () const noexcept
+    {
+        return _data;
+    }
+
+    int size () const noexcept
+    {
+        return _count;
+    }
+};
+#endif
+
+#if _MSC_VER || !IONIK__HAS_PREADV
+/**
+ * Emulates vectored I/O by sequence of calls of @a f for each buffer. Stops on partial transfer.
+ */
+template <typename Buffer, typename F>
+static std::pair<filesize_t, bool> for_each_buffer (Buffer const * bufs, std::size_t count, F && f)
+{
+    filesize_t total = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto res = f(bufs[i], total);
+
+        if (!res.second)
+            return std::make_pair(0, false);
+
+        total += res.first;
+
+        if (res.first < bufs[i].size)
+            break;
+    }
+
+    return std::make_pair(total, true);
+}
+#endif
+
 template <>
 handle_t file_provider_t::invalid () noexcept
 {
@@ -77,183 +188,1338 @@ void file_provider_t::close (handle_t & h)
 #endif
 }
 
-template <>
-handle_t file_provider_t::open_read_only (filepath_t const & path, error * perr)
+/**
+ * Opens file with @a oflags, in direct I/O mode if @a direct is on.
+ *
+ * @return File handle or negative value on error (error code can be obtained by
+ *         `pfs::get_last_system_error()`).
+ */
+static handle_t open_native (filepath_t const & path, int oflags, direct_io_enum direct)
 {
-    if (!fs::exists(path)) {
-        pfs::throw_or(perr
-            , make_error_code(std::errc::no_such_file_or_directory)
-            , pfs::utf8_encode_path(path));
-        return INVALID_FILE_HANDLE;
-    }
-
-    if (!fs::is_regular_file(path)) {
-        if (fs::is_symlink(path)) {
-            std::error_code ec;
-            fs::path tmp {path};
+#if _MSC_VER
+    if (direct == direct_io_enum::on) {
+        // No way to pass FILE_FLAG_NO_BUFFERING to _wsopen_s()
+        bool write_only = (oflags & O_WRONLY) != 0;
+        DWORD disposition = (oflags & O_CREAT)
+            ? ((oflags & O_TRUNC) ? CREATE_ALWAYS : OPEN_ALWAYS)
+            : OPEN_EXISTING;
 
-            while (!ec && fs::is_symlink(tmp))
-                tmp = fs::read_symlink(tmp, ec);
+        HANDLE hh = CreateFileW(path.c_str()
+            , write_only ? GENERIC_WRITE : GENERIC_READ
+            , write_only ? FILE_SHARE_READ : FILE_SHARE_READ | FILE_SHARE_WRITE
+            , NULL, disposition, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, NULL);
 
-            if (ec) {
-                pfs::throw_or(perr, ec, tr::f_("open read only failure: {}", pfs::utf8_encode_path(path)));
-                return INVALID_FILE_HANDLE;
-            }
-        }  else {
-            pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
-                , tr::f_("expected regular file: {}", pfs::utf8_encode_path(path)));
+        if (hh == INVALID_HANDLE_VALUE)
             return INVALID_FILE_HANDLE;
-        }
+
+        handle_t h = _open_osfhandle(reinterpret_cast<intptr_t>(hh)
+            , (write_only ? _O_WRONLY : _O_RDONLY) | _O_BINARY);
+
+        if (h < 0)
+            CloseHandle(hh);
+
+        return h;
     }
 
-#   if _MSC_VER
     handle_t h;
-    // _sopen_s(& h, fs::utf8_encode(path).c_str(), O_RDONLY, _SH_DENYNO, 0);
-    _wsopen_s(& h, path.c_str(), O_RDONLY | O_BINARY, _SH_DENYNO, 0);
-#   else
-    handle_t h = ::open(pfs::utf8_encode_path(path).c_str(), O_RDONLY);
+
+    if (oflags & O_WRONLY) {
+        // _sopen_s(& h, fs::utf8_encode(path).c_str(), oflags, _SH_DENYWR, S_IRUSR | S_IWUSR);
+        _wsopen_s(& h, path.c_str(), oflags | O_BINARY, _SH_DENYWR, S_IRUSR | S_IWUSR);
+    } else {
+        // _sopen_s(& h, fs::utf8_encode(path).c_str(), O_RDONLY, _SH_DENYNO, 0);
+        _wsopen_s(& h, path.c_str(), oflags | O_BINARY, _SH_DENYNO, 0);
+    }
+
+    return h;
+#else
+#   if defined(O_DIRECT)
+    if (direct == direct_io_enum::on)
+        oflags |= O_DIRECT;
+#   elif !defined(F_NOCACHE)
+    if (direct == direct_io_enum::on) {
+        errno = ENOTSUP;
+        return INVALID_FILE_HANDLE;
+    }
 #   endif
 
-    if (h < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::f_("open read only file: {}", path));
+    handle_t h = ::open(pfs::utf8_encode_path(path).c_str(), oflags, S_IRUSR | S_IWUSR);
+
+#   if !defined(O_DIRECT) && defined(F_NOCACHE)
+    // macOS
+    if (h >= 0 && direct == direct_io_enum::on && ::fcntl(h, F_NOCACHE, 1) < 0) {
+        auto errn = errno;
+        ::close(h);
+        errno = errn;
         return INVALID_FILE_HANDLE;
     }
+#   endif
 
     return h;
+#endif
 }
 
-template <>
-handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
-    , filesize_type initial_size, error * perr)
+#if _MSC_VER
+/**
+ * Converts metadata of the file opened by native handle @a hh.
+ *
+ * @return @c false on failure (error code can be obtained by `pfs::get_last_system_error()`).
+ */
+static bool native_info (HANDLE hh, file_stat & st, bool & is_regular)
 {
-    int oflags = O_WRONLY | O_CREAT;
+    BY_HANDLE_FILE_INFORMATION info;
 
-    if (trunc == truncate_enum::on && initial_size == 0)
-        oflags |= O_TRUNC;
+    if (!GetFileInformationByHandle(hh, & info))
+        return false;
+
+    // FILETIME is a number of 100-nanosecond intervals since January 1, 1601
+    static constexpr std::int64_t EPOCH_DIFF = 116444736000000000LL;
+    auto ticks = (static_cast<std::int64_t>(info.ftLastWriteTime.dwHighDateTime) << 32)
+        | info.ftLastWriteTime.dwLowDateTime;
+
+    st.size = (static_cast<filesize_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    st.mtime = std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds{(ticks - EPOCH_DIFF) * 100})};
+    st.inode = (static_cast<std::uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    st.block_size = 4096;
+    is_regular = !(info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        && GetFileType(hh) == FILE_TYPE_DISK;
+
+    return true;
+}
+#else
+static void convert_stat (struct stat const & native_st, file_stat & st, bool & is_regular)
+{
+#   if defined(__APPLE__)
+    auto const & mtim = native_st.st_mtimespec;
+#   else
+    auto const & mtim = native_st.st_mtim;
+#   endif
+
+    st.size = static_cast<filesize_t>(native_st.st_size);
+    st.mtime = std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::seconds{mtim.tv_sec} + std::chrono::nanoseconds{mtim.tv_nsec})};
+    st.inode = static_cast<std::uint64_t>(native_st.st_ino);
+    st.block_size = static_cast<std::uint32_t>(native_st.st_blksize);
+    is_regular = S_ISREG(native_st.st_mode);
+}
+#endif
 
+/**
+ * Obtains metadata of the opened file by single system call.
+ *
+ * @return @c false on failure (error code can be obtained by `pfs::get_last_system_error()`).
+ */
+static bool native_stat (handle_t h, file_stat & st, bool & is_regular)
+{
 #if _MSC_VER
-    oflags |= O_BINARY;
+    return native_info(reinterpret_cast<HANDLE>(_get_osfhandle(h)), st, is_regular);
+#else
+    struct stat native_st;
 
-    handle_t h;
-    // _sopen_s(& h, fs::utf8_encode(path).c_str(), oflags, _SH_DENYWR, S_IRUSR | S_IWUSR);
-    _wsopen_s(& h, path.c_str(), oflags, _SH_DENYWR, S_IRUSR | S_IWUSR);
+    if (::fstat(h, & native_st) != 0)
+        return false;
+
+    convert_stat(native_st, st, is_regular);
+    return true;
+#endif
+}
+
+template <>
+bool file_provider_t::stat (handle_t const & h, file_stat & st, error * perr)
+{
+    bool is_regular = false;
+
+    if (!native_stat(h, st, is_regular)) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("file stat"));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Checks file opened for reading is regular and obtains its metadata. Handle is closed on failure.
+ */
+static handle_t check_read_only (handle_t h, filepath_t const & path, file_stat & st, error * perr)
+{
+    bool is_regular = false;
+
+    if (!native_stat(h, st, is_regular)) {
+        auto ec = pfs::get_last_system_error();
+        file_provider_t::close(h);
+        pfs::throw_or(perr, ec, tr::f_("open read only file: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
+    }
+
+    if (!is_regular) {
+        file_provider_t::close(h);
+        pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
+            , tr::f_("expected regular file: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
+    }
+
+#if !_MSC_VER
+    // O_NONBLOCK is needed for opening only: io_uring and network/FUSE file systems respect it
+    // for regular files too (e.g. read returns EAGAIN on page cache miss).
+    auto flags = ::fcntl(h, F_GETFL);
+
+    if (flags < 0 || ::fcntl(h, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+        auto ec = pfs::get_last_system_error();
+        file_provider_t::close(h);
+        pfs::throw_or(perr, ec, tr::f_("open read only file: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
+    }
+#endif
+
+    return h;
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , file_stat & st, error * perr)
+{
+    // Open first and check the handle, so the path is looked up only once. O_NONBLOCK prevents
+    // blocking on FIFO opening, it is cleared by `check_read_only()` for regular files.
+#if _MSC_VER
+    handle_t h = open_native(path, O_RDONLY, direct);
 #else
-    handle_t h = ::open(pfs::utf8_encode_path(path).c_str(), oflags, S_IRUSR | S_IWUSR);
+    handle_t h = open_native(path, O_RDONLY | O_NONBLOCK, direct);
 #endif
 
     if (h < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::f_("open write only file failure: {}", path));
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::f_("open read only file: {}", path));
         return INVALID_FILE_HANDLE;
     }
 
-    if (trunc == truncate_enum::on && initial_size > 0) {
-        std::error_code ec;
+    return check_read_only(h, path, st, perr);
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , error * perr)
+{
+    file_stat st;
+    return open_read_only(path, direct, st, perr);
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, error * perr)
+{
+    return open_read_only(path, direct_io_enum::off, perr);
+}
 
 #if _MSC_VER
-        LARGE_INTEGER large_initial_size;
-        large_initial_size.QuadPart = static_cast<LONGLONG>(initial_size);
+/**
+ * Resolves @a path relative to the directory opened by `open_directory()`.
+ *
+ * @return @c false on failure (error code can be obtained by `pfs::get_last_system_error()`).
+ */
+static bool resolve_at (handle_t dir, filepath_t const & path, filepath_t & result)
+{
+    if (path.is_absolute()) {
+        result = path;
+        return true;
+    }
 
-        if (large_initial_size.QuadPart >= 0) {
-            auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
-            auto success = SetFilePointerEx(hh, large_initial_size, NULL, FILE_BEGIN) == 0
-                || SetEndOfFile(hh) == 0;
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(dir));
+    std::wstring buf(MAX_PATH, L'\0');
+    auto n = GetFinalPathNameByHandleW(hh, & buf[0], static_cast<DWORD>(buf.size()), FILE_NAME_NORMALIZED);
 
-            if (!success)
-                ec = pfs::get_last_system_error();
-        } else {
-            ec = std::make_error_code(std::errc::file_too_large);
-        }
-#else
-        auto rc = ::truncate(pfs::utf8_encode_path(path).c_str(), static_cast<off_t>(initial_size));
+    if (n >= buf.size()) {
+        buf.resize(n);
+        n = GetFinalPathNameByHandleW(hh, & buf[0], static_cast<DWORD>(buf.size()), FILE_NAME_NORMALIZED);
+    }
+
+    if (n == 0 || n >= buf.size())
+        return false;
 
-        if (rc != 0)
-            ec = pfs::get_last_system_error();
+    buf.resize(n);
+    result = filepath_t{buf} / path;
+    return true;
+}
 #endif
 
-        if (ec) {
-            pfs::throw_or(perr, tr::f_("resize file failure while open write only file: {}"
-                , pfs::utf8_encode_path(path)));
+template <>
+handle_t file_provider_t::open_directory (filepath_t const & path, error * perr)
+{
+#if _MSC_VER
+    // Directory can be opened by CreateFile() with FILE_FLAG_BACKUP_SEMANTICS only
+    HANDLE hh = CreateFileW(path.c_str(), FILE_READ_ATTRIBUTES
+        , FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+        , NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
 
-            file_provider_t::close(h);
-            return INVALID_FILE_HANDLE;
-        }
+    handle_t h = INVALID_FILE_HANDLE;
+
+    if (hh != INVALID_HANDLE_VALUE) {
+        h = _open_osfhandle(reinterpret_cast<intptr_t>(hh), _O_RDONLY);
+
+        if (h < 0)
+            CloseHandle(hh);
+    }
+#else
+    handle_t h = ::open(pfs::utf8_encode_path(path).c_str(), O_RDONLY | O_DIRECTORY);
+#endif
+
+    if (h < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error()
+            , tr::f_("open directory: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
     }
 
     return h;
 }
 
 template <>
-std::pair<filesize_t, bool> file_provider_t::offset (handle_t const & h, error * perr)
+handle_t file_provider_t::open_read_only_at (handle_t const & dir, filepath_t const & path
+    , file_stat & st, error * perr)
 {
 #if _MSC_VER
-    auto n = _lseek(h, 0, SEEK_CUR);
+    filepath_t abs_path;
+
+    if (!resolve_at(dir, path, abs_path)) {
+        pfs::throw_or(perr, pfs::get_last_system_error()
+            , tr::f_("open read only file: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
+    }
+
+    return open_read_only(abs_path, direct_io_enum::off, st, perr);
 #else
-    auto n = ::lseek(h, 0, SEEK_CUR);
-#endif
+    // O_NONBLOCK is cleared by `check_read_only()` (see `open_read_only()`)
+    handle_t h = ::openat(dir, pfs::utf8_encode_path(path).c_str(), O_RDONLY | O_NONBLOCK);
 
-    if (n < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("get file position"));
-        return std::make_pair(0, false);
+    if (h < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error()
+            , tr::f_("open read only file: {}", pfs::utf8_encode_path(path)));
+        return INVALID_FILE_HANDLE;
     }
 
-    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+    return check_read_only(h, path, st, perr);
+#endif
 }
 
 template <>
-bool file_provider_t::set_pos (handle_t & h, filesize_t pos, error * perr)
+bool file_provider_t::stat_at (handle_t const & dir, filepath_t const & path, file_stat & st
+    , error * perr)
 {
-    // FIXME Need to handle the situation when pos > std::numeric_limits<off_t>::max()
+    bool is_regular = false;
+    bool success = false;
 
-    // NOTE lseek() allows the file offset to be set beyond the end of the file
-    // (but this does not change the size of the file).
 #if _MSC_VER
-    auto offset_value = _lseek(h, pfs::numeric_cast<long>(pos), SEEK_SET);
+    filepath_t abs_path;
+
+    if (resolve_at(dir, path, abs_path)) {
+        HANDLE hh = CreateFileW(abs_path.c_str(), FILE_READ_ATTRIBUTES
+            , FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+            , NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+
+        if (hh != INVALID_HANDLE_VALUE) {
+            success = native_info(hh, st, is_regular);
+            auto errn = GetLastError();
+            CloseHandle(hh);
+            SetLastError(errn);
+        }
+    }
 #else
-    auto offset_value = ::lseek(h, pfs::numeric_cast<off_t>(pos), SEEK_SET);
+    struct stat native_st;
+
+    if (::fstatat(dir, pfs::utf8_encode_path(path).c_str(), & native_st, 0) == 0) {
+        convert_stat(native_st, st, is_regular);
+        success = true;
+    }
 #endif
 
-    if (offset_value < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("set file position"));
-        return false;
+    if (!success) {
+        pfs::throw_or(perr, pfs::get_last_system_error()
+            , tr::f_("file stat: {}", pfs::utf8_encode_path(path)));
     }
 
-    return true;
+    return success;
 }
 
 template <>
-std::pair<filesize_t, bool> file_provider_t::read (handle_t & h, char * buffer
-    , filesize_t len, error * perr)
+bool file_provider_t::reserve (handle_t & h, filesize_t offset, filesize_t len, error * perr)
 {
+    if (len == 0)
+        return true;
+
 #if _MSC_VER
-    auto n = _read(h, buffer, pfs::numeric_cast<unsigned int>(len));
-#else
-    auto n = ::read(h, buffer, pfs::numeric_cast<std::size_t>(len));
-#endif
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
+    FILE_STANDARD_INFO std_info;
 
-    if (n < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("read from file"));
-        return std::make_pair(0, false);
+    if (!GetFileInformationByHandleEx(hh, FileStandardInfo, & std_info, sizeof(std_info))) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("reserve file space"));
+        return false;
     }
 
-    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+    // Allocation size can not be reduced by reservation
+    if (static_cast<filesize_t>(std_info.AllocationSize.QuadPart) >= offset + len)
+        return true;
+
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = static_cast<LONGLONG>(offset + len);
+
+    if (!SetFileInformationByHandle(hh, FileAllocationInfo, & info, sizeof(info))) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("reserve file space"));
+        return false;
+    }
+#elif defined(__linux__)
+    int rc = 0;
+
+    do {
+        rc = ::fallocate(h, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(len));
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        // Not supported by the file system
+        if (errno == EOPNOTSUPP || errno == ENOSYS)
+            return true;
+
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("reserve file space"));
+        return false;
+    }
+#elif defined(__APPLE__)
+    (void)offset;
+
+    // Allocates space beyond the physical end of file
+    fstore_t fst;
+    fst.fst_flags = F_ALLOCATEALL;
+    fst.fst_posmode = F_PEOFPOSMODE;
+    fst.fst_offset = 0;
+    fst.fst_length = static_cast<off_t>(len);
+    fst.fst_bytesalloc = 0;
+
+    if (::fcntl(h, F_PREALLOCATE, & fst) < 0) {
+        if (errno == ENOTSUP)
+            return true;
+
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("reserve file space"));
+        return false;
+    }
+#else
+    (void)h;
+    (void)offset;
+    (void)perr;
+#endif
+
+    return true;
 }
 
 template <>
-std::pair<filesize_t, bool> file_provider_t::write (handle_t & h, char const * buffer
-    , filesize_t len, error * perr)
+bool file_provider_t::resize (handle_t & h, filesize_t size, preallocate_enum prealloc, error * perr)
 {
 #if _MSC_VER
-    auto n = _write(h, buffer, pfs::numeric_cast<unsigned int>(len));
+    if (size > static_cast<filesize_t>((std::numeric_limits<LONGLONG>::max)())) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::file_too_large), tr::_("resize file"));
+        return false;
+    }
+
+    if (prealloc == preallocate_enum::on && !reserve(h, 0, size, perr))
+        return false;
+
+    // Unlike SetEndOfFile() does not change file pointer
+    FILE_END_OF_FILE_INFO info;
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+
+    if (!SetFileInformationByHandle(reinterpret_cast<HANDLE>(_get_osfhandle(h)), FileEndOfFileInfo
+            , & info, sizeof(info))) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("resize file"));
+        return false;
+    }
 #else
-    auto n = ::write(h, buffer, pfs::numeric_cast<std::size_t>(len));
+    int rc = 0;
+
+    do {
+        rc = ::ftruncate(h, static_cast<off_t>(size));
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("resize file"));
+        return false;
+    }
+
+    if (prealloc == preallocate_enum::on && !reserve(h, 0, size, perr))
+        return false;
 #endif
 
-    if (n < 0) {
-        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("write into file"));
-        return std::make_pair(0, false);
+    return true;
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, preallocate_enum prealloc, direct_io_enum direct, error * perr)
+{
+    int oflags = O_WRONLY | O_CREAT;
+
+    if (trunc == truncate_enum::on && initial_size == 0)
+        oflags |= O_TRUNC;
+
+    handle_t h = open_native(path, oflags, direct);
+
+    if (h < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::f_("open write only file failure: {}", path));
+        return INVALID_FILE_HANDLE;
     }
 
-    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+    if (trunc == truncate_enum::on && initial_size > 0) {
+        error err;
+
+        if (!resize(h, initial_size, prealloc, & err)) {
+            pfs::throw_or(perr, err.code(), tr::f_("resize file failure while open write only file: {}"
+                , pfs::utf8_encode_path(path)));
+
+            file_provider_t::close(h);
+            return INVALID_FILE_HANDLE;
+        }
+    }
+
+    return h;
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, direct_io_enum direct, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct, perr);
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct_io_enum::off, perr);
+}
+
+template <>
+bool file_provider_t::sync (handle_t & h, bool data_only, error * perr)
+{
+#if _MSC_VER
+    (void)data_only;
+    auto rc = _commit(h);
+#elif defined(__APPLE__)
+    (void)data_only;
+
+    // fsync() does not flush the drive cache on macOS
+    auto rc = ::fcntl(h, F_FULLFSYNC);
+
+    if (rc < 0)
+        rc = ::fsync(h);
+#else
+    int rc = 0;
+
+    do {
+        rc = data_only ? ::fdatasync(h) : ::fsync(h);
+    } while (rc < 0 && errno == EINTR);
+#endif
+
+    if (rc != 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("synchronize file"));
+        return false;
+    }
+
+    return true;
+}
+
+template <>
+bool file_provider_t::sync_directory (filepath_t const & path, error * perr)
+{
+#if _MSC_VER
+    (void)path;
+    (void)perr;
+    return true;
+#else
+    auto dir = path.parent_path();
+
+    if (dir.empty())
+        dir = fs::path{"."};
+
+    handle_t h = ::open(pfs::utf8_encode_path(dir).c_str(), O_RDONLY | O_DIRECTORY);
+
+    if (h < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error()
+            , tr::f_("open directory: {}", pfs::utf8_encode_path(dir)));
+        return false;
+    }
+
+    auto success = sync(h, false, perr);
+    ::close(h);
+    return success;
+#endif
+}
+
+template <>
+handle_t file_provider_t::open_temporary (filepath_t const & path, filepath_t & temp_path
+    , error * perr)
+{
+    static std::atomic<unsigned> counter {0};
+
+#if _MSC_VER
+    auto pid = _getpid();
+#else
+    auto pid = ::getpid();
+#endif
+
+    auto seed = static_cast<unsigned long long>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+
+    for (int attempt = 0; attempt < 100; attempt++) {
+        auto suffix = "." + std::to_string(pid) + "." + std::to_string(seed % 1000000)
+            + "." + std::to_string(counter++) + ".tmp";
+
+        temp_path = path;
+        temp_path += pfs::utf8_decode_path(suffix);
+
+        handle_t h = open_native(temp_path, O_WRONLY | O_CREAT | O_EXCL, direct_io_enum::off);
+
+        if (h >= 0) {
+#if !_MSC_VER
+            // Keep permissions of the replaced file
+            struct stat st;
+
+            if (::stat(pfs::utf8_encode_path(path).c_str(), & st) == 0)
+                (void)::fchmod(h, st.st_mode & 07777);
+#endif
+            return h;
+        }
+
+        if (errno != EEXIST) {
+            pfs::throw_or(perr, pfs::get_last_system_error()
+                , tr::f_("create temporary file: {}", pfs::utf8_encode_path(temp_path)));
+            return INVALID_FILE_HANDLE;
+        }
+    }
+
+    pfs::throw_or(perr, make_error_code(std::errc::file_exists)
+        , tr::f_("unable to generate unique temporary file for: {}", pfs::utf8_encode_path(path)));
+    return INVALID_FILE_HANDLE;
+}
+
+template <>
+bool file_provider_t::rename (filepath_t const & from, filepath_t const & to, error * perr)
+{
+    std::error_code ec;
+    fs::rename(from, to, ec);
+
+    if (ec) {
+        pfs::throw_or(perr, ec, tr::f_("rename file: {} -> {}", pfs::utf8_encode_path(from)
+            , pfs::utf8_encode_path(to)));
+        return false;
+    }
+
+    return true;
+}
+
+template <>
+bool file_provider_t::remove (filepath_t const & path, error * perr)
+{
+    std::error_code ec;
+    fs::remove(path, ec);
+
+    if (ec) {
+        pfs::throw_or(perr, ec, tr::f_("remove file: {}", pfs::utf8_encode_path(path)));
+        return false;
+    }
+
+    return true;
+}
+
+template <>
+bool file_provider_t::advise (handle_t const & h, filesize_t offset, filesize_t len
+    , advice_enum advice, error * perr)
+{
+#if defined(POSIX_FADV_NORMAL) && !defined(__APPLE__)
+    int flag = POSIX_FADV_NORMAL;
+
+    switch (advice) {
+        case advice_enum::sequential: flag = POSIX_FADV_SEQUENTIAL; break;
+        case advice_enum::random:     flag = POSIX_FADV_RANDOM; break;
+        case advice_enum::willneed:   flag = POSIX_FADV_WILLNEED; break;
+        case advice_enum::dontneed:   flag = POSIX_FADV_DONTNEED; break;
+        default: break;
+    }
+
+    // Returns error number instead of setting errno
+    auto rc = ::posix_fadvise(h, static_cast<off_t>(offset), static_cast<off_t>(len), flag);
+
+    if (rc != 0) {
+        pfs::throw_or(perr, std::error_code(rc, std::system_category()), tr::_("file advise"));
+        return false;
+    }
+#elif defined(__APPLE__)
+    int rc = 0;
+
+    switch (advice) {
+        case advice_enum::normal:
+        case advice_enum::sequential:
+            rc = ::fcntl(h, F_RDAHEAD, 1);
+            break;
+        case advice_enum::random:
+            rc = ::fcntl(h, F_RDAHEAD, 0);
+            break;
+        case advice_enum::willneed:
+            return readahead(h, offset, len, perr);
+        default:
+            break;
+    }
+
+    if (rc < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("file advise"));
+        return false;
+    }
+#else
+    (void)h;
+    (void)offset;
+    (void)len;
+    (void)advice;
+    (void)perr;
+#endif
+
+    return true;
+}
+
+template <>
+bool file_provider_t::readahead (handle_t const & h, filesize_t offset, filesize_t len
+    , error * perr)
+{
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (::readahead(h, static_cast<off64_t>(offset), static_cast<std::size_t>(len)) < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("file readahead"));
+        return false;
+    }
+#elif defined(__APPLE__)
+    radvisory ra;
+    ra.ra_offset = static_cast<off_t>(offset);
+    ra.ra_count = static_cast<int>((std::min)(len
+        , static_cast<filesize_t>((std::numeric_limits<int>::max)())));
+
+    if (::fcntl(h, F_RDADVISE, & ra) < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("file readahead"));
+        return false;
+    }
+#elif !_MSC_VER
+    return advise(h, offset, len, advice_enum::willneed, perr);
+#else
+    (void)h;
+    (void)offset;
+    (void)len;
+    (void)perr;
+#endif
+
+    return true;
+}
+
+template <>
+std::size_t file_provider_t::direct_io_alignment (handle_t const & h) noexcept
+{
+    static constexpr std::size_t DEFAULT_ALIGNMENT = 4096;
+
+#if defined(STATX_DIOALIGN)
+    struct statx stx;
+
+    if (::statx(h, "", AT_EMPTY_PATH, STATX_DIOALIGN, & stx) == 0
+            && (stx.stx_mask & STATX_DIOALIGN) && stx.stx_dio_offset_align > 0) {
+        return (std::max)(stx.stx_dio_mem_align, stx.stx_dio_offset_align);
+    }
+#else
+    (void)h;
+#endif
+
+    return DEFAULT_ALIGNMENT;
+}
+
+template <>
+bool file_provider_t::punch_hole (handle_t & h, filesize_t offset, filesize_t len, error * perr)
+{
+    if (len == 0)
+        return true;
+
+#if _MSC_VER
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
+    DWORD bytes_returned = 0;
+
+    if (!DeviceIoControl(hh, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, & bytes_returned, NULL)) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("punch hole in file"));
+        return false;
+    }
+
+    FILE_ZERO_DATA_INFORMATION info;
+    info.FileOffset.QuadPart = static_cast<LONGLONG>(offset);
+    info.BeyondFinalZero.QuadPart = static_cast<LONGLONG>(offset + len);
+
+    if (!DeviceIoControl(hh, FSCTL_SET_ZERO_DATA, & info, sizeof(info), NULL, 0, & bytes_returned, NULL)) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("punch hole in file"));
+        return false;
+    }
+#elif defined(__linux__)
+    int rc = 0;
+
+    do {
+        rc = ::fallocate(h, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset)
+            , static_cast<off_t>(len));
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("punch hole in file"));
+        return false;
+    }
+#elif defined(F_PUNCHHOLE)
+    // macOS: offset and length must be multiple of the file system block size
+    fpunchhole_t args;
+    args.fp_flags = 0;
+    args.reserved = 0;
+    args.fp_offset = static_cast<off_t>(offset);
+    args.fp_length = static_cast<off_t>(len);
+
+    if (::fcntl(h, F_PUNCHHOLE, & args) < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("punch hole in file"));
+        return false;
+    }
+#else
+    (void)h;
+    (void)offset;
+
+    pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+        , tr::_("punch hole in file"));
+    return false;
+#endif
+
+    return true;
+}
+
+// Maximum size transferred by single read/write call
+#if _MSC_VER
+static constexpr filesize_t MAX_IO_SIZE = (std::numeric_limits<int>::max)();
+#else
+static constexpr filesize_t MAX_IO_SIZE = static_cast<filesize_t>((std::numeric_limits<ssize_t>::max)());
+#endif
+
+static io_result make_io_result (io_op_enum op, filesize_t size) noexcept
+{
+    io_result result;
+    result.op = op;
+    result.size = size;
+    return result;
+}
+
+static io_result make_io_error (io_op_enum op) noexcept
+{
+    io_result result;
+    result.op = op;
+    result.ec = pfs::get_last_system_error();
+    return result;
+}
+
+template <>
+io_result file_provider_t::try_offset (handle_t const & h)
+{
+#if _MSC_VER
+    auto n = _lseeki64(h, 0, SEEK_CUR);
+#else
+    auto n = ::lseek(h, 0, SEEK_CUR);
+#endif
+
+    if (n < 0)
+        return make_io_error(io_op_enum::offset);
+
+    return make_io_result(io_op_enum::offset, static_cast<filesize_t>(n));
+}
+
+template <>
+io_result file_provider_t::try_set_pos (handle_t & h, filesize_t pos)
+{
+    // NOTE lseek() allows the file offset to be set beyond the end of the file
+    // (but this does not change the size of the file).
+#if _MSC_VER
+    using native_offset_t = __int64;
+#else
+    using native_offset_t = off_t;
+#endif
+
+    if (pos > static_cast<filesize_t>((std::numeric_limits<native_offset_t>::max)())) {
+        auto result = make_io_result(io_op_enum::set_pos, 0);
+        result.ec = std::make_error_code(std::errc::value_too_large);
+        return result;
+    }
+
+#if _MSC_VER
+    auto offset_value = _lseeki64(h, static_cast<native_offset_t>(pos), SEEK_SET);
+#else
+    auto offset_value = ::lseek(h, static_cast<native_offset_t>(pos), SEEK_SET);
+#endif
+
+    if (offset_value < 0)
+        return make_io_error(io_op_enum::set_pos);
+
+    return make_io_result(io_op_enum::set_pos, pos);
+}
+
+template <>
+io_result file_provider_t::try_read (handle_t & h, char * buffer, filesize_t len)
+{
+    len = (std::min)(len, MAX_IO_SIZE);
+
+#if _MSC_VER
+    auto n = _read(h, buffer, static_cast<unsigned int>(len));
+#else
+    auto n = ::read(h, buffer, static_cast<std::size_t>(len));
+#endif
+
+    if (n < 0)
+        return make_io_error(io_op_enum::read);
+
+    return make_io_result(io_op_enum::read, static_cast<filesize_t>(n));
+}
+
+template <>
+io_result file_provider_t::try_write (handle_t & h, char const * buffer, filesize_t len)
+{
+    len = (std::min)(len, MAX_IO_SIZE);
+
+#if _MSC_VER
+    auto n = _write(h, buffer, static_cast<unsigned int>(len));
+#else
+    auto n = ::write(h, buffer, static_cast<std::size_t>(len));
+#endif
+
+    if (n < 0)
+        return make_io_error(io_op_enum::write);
+
+    return make_io_result(io_op_enum::write, static_cast<filesize_t>(n));
+}
+
+template <>
+io_result file_provider_t::try_read_at (handle_t const & h, filesize_t offset, char * buffer
+    , filesize_t len)
+{
+    len = (std::min)(len, MAX_IO_SIZE);
+
+#if _MSC_VER
+    // ReadFile() with OVERLAPPED structure reads from the specified offset for synchronous
+    // handles too (but moves file pointer).
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
+    OVERLAPPED ov {};
+    ov.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD n = 0;
+
+    if (!ReadFile(hh, buffer, static_cast<DWORD>(len), & n, & ov)) {
+        // Reading beyond the end of file
+        if (GetLastError() == ERROR_HANDLE_EOF)
+            return make_io_result(io_op_enum::read_at, 0);
+
+        return make_io_error(io_op_enum::read_at);
+    }
+#else
+    if (offset > static_cast<filesize_t>((std::numeric_limits<off_t>::max)())) {
+        auto result = make_io_result(io_op_enum::read_at, 0);
+        result.ec = std::make_error_code(std::errc::value_too_large);
+        return result;
+    }
+
+    auto n = ::pread(h, buffer, static_cast<std::size_t>(len), static_cast<off_t>(offset));
+
+    if (n < 0)
+        return make_io_error(io_op_enum::read_at);
+#endif
+
+    return make_io_result(io_op_enum::read_at, static_cast<filesize_t>(n));
+}
+
+template <>
+io_result file_provider_t::try_write_at (handle_t & h, filesize_t offset, char const * buffer
+    , filesize_t len)
+{
+    len = (std::min)(len, MAX_IO_SIZE);
+
+#if _MSC_VER
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
+    OVERLAPPED ov {};
+    ov.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD n = 0;
+
+    if (!WriteFile(hh, buffer, static_cast<DWORD>(len), & n, & ov))
+        return make_io_error(io_op_enum::write_at);
+#else
+    if (offset > static_cast<filesize_t>((std::numeric_limits<off_t>::max)())) {
+        auto result = make_io_result(io_op_enum::write_at, 0);
+        result.ec = std::make_error_code(std::errc::value_too_large);
+        return result;
+    }
+
+    auto n = ::pwrite(h, buffer, static_cast<std::size_t>(len), static_cast<off_t>(offset));
+
+    if (n < 0)
+        return make_io_error(io_op_enum::write_at);
+#endif
+
+    return make_io_result(io_op_enum::write_at, static_cast<filesize_t>(n));
+}
+
+// Converts result of non-throwing call, error message is formatted on failure only
+static std::pair<filesize_t, bool> to_result_pair (io_result const & res, error * perr)
+{
+    if (!res) {
+        res.report(perr);
+        return std::make_pair(filesize_t{0}, false);
+    }
+
+    return std::make_pair(res.size, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::offset (handle_t const & h, error * perr)
+{
+    return to_result_pair(try_offset(h), perr);
+}
+
+template <>
+bool file_provider_t::set_pos (handle_t & h, filesize_t pos, error * perr)
+{
+    return to_result_pair(try_set_pos(h, pos), perr).second;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read (handle_t & h, char * buffer
+    , filesize_t len, error * perr)
+{
+    return to_result_pair(try_read(h, buffer, len), perr);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write (handle_t & h, char const * buffer
+    , filesize_t len, error * perr)
+{
+    return to_result_pair(try_write(h, buffer, len), perr);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_at (handle_t const & h, filesize_t offset
+    , char * buffer, filesize_t len, error * perr)
+{
+    return to_result_pair(try_read_at(h, offset, buffer, len), perr);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_at (handle_t & h, filesize_t offset
+    , char const * buffer, filesize_t len, error * perr)
+{
+    return to_result_pair(try_write_at(h, offset, buffer, len), perr);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v (handle_t & h, io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+#if _MSC_VER
+    return for_each_buffer(bufs, count, [& h, perr] (io_buffer const & buf, filesize_t) {
+        return file_provider_t::read(h, buf.data, buf.size, perr);
+    });
+#else
+    iovec_array iov {bufs, count};
+    auto n = ::readv(h, iov.data(), iov.size());
+
+    if (n < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("scatter read from file"));
+        return std::make_pair(0, false);
+    }
+
+    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+#endif
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v (handle_t & h, const_io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+#if _MSC_VER
+    return for_each_buffer(bufs, count, [& h, perr] (const_io_buffer const & buf, filesize_t) {
+        return file_provider_t::write(h, buf.data, buf.size, perr);
+    });
+#else
+    iovec_array iov {bufs, count};
+    auto n = ::writev(h, iov.data(), iov.size());
+
+    if (n < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("gather write into file"));
+        return std::make_pair(0, false);
+    }
+
+    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+#endif
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v_at (handle_t const & h, filesize_t offset
+    , io_buffer const * bufs, std::size_t count, error * perr)
+{
+#if IONIK__HAS_PREADV
+    iovec_array iov {bufs, count};
+    auto n = ::preadv(h, iov.data(), iov.size(), pfs::numeric_cast<off_t>(offset));
+
+    if (n < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("scatter read from file at offset"));
+        return std::make_pair(0, false);
+    }
+
+    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+#else
+    return for_each_buffer(bufs, count, [& h, offset, perr] (io_buffer const & buf, filesize_t pos) {
+        return file_provider_t::read_at(h, offset + pos, buf.data, buf.size, perr);
+    });
+#endif
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v_at (handle_t & h, filesize_t offset
+    , const_io_buffer const * bufs, std::size_t count, error * perr)
+{
+#if IONIK__HAS_PREADV
+    iovec_array iov {bufs, count};
+    auto n = ::pwritev(h, iov.data(), iov.size(), pfs::numeric_cast<off_t>(offset));
+
+    if (n < 0) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("gather write into file at offset"));
+        return std::make_pair(0, false);
+    }
+
+    return std::make_pair(pfs::numeric_cast<filesize_t>(n), true);
+#else
+    return for_each_buffer(bufs, count, [& h, offset, perr] (const_io_buffer const & buf, filesize_t pos) {
+        return file_provider_t::write_at(h, offset + pos, buf.data, buf.size, perr);
+    });
+#endif
+}
+
+/**
+ * Copies data through the user space buffer.
+ */
+static std::pair<filesize_t, bool> copy_by_buffer (handle_t const & src, filesize_t offset
+    , handle_t & dst, filesize_t len, error * perr)
+{
+    static constexpr std::size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+    std::vector<char> buffer(static_cast<std::size_t>((std::min)(len, filesize_t{COPY_BUFFER_SIZE})));
+    filesize_t total = 0;
+
+    while (total < len) {
+        auto chunk_size = (std::min)(len - total, static_cast<filesize_t>(buffer.size()));
+        auto n = file_provider_t::read_at(src, offset + total, buffer.data(), chunk_size, perr);
+
+        if (!n.second)
+            return std::make_pair(total, false);
+
+        if (n.first == 0)
+            break;
+
+        filesize_t written = 0;
+
+        while (written < n.first) {
+            auto m = file_provider_t::write(dst, buffer.data() + written, n.first - written, perr);
+
+            if (!m.second)
+                return std::make_pair(total + written, false);
+
+            if (m.first == 0) {
+                pfs::throw_or(perr, make_error_code(std::errc::io_error)
+                    , tr::_("copy file: no data written"));
+                return std::make_pair(total + written, false);
+            }
+
+            written += m.first;
+        }
+
+        total += n.first;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::copy (handle_t const & src, filesize_t offset
+    , handle_t & dst, filesize_t len, error * perr)
+{
+#if defined(__linux__)
+    // Limit single call size to avoid overflow of the ssize_t result
+    static constexpr filesize_t MAX_CHUNK_SIZE = 0x40000000;
+
+#   if defined(__NR_copy_file_range)
+    bool use_copy_file_range = true;
+#   else
+    bool use_copy_file_range = false;
+#   endif
+
+    bool use_sendfile = true;
+    filesize_t total = 0;
+
+    while (total < len) {
+        auto chunk_size = static_cast<std::size_t>((std::min)(len - total, MAX_CHUNK_SIZE));
+        auto in_offset = static_cast<loff_t>(offset + total);
+        ssize_t n = 0;
+
+        if (use_copy_file_range) {
+#   if defined(__NR_copy_file_range)
+            // Called via syscall() as glibc wrapper is available since 2.27 only.
+            // May clone data (reflink) on capable file systems.
+            n = ::syscall(__NR_copy_file_range, src, & in_offset, dst, nullptr, chunk_size, 0U);
+#   endif
+            // Not supported by the kernel, file system or for these files (e.g. across
+            // file systems before Linux 5.3)
+            if (n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL
+                    || errno == EOPNOTSUPP || errno == EBADF)) {
+                use_copy_file_range = false;
+                continue;
+            }
+        } else if (use_sendfile) {
+            auto sendfile_offset = static_cast<off_t>(in_offset);
+            n = ::sendfile(dst, src, & sendfile_offset, chunk_size);
+
+            if (n < 0 && (errno == ENOSYS || errno == EINVAL)) {
+                use_sendfile = false;
+                continue;
+            }
+        } else {
+            auto res = copy_by_buffer(src, offset + total, dst, len - total, perr);
+            return std::make_pair(total + res.first, res.second);
+        }
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+
+            pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("copy file data"));
+            return std::make_pair(total, false);
+        }
+
+        // End of source file
+        if (n == 0)
+            break;
+
+        total += static_cast<filesize_t>(n);
+    }
+
+    return std::make_pair(total, true);
+#else
+    return copy_by_buffer(src, offset, dst, len, perr);
+#endif
+}
+
+template <>
+bool file_provider_t::clone (handle_t const & src, handle_t & dst, error * perr)
+{
+#if defined(__linux__) && defined(FICLONE)
+    if (::ioctl(dst, FICLONE, src) < 0) {
+        auto ec = (errno == EOPNOTSUPP || errno == ENOTTY || errno == EXDEV || errno == EINVAL)
+            ? std::make_error_code(std::errc::operation_not_supported)
+            : pfs::get_last_system_error();
+
+        pfs::throw_or(perr, ec, tr::_("clone file"));
+        return false;
+    }
+
+    return true;
+#else
+    (void)src;
+    (void)dst;
+
+    pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported), tr::_("clone file"));
+    return false;
+#endif
+}
+
+template <>
+file_provider_t::mapped_view file_provider_t::map_read_only (handle_t const & h, filesize_t offset
+    , filesize_t len, advice_enum advice, error * perr)
+{
+    mapped_view view;
+
+    if (len == 0)
+        return view;
+
+    // Mapping offset must be a multiple of the page size (allocation granularity on Windows)
+#if _MSC_VER
+    SYSTEM_INFO si;
+    GetSystemInfo(& si);
+    auto granularity = static_cast<filesize_t>(si.dwAllocationGranularity);
+#else
+    auto granularity = static_cast<filesize_t>(::sysconf(_SC_PAGESIZE));
+#endif
+
+    auto base_offset = offset - offset % granularity;
+    auto delta = pfs::numeric_cast<std::size_t>(offset - base_offset);
+    auto base_size = pfs::numeric_cast<std::size_t>(len) + delta;
+
+#if _MSC_VER
+    auto hh = reinterpret_cast<HANDLE>(_get_osfhandle(h));
+    HANDLE hmapping = CreateFileMappingW(hh, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (hmapping == NULL) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("create file mapping"));
+        return view;
+    }
+
+    void * base = MapViewOfFile(hmapping, FILE_MAP_READ
+        , static_cast<DWORD>(base_offset >> 32)
+        , static_cast<DWORD>(base_offset & 0xFFFFFFFF), base_size);
+
+    // The mapped view keeps the mapping object alive
+    CloseHandle(hmapping);
+
+    if (base == NULL) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("map file region"));
+        return view;
+    }
+
+    // There is no equivalent of madvise() for mapped files
+    (void)advice;
+#else
+    void * base = ::mmap(nullptr, base_size, PROT_READ, MAP_SHARED, h, pfs::numeric_cast<off_t>(base_offset));
+
+    if (base == MAP_FAILED) {
+        pfs::throw_or(perr, pfs::get_last_system_error(), tr::_("map file region"));
+        return view;
+    }
+
+    int flag = MADV_NORMAL;
+
+    switch (advice) {
+        case advice_enum::sequential: flag = MADV_SEQUENTIAL; break;
+        case advice_enum::random:     flag = MADV_RANDOM; break;
+        case advice_enum::willneed:   flag = MADV_WILLNEED; break;
+        case advice_enum::dontneed:   flag = MADV_DONTNEED; break;
+        default: break;
+    }
+
+    // Advice is a hint only, so ignore the failure
+    if (flag != MADV_NORMAL)
+        (void)::madvise(base, base_size, flag);
+#endif
+
+    view._base = base;
+    view._base_size = base_size;
+    view._data = static_cast<char const *>(base) + delta;
+    view._size = base_size - delta;
+
+    return view;
+}
+
+template <>
+void file_provider_t::unmap (mapped_view & view) noexcept
+{
+    if (view._base != nullptr) {
+#if _MSC_VER
+        UnmapViewOfFile(view._base);
+#else
+        ::munmap(view._base, view._base_size);
+#endif
+    }
+
+    view._base = nullptr;
+    view._base_size = 0;
+    view._data = nullptr;
+    view._size = 0;
 }
 
 } // namespace ionik
@@ -0,0 +1,580 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.15 Added non-throwing `try_*` I/O calls.
+//      2026.10.16 Non-throwing calls report error code without formatting the message.
+//      2026.10.16 Mapped view owns the storage without allocation.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/i18n.hpp"
+#include "pfs/ionik/error.hpp"
+#include "pfs/ionik/memory_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace ionik {
+
+using file_provider_t = memory_file_provider;
+using filepath_t = file_provider_t::filepath_type;
+using filesize_t = file_provider_t::filesize_type;
+using handle_t = file_provider_t::handle_type;
+
+struct memory_file_context
+{
+    filepath_t buffer;
+    filesize_t pos {0};
+    bool writable {false};
+};
+
+template <>
+handle_t file_provider_t::invalid () noexcept
+{
+    return nullptr;
+}
+
+template <>
+bool file_provider_t::is_invalid (handle_type const & h) noexcept
+{
+    return h == nullptr;
+}
+
+template <>
+filesize_t file_provider_t::size (filepath_t const & path, error *)
+{
+    return path._s->size;
+}
+
+template <>
+bool file_provider_t::stat (handle_t const & h, file_stat & st, error *)
+{
+    auto const & s = *h->buffer._s;
+
+    st.size = s.size;
+    st.mtime = s.ctime;
+    st.inode = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(& s));
+    st.block_size = 4096;
+
+    return true;
+}
+
+template <>
+void file_provider_t::close (handle_t & h)
+{
+    delete h;
+    h = nullptr;
+}
+
+template <>
+bool file_provider_t::reserve (handle_t & h, filesize_t offset, filesize_t len, error * perr)
+{
+    auto & s = *h->buffer._s;
+    auto required = offset + len;
+
+    if (s.external)
+        return true;
+
+    if (required > static_cast<filesize_t>(s.owned.max_size())) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::file_too_large)
+            , tr::_("reserve memory file space"));
+        return false;
+    }
+
+    s.owned.reserve(static_cast<std::size_t>(required));
+    s.data = s.owned.data();
+    return true;
+}
+
+template <>
+bool file_provider_t::resize (handle_t & h, filesize_t size, preallocate_enum, error * perr)
+{
+    auto & s = *h->buffer._s;
+
+    if (s.external) {
+        if (size > s.capacity) {
+            pfs::throw_or(perr, std::make_error_code(std::errc::no_space_on_device)
+                , tr::f_("resize fixed memory buffer: size {} exceeds capacity {}", size, s.capacity));
+            return false;
+        }
+
+        if (size > s.size)
+            std::memset(s.data + s.size, 0, static_cast<std::size_t>(size - s.size));
+    } else {
+        if (size > static_cast<filesize_t>(s.owned.max_size())) {
+            pfs::throw_or(perr, std::make_error_code(std::errc::file_too_large)
+                , tr::_("resize memory buffer"));
+            return false;
+        }
+
+        s.owned.resize(static_cast<std::size_t>(size));
+        s.data = s.owned.data();
+    }
+
+    s.size = size;
+    return true;
+}
+
+template <>
+bool file_provider_t::punch_hole (handle_t & h, filesize_t offset, filesize_t len, error *)
+{
+    auto & s = *h->buffer._s;
+
+    if (offset < s.size)
+        std::memset(s.data + offset, 0, static_cast<std::size_t>((std::min)(len, s.size - offset)));
+
+    return true;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::offset (handle_t const & h, error *)
+{
+    return std::make_pair(h->pos, true);
+}
+
+template <>
+bool file_provider_t::set_pos (handle_t & h, filesize_t pos, error *)
+{
+    h->pos = pos;
+    return true;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_at (handle_t const & h, filesize_t offset
+    , char * buffer, filesize_t len, error *)
+{
+    auto const & s = *h->buffer._s;
+
+    if (offset >= s.size)
+        return std::make_pair(filesize_t{0}, true);
+
+    auto n = (std::min)(len, s.size - offset);
+    std::memcpy(buffer, s.data + offset, static_cast<std::size_t>(n));
+
+    return std::make_pair(n, true);
+}
+
+static io_result make_io_result (io_op_enum op, filesize_t size, std::error_code ec = {}) noexcept
+{
+    io_result result;
+    result.size = size;
+    result.ec = ec;
+    result.op = op;
+    return result;
+}
+
+// Writes are implemented by non-throwing calls reporting error code only, message is formatted
+// by the throwing ones on failure
+template <>
+io_result file_provider_t::try_write_at (handle_t & h, filesize_t offset, char const * buffer
+    , filesize_t len)
+{
+    if (!h->writable) {
+        return make_io_result(io_op_enum::write_at, 0
+            , std::make_error_code(std::errc::bad_file_descriptor));
+    }
+
+    auto & s = *h->buffer._s;
+    auto n = len;
+
+    if (s.external) {
+        n = offset < s.capacity ? (std::min)(len, s.capacity - offset) : 0;
+
+        if (n == 0 && len > 0) {
+            return make_io_result(io_op_enum::write_at, 0
+                , std::make_error_code(std::errc::no_space_on_device));
+        }
+
+        if (offset > s.size)
+            std::memset(s.data + s.size, 0, static_cast<std::size_t>(offset - s.size));
+    } else if (offset + len > s.size) {
+        auto required = offset + len;
+
+        if (required > static_cast<filesize_t>(s.owned.max_size())) {
+            return make_io_result(io_op_enum::write_at, 0
+                , std::make_error_code(std::errc::file_too_large));
+        }
+
+        // Grow geometrically to make appending amortized constant
+        if (required > s.owned.capacity()) {
+            s.owned.reserve((std::max)(static_cast<std::size_t>(required)
+                , (std::min)(s.owned.capacity() * 2, s.owned.max_size())));
+        }
+
+        s.owned.resize(static_cast<std::size_t>(required));
+        s.data = s.owned.data();
+    }
+
+    std::memcpy(s.data + offset, buffer, static_cast<std::size_t>(n));
+    s.size = (std::max)(s.size, offset + n);
+
+    return make_io_result(io_op_enum::write_at, n);
+}
+
+template <>
+io_result file_provider_t::try_write (handle_t & h, char const * buffer, filesize_t len)
+{
+    auto result = try_write_at(h, h->pos, buffer, len);
+    result.op = io_op_enum::write;
+    h->pos += result.size;
+    return result;
+}
+
+// Reads never fail
+template <>
+io_result file_provider_t::try_read_at (handle_t const & h, filesize_t offset, char * buffer
+    , filesize_t len)
+{
+    return make_io_result(io_op_enum::read_at, read_at(h, offset, buffer, len, nullptr).first);
+}
+
+template <>
+io_result file_provider_t::try_read (handle_t & h, char * buffer, filesize_t len)
+{
+    auto n = read_at(h, h->pos, buffer, len, nullptr).first;
+    h->pos += n;
+    return make_io_result(io_op_enum::read, n);
+}
+
+template <>
+io_result file_provider_t::try_offset (handle_t const & h)
+{
+    return make_io_result(io_op_enum::offset, h->pos);
+}
+
+template <>
+io_result file_provider_t::try_set_pos (handle_t & h, filesize_t pos)
+{
+    h->pos = pos;
+    return make_io_result(io_op_enum::set_pos, pos);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_at (handle_t & h, filesize_t offset
+    , char const * buffer, filesize_t len, error * perr)
+{
+    auto res = try_write_at(h, offset, buffer, len);
+
+    if (!res) {
+        if (res.ec == std::errc::bad_file_descriptor)
+            pfs::throw_or(perr, res.ec, tr::_("write into memory file opened for reading"));
+        else if (res.ec == std::errc::no_space_on_device)
+            pfs::throw_or(perr, res.ec, tr::_("write into fixed memory buffer"));
+        else
+            pfs::throw_or(perr, res.ec, tr::_("write into memory buffer"));
+
+        return std::make_pair(filesize_t{0}, false);
+    }
+
+    return std::make_pair(res.size, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read (handle_t & h, char * buffer
+    , filesize_t len, error * perr)
+{
+    auto res = read_at(h, h->pos, buffer, len, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write (handle_t & h, char const * buffer
+    , filesize_t len, error * perr)
+{
+    auto res = write_at(h, h->pos, buffer, len, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v_at (handle_t const & h, filesize_t offset
+    , io_buffer const * bufs, std::size_t count, error * perr)
+{
+    filesize_t total = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto res = read_at(h, offset + total, bufs[i].data, bufs[i].size, perr);
+
+        if (!res.second)
+            return res;
+
+        total += res.first;
+
+        if (res.first < bufs[i].size)
+            break;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v_at (handle_t & h, filesize_t offset
+    , const_io_buffer const * bufs, std::size_t count, error * perr)
+{
+    filesize_t total = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto res = write_at(h, offset + total, bufs[i].data, bufs[i].size, perr);
+
+        if (!res.second)
+            return total > 0 ? std::make_pair(total, true) : res;
+
+        total += res.first;
+
+        if (res.first < bufs[i].size)
+            break;
+    }
+
+    return std::make_pair(total, true);
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::read_v (handle_t & h, io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+    auto res = read_v_at(h, h->pos, bufs, count, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::write_v (handle_t & h, const_io_buffer const * bufs
+    , std::size_t count, error * perr)
+{
+    auto res = write_v_at(h, h->pos, bufs, count, perr);
+
+    if (res.second)
+        h->pos += res.first;
+
+    return res;
+}
+
+template <>
+std::pair<filesize_t, bool> file_provider_t::copy (handle_t const & src, filesize_t offset
+    , handle_t & dst, filesize_t len, error * perr)
+{
+    auto const & s = *src->buffer._s;
+
+    if (offset >= s.size)
+        return std::make_pair(filesize_t{0}, true);
+
+    len = (std::min)(len, s.size - offset);
+
+    // Source and destination can share the storage that may be reallocated while writing
+    if (src->buffer._s == dst->buffer._s) {
+        std::vector<char> tmp(s.data + offset, s.data + offset + len);
+        return write(dst, tmp.data(), len, perr);
+    }
+
+    return write(dst, s.data + offset, len, perr);
+}
+
+template <>
+bool file_provider_t::clone (handle_t const & src, handle_t & dst, error * perr)
+{
+    if (!resize(dst, 0, preallocate_enum::off, perr))
+        return false;
+
+    auto pos = dst->pos;
+    dst->pos = 0;
+    auto res = copy(src, 0, dst, src->buffer._s->size, perr);
+    dst->pos = pos;
+
+    return res.second;
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , file_stat & st, error * perr)
+{
+    if (direct == direct_io_enum::on) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("direct I/O is not supported by memory file"));
+        return nullptr;
+    }
+
+    auto h = new memory_file_context {path, 0, false};
+    stat(h, st, nullptr);
+    return h;
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, direct_io_enum direct
+    , error * perr)
+{
+    file_stat st;
+    return open_read_only(path, direct, st, perr);
+}
+
+template <>
+handle_t file_provider_t::open_read_only (filepath_t const & path, error * perr)
+{
+    return open_read_only(path, direct_io_enum::off, perr);
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, preallocate_enum prealloc, direct_io_enum direct, error * perr)
+{
+    if (direct == direct_io_enum::on) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::operation_not_supported)
+            , tr::_("direct I/O is not supported by memory file"));
+        return nullptr;
+    }
+
+    if (path._s->read_only) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::permission_denied)
+            , tr::_("open read-only memory buffer for writing"));
+        return nullptr;
+    }
+
+    // Context is released if resizing throws
+    std::unique_ptr<memory_file_context> c {new memory_file_context {path, 0, true}};
+    auto h = c.get();
+
+    if (trunc == truncate_enum::on) {
+        if (!resize(h, 0, preallocate_enum::off, perr) || !resize(h, initial_size, prealloc, perr))
+            return nullptr;
+    }
+
+    return c.release();
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, direct_io_enum direct, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct, perr);
+}
+
+template <>
+handle_t file_provider_t::open_write_only (filepath_t const & path, truncate_enum trunc
+    , filesize_type initial_size, error * perr)
+{
+    return open_write_only(path, trunc, initial_size, preallocate_enum::off, direct_io_enum::off, perr);
+}
+
+template <>
+std::size_t file_provider_t::direct_io_alignment (handle_t const &) noexcept
+{
+    return 1;
+}
+
+template <>
+bool file_provider_t::sync (handle_t &, bool, error *)
+{
+    return true;
+}
+
+template <>
+bool file_provider_t::sync_directory (filepath_t const &, error *)
+{
+    return true;
+}
+
+template <>
+handle_t file_provider_t::open_temporary (filepath_t const &, filepath_t & temp_path, error *)
+{
+    temp_path = memory_buffer{};
+    return new memory_file_context {temp_path, 0, true};
+}
+
+template <>
+bool file_provider_t::remove (filepath_t const & path, error *)
+{
+    auto & s = *path._s;
+
+    if (!s.read_only)
+        s.size = 0;
+
+    if (!s.external) {
+        s.owned.clear();
+        s.owned.shrink_to_fit();
+        s.data = s.owned.data();
+    }
+
+    return true;
+}
+
+template <>
+bool file_provider_t::rename (filepath_t const & from, filepath_t const & to, error * perr)
+{
+    if (from._s == to._s)
+        return true;
+
+    auto h = open_write_only(to, truncate_enum::on, 0, perr);
+
+    if (h == nullptr)
+        return false;
+
+    auto res = write_at(h, 0, from._s->data, from._s->size, perr);
+    close(h);
+
+    if (!res.second)
+        return false;
+
+    if (res.first < from._s->size) {
+        pfs::throw_or(perr, std::make_error_code(std::errc::no_space_on_device)
+            , tr::_("rename memory buffer: target buffer is too small"));
+        return false;
+    }
+
+    return remove(from, perr);
+}
+
+template <>
+bool file_provider_t::advise (handle_t const &, filesize_t, filesize_t, advice_enum, error *)
+{
+    return true;
+}
+
+template <>
+bool file_provider_t::readahead (handle_t const &, filesize_t, filesize_t, error *)
+{
+    return true;
+}
+
+template <>
+file_provider_t::mapped_view file_provider_t::map_read_only (handle_t const & h, filesize_t offset
+    , filesize_t len, advice_enum, error *)
+{
+    mapped_view view;
+    auto const & s = h->buffer._s;
+
+    if (len == 0 || offset >= s->size)
+        return view;
+
+    // No mapping is needed, view refers to the storage data directly. Storage is owned by the
+    // view, but its data is reallocated by growing of the owned buffer, so view is invalidated
+    // by writing beyond the end of the buffer and by resizing.
+    view._owner = s;
+    view._data = s->data + offset;
+    view._size = static_cast<std::size_t>((std::min)(len, s->size - offset));
+
+    return view;
+}
+
+template <>
+void file_provider_t::unmap (mapped_view & view) noexcept
+{
+    view._owner.reset();
+    view._base = nullptr;
+    view._base_size = 0;
+    view._data = nullptr;
+    view._size = 0;
+}
+
+} // namespace ionik
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2024.09.12 Initial version.
+//      2026.10.15 Content buffer is reused between queries.
 ////////////////////////////////////////////////////////////////////////////////
 #include "ionik/metrics/proc_meminfo_provider.hpp"
 #include "parser.hpp"
@@ -72,16 +73,7 @@ bool proc_meminfo_provider::parse_record (string_view::const_iterator & pos
 
 bool proc_meminfo_provider::read_all (error * perr)
 {
-    error err;
-    proc_reader reader {PFS__LITERAL_PATH("/proc/meminfo"), & err};
-
-    if (err) {
-        pfs::throw_or(perr, std::move(err));
-        return false;
-    }
-
-    _content = reader.move_content();
-    return true;
+    return proc_reader::read(PFS__LITERAL_PATH("/proc/meminfo"), _content, perr);
 }
 
 bool proc_meminfo_provider::query (bool (* f) (string_view key, counter_t const & value, void * user_data_ptr)
@@ -6,6 +6,7 @@
 // Changelog:
 //      2024.09.12 Initial version (proc_provider.hpp).
 //      2024.09.27 Initial version (moved from proc_provider.hpp).
+//      2026.10.15 Added `read()` into reusable buffer.
 ////////////////////////////////////////////////////////////////////////////////
 #include "proc_reader.hpp"
 #include "ionik/local_file.hpp"
@@ -23,4 +24,9 @@ proc_reader::proc_reader (pfs::filesystem::path const & path, error * perr)
     _content = proc_file.read_all(perr);
 }
 
+bool proc_reader::read (pfs::filesystem::path const & path, std::string & content, error * perr)
+{
+    return local_file::read_all(path, content, perr).second;
+}
+
 }} // namespace ionik::metrics
@@ -6,6 +6,7 @@
 // Changelog:
 //      2024.09.12 Initial version (proc_provider.hpp).
 //      2024.09.27 Initial version (moved from proc_provider.hpp).
+//      2026.10.15 Added `read()` into reusable buffer.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <pfs/ionik/error.hpp>
@@ -32,6 +33,15 @@ public:
     {
         return std::move(_content);
     }
+
+public: // static
+    /**
+     * Reads content of @a path into @a content. Capacity of @a content is reused, so periodic
+     * reading into the same buffer does not allocate memory. Providers of `/proc` metrics keep
+     * the buffer as a member to reuse it between queries.
+     */
+    static bool read (pfs::filesystem::path const & path, std::string & content
+        , error * perr = nullptr);
 };
 
 }} // namespace ionik::metrics
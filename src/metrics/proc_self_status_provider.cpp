@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2024.09.22 Initial version.
+//      2026.10.15 Content buffer is reused between queries.
 ////////////////////////////////////////////////////////////////////////////////
 #include "parser.hpp"
 #include "proc_reader.hpp"
@@ -98,16 +99,7 @@ bool proc_self_status_provider::parse_record (string_view::const_iterator & pos
 
 bool proc_self_status_provider::read_all (error * perr)
 {
-    error err;
-    proc_reader reader {PFS__LITERAL_PATH("/proc/self/status"), & err};
-
-    if (err) {
-        pfs::throw_or(perr, std::move(err));
-        return false;
-    }
-
-    _content = reader.move_content();
-    return true;
+    return proc_reader::read(PFS__LITERAL_PATH("/proc/self/status"), _content, perr);
 }
 
 bool proc_self_status_provider::query (bool (* f) (string_view key, counter_t const & value, void * user_data_ptr)
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2024.09.26 Initial version.
+//      2026.10.15 Content buffer is reused between queries.
 ////////////////////////////////////////////////////////////////////////////////
 #include "parser.hpp"
 #include "proc_reader.hpp"
@@ -147,16 +148,7 @@ proc_stat_provider::parse_cpu_data (record_view const & rec)
 
 bool proc_stat_provider::read_all (error * perr)
 {
-    error err;
-    proc_reader reader {PFS__LITERAL_PATH("/proc/stat"), & err};
-
-    if (err) {
-        pfs::throw_or(perr, std::move(err));
-        return false;
-    }
-
-    _content = reader.move_content();
-    return true;
+    return proc_reader::read(PFS__LITERAL_PATH("/proc/stat"), _content, perr);
 }
 
 pfs::optional<double> proc_stat_provider::calculate_cpu_usage (record_view const & rec)
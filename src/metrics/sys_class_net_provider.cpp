@@ -5,13 +5,15 @@
 //
 // Changelog:
 //      2024.10.19 Initial version.
+//      2026.10.15 Statistics are read relative to the directory opened once.
+//      2026.10.16 Directory is reopened if interface is re-created.
 ////////////////////////////////////////////////////////////////////////////////
 #include "ionik/metrics/sys_class_net_provider.hpp"
-#include "proc_reader.hpp"
 #include <pfs/filesystem.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/integer.hpp>
 #include <algorithm>
+#include <cerrno>
 #include <cstring>
 
 namespace fs = pfs::filesystem;
@@ -28,26 +30,15 @@ sys_class_net_provider::sys_class_net_provider (std::string iface, std::string r
     if (_readable_name.empty())
         _readable_name = _iface;
 
-    fs::path const net_dir = PFS__LITERAL_PATH("/sys/class/net");
-    fs::path const root_dir = net_dir / pfs::utf8_decode_path(_iface) / PFS__LITERAL_PATH("statistics");
-    _rx_bytes_path = root_dir / PFS__LITERAL_PATH("rx_bytes");
-    _tx_bytes_path = root_dir / PFS__LITERAL_PATH("tx_bytes");
+    _statistics_path = fs::path{PFS__LITERAL_PATH("/sys/class/net")}
+        / pfs::utf8_decode_path(_iface) / PFS__LITERAL_PATH("statistics");
 
-    for (auto const & p: {net_dir, root_dir, _rx_bytes_path, _tx_bytes_path}) {
-        std::error_code ec;
+    // Counters are polled periodically, so the directory is looked up once and counter files are
+    // opened relative to it.
+    _statistics_dir = directory_handle::open(_statistics_path, perr);
 
-        if (fs::exists(p, ec))
-            continue;
-
-        if (ec) {
-            pfs::throw_or(perr, ec, tr::f_("check path failure: {}", p));
-            return;
-        }
-
-        pfs::throw_or(perr, std::make_error_code(std::errc::no_such_file_or_directory)
-            , pfs::utf8_encode_path(p));
+    if (!_statistics_dir)
         return;
-    }
 
     if (!read(_recent_data.rx_bytes, _recent_data.tx_bytes, perr))
         return;
@@ -55,18 +46,17 @@ sys_class_net_provider::sys_class_net_provider (std::string iface, std::string r
     _recent_checkpoint = time_point_type::clock::now();
 }
 
-static std::int64_t read_integer (fs::path const & path, error * perr)
+static std::int64_t read_integer (directory_handle const & dir, fs::path const & path
+    , std::string & text, error * perr)
 {
     error err;
-    proc_reader reader {path, & err};
+    dir.read_all_at(path, text, & err);
 
     if (err) {
         pfs::throw_or(perr, std::move(err));
         return -1;
     }
 
-    auto text = reader.move_content();
-
     char const * first = text.c_str();
     char const * last = first + text.size();
 
@@ -89,14 +79,15 @@ static std::int64_t read_integer (fs::path const & path, error * perr)
     return n;
 }
 
-bool sys_class_net_provider::read (std::int64_t & rx_bytes, std::int64_t & tx_bytes, error * perr)
+bool sys_class_net_provider::read_counters (std::int64_t & rx_bytes, std::int64_t & tx_bytes
+    , error * perr)
 {
-    rx_bytes = read_integer(_rx_bytes_path, perr);
+    rx_bytes = read_integer(_statistics_dir, PFS__LITERAL_PATH("rx_bytes"), _buffer, perr);
 
     if (rx_bytes < 0)
         return false;
 
-    tx_bytes = read_integer(_tx_bytes_path, perr);
+    tx_bytes = read_integer(_statistics_dir, PFS__LITERAL_PATH("tx_bytes"), _buffer, perr);
 
     if (tx_bytes < 0)
         return false;
@@ -104,6 +95,34 @@ bool sys_class_net_provider::read (std::int64_t & rx_bytes, std::int64_t & tx_by
     return true;
 }
 
+bool sys_class_net_provider::read (std::int64_t & rx_bytes, std::int64_t & tx_bytes, error * perr)
+{
+    error err;
+
+    if (_statistics_dir && read_counters(rx_bytes, tx_bytes, & err))
+        return true;
+
+    // Interface can be removed and created again (USB adapter, tun/wireguard restart), then the
+    // opened directory is stale and must be looked up again.
+    auto ec = err.code();
+    bool stale = !_statistics_dir
+        || ec == std::errc::no_such_file_or_directory
+        || ec == std::errc::no_such_device
+        || ec == std::error_condition(ESTALE, std::generic_category());
+
+    if (!stale) {
+        pfs::throw_or(perr, std::move(err));
+        return false;
+    }
+
+    _statistics_dir = directory_handle::open(_statistics_path, perr);
+
+    if (!_statistics_dir)
+        return false;
+
+    return read_counters(rx_bytes, tx_bytes, perr);
+}
+
 bool sys_class_net_provider::read_all (error * perr)
 {
     std::int64_t rx_bytes = 0;
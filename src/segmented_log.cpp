@@ -0,0 +1,483 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+//      2026.10.15 Records are checksummed by hardware accelerated CRC-32C.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/i18n.hpp"
+#include "pfs/ionik/hashing.hpp"
+#include "pfs/ionik/segmented_log.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <string>
+
+namespace fs = pfs::filesystem;
+
+namespace ionik {
+
+using segment_list = std::vector<std::pair<std::uint64_t, fs::path>>;
+
+static constexpr std::size_t SEGMENT_NAME_DIGITS = 20;
+static char const * const SEGMENT_SUFFIX = ".log";
+static constexpr std::size_t SEGMENT_SUFFIX_SIZE = 4;
+
+static void put_u32 (char * p, std::uint32_t value) noexcept
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+static std::uint32_t get_u32 (char const * p) noexcept
+{
+    std::uint32_t result = 0;
+
+    for (int i = 0; i < 4; i++)
+        result |= static_cast<std::uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+
+    return result;
+}
+
+// Returns payload size of the valid record at @a data or zero if there is no valid record
+static std::size_t check_record (char const * data, std::size_t size)
+{
+    if (size < segmented_log::RECORD_HEADER_SIZE)
+        return 0;
+
+    std::size_t len = get_u32(data);
+
+    if (len == 0 || len > size - segmented_log::RECORD_HEADER_SIZE)
+        return 0;
+
+    if (get_u32(data + 4) != crc32c::compute(data + segmented_log::RECORD_HEADER_SIZE, len))
+        return 0;
+
+    return len;
+}
+
+static fs::path segment_path (fs::path const & dir, std::uint64_t base)
+{
+    auto name = std::to_string(base);
+    name.insert(0, SEGMENT_NAME_DIGITS - name.size(), '0');
+    return dir / pfs::utf8_decode_path(name + SEGMENT_SUFFIX);
+}
+
+static bool list_segments (fs::path const & dir, segment_list & segments, error * perr)
+{
+    std::error_code ec;
+    fs::directory_iterator pos {dir, ec};
+    fs::directory_iterator last;
+
+    for (; !ec && pos != last; pos.increment(ec)) {
+        auto name = pfs::utf8_encode_path(pos->path().filename());
+
+        if (name.size() != SEGMENT_NAME_DIGITS + SEGMENT_SUFFIX_SIZE
+                || name.compare(SEGMENT_NAME_DIGITS, SEGMENT_SUFFIX_SIZE, SEGMENT_SUFFIX) != 0) {
+            continue;
+        }
+
+        auto digits_end = name.cbegin() + SEGMENT_NAME_DIGITS;
+
+        auto is_digit = [] (char ch) { return std::isdigit(static_cast<unsigned char>(ch)) != 0; };
+
+        if (!std::all_of(name.cbegin(), digits_end, is_digit))
+            continue;
+
+        segments.emplace_back(std::stoull(name.substr(0, SEGMENT_NAME_DIGITS)), pos->path());
+    }
+
+    if (ec) {
+        pfs::throw_or(perr, ec, tr::f_("list log segments: {}", pfs::utf8_encode_path(dir)));
+        return false;
+    }
+
+    std::sort(segments.begin(), segments.end()
+        , [] (segment_list::value_type const & a, segment_list::value_type const & b) {
+            return a.first < b.first;
+        });
+
+    return true;
+}
+
+// Returns size of the valid records data and number of records
+static std::pair<std::size_t, std::uint64_t> scan_records (char const * data, std::size_t size)
+{
+    std::size_t offset = 0;
+    std::uint64_t count = 0;
+
+    for (;;) {
+        auto len = check_record(data + offset, size - offset);
+
+        if (len == 0)
+            break;
+
+        offset += segmented_log::RECORD_HEADER_SIZE + len;
+        count++;
+    }
+
+    return std::make_pair(offset, count);
+}
+
+segmented_log::segmented_log (filepath_type const & dir, segmented_log_options const & opts
+    , error * perr)
+    : _dir(dir)
+    , _opts(opts)
+{
+    if (_opts.segment_size <= RECORD_HEADER_SIZE) {
+        pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
+            , tr::f_("log segment size is too small: {}", _opts.segment_size));
+        return;
+    }
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    if (ec) {
+        pfs::throw_or(perr, ec, tr::f_("create log directory: {}", pfs::utf8_encode_path(dir)));
+        return;
+    }
+
+    segment_list segments;
+
+    if (!list_segments(dir, segments, perr))
+        return;
+
+    _batch.reserve(_opts.batch_size);
+
+    if (segments.empty()) {
+        open_segment(0, perr);
+        return;
+    }
+
+    // Continue the last segment after its last complete record
+    auto const & last = segments.back();
+    std::size_t used = 0;
+    std::size_t dirty_end = 0;
+    std::uint64_t count = 0;
+
+    {
+        auto in = local_file::open_read_only(last.second, perr);
+
+        if (!in)
+            return;
+
+        auto view = in.map_read_only(advice_enum::sequential, perr);
+
+        if (in.size() > 0 && view.empty())
+            return;
+
+        auto res = scan_records(view.data(), view.size());
+        used = res.first;
+        count = res.second;
+
+        // Remains of the torn record must not be taken for records after the next append
+        auto rpos = std::find_if(view.begin() + used, view.end(), [] (char ch) { return ch != 0; });
+
+        if (rpos != view.end()) {
+            auto rlast = std::find_if(std::reverse_iterator<char const *>(view.end())
+                , std::reverse_iterator<char const *>(rpos)
+                , [] (char ch) { return ch != 0; });
+
+            dirty_end = static_cast<std::size_t>(rlast.base() - view.begin());
+        }
+    }
+
+    auto out = local_file::open_write_only(last.second, truncate_enum::off, 0, perr);
+
+    if (!out)
+        return;
+
+    if (dirty_end > used) {
+        std::vector<char> zeros(dirty_end - used, 0);
+
+        for (std::size_t off = 0; off < zeros.size(); ) {
+            auto res = out.write_at(used + off, zeros.data() + off, zeros.size() - off, perr);
+
+            if (!res.second)
+                return;
+
+            off += static_cast<std::size_t>(res.first);
+        }
+    }
+
+    _segment = std::move(out);
+    _segment_base = last.first;
+    _segment_used = used;
+    _next_seq = _written_seq = _synced_seq = last.first + count;
+}
+
+segmented_log::~segmented_log ()
+{
+    std::unique_lock<std::mutex> locker {_mtx};
+
+    if (!_segment)
+        return;
+
+    error err;
+
+    if (write_batch(& err) && _opts.sync != log_sync_enum::none) {
+        while (_syncing)
+            _sync_cond.wait(locker);
+
+        _segment.sync_data(& err);
+    }
+}
+
+std::pair<std::uint64_t, bool> segmented_log::append (char const * data, std::size_t len
+    , error * perr)
+{
+    if (len == 0 || len > _opts.segment_size - RECORD_HEADER_SIZE
+            || len > (std::numeric_limits<std::uint32_t>::max)()) {
+        pfs::throw_or(perr, make_error_code(std::errc::invalid_argument)
+            , tr::f_("bad log record size: {}", len));
+        return std::make_pair(std::uint64_t{0}, false);
+    }
+
+    std::unique_lock<std::mutex> locker {_mtx};
+
+    if (!_segment) {
+        pfs::throw_or(perr, make_error_code(std::errc::bad_file_descriptor)
+            , tr::_("log is not open"));
+        return std::make_pair(std::uint64_t{0}, false);
+    }
+
+    if (_segment_used + _batch.size() + RECORD_HEADER_SIZE + len > _opts.segment_size) {
+        if (!roll(locker, perr))
+            return std::make_pair(std::uint64_t{0}, false);
+    }
+
+    char header[RECORD_HEADER_SIZE];
+    put_u32(header, static_cast<std::uint32_t>(len));
+    put_u32(header + 4, crc32c::compute(data, len));
+    _batch.insert(_batch.end(), header, header + RECORD_HEADER_SIZE);
+    _batch.insert(_batch.end(), data, data + len);
+
+    auto seq = _next_seq++;
+
+    if (_batch.size() >= _opts.batch_size) {
+        if (!write_batch(perr) || !sync_written(locker, perr))
+            return std::make_pair(seq, false);
+    }
+
+    return std::make_pair(seq, true);
+}
+
+bool segmented_log::commit (error * perr)
+{
+    std::unique_lock<std::mutex> locker {_mtx};
+
+    if (!_segment) {
+        pfs::throw_or(perr, make_error_code(std::errc::bad_file_descriptor)
+            , tr::_("log is not open"));
+        return false;
+    }
+
+    return write_batch(perr) && sync_written(locker, perr);
+}
+
+std::uint64_t segmented_log::next_seq () const
+{
+    std::lock_guard<std::mutex> locker {_mtx};
+    return _next_seq;
+}
+
+std::uint64_t segmented_log::synced_seq () const
+{
+    std::lock_guard<std::mutex> locker {_mtx};
+    return _synced_seq;
+}
+
+bool segmented_log::open_segment (std::uint64_t base, error * perr)
+{
+    auto path = segment_path(_dir, base);
+    auto f = local_file::open_write_only(path, truncate_enum::on, _opts.segment_size
+        , preallocate_enum::on, perr);
+
+    if (!f)
+        return false;
+
+    // Make the new directory entry durable
+    if (_opts.sync != log_sync_enum::none && !local_file_provider::sync_directory(path, perr))
+        return false;
+
+    _segment = std::move(f);
+    _segment_base = base;
+    _segment_used = 0;
+    return true;
+}
+
+bool segmented_log::roll (std::unique_lock<std::mutex> & locker, error * perr)
+{
+    if (!write_batch(perr))
+        return false;
+
+    // Segment can not be closed while it is synchronized by another thread
+    while (_syncing)
+        _sync_cond.wait(locker);
+
+    // Seal the segment: cut off the preallocated tail
+    auto h = _segment.native();
+
+    if (!local_file_provider::resize(h, _segment_used, preallocate_enum::off, perr))
+        return false;
+
+    if (_opts.sync != log_sync_enum::none) {
+        if (!_segment.sync(perr))
+            return false;
+
+        _synced_seq = _written_seq;
+    }
+
+    _segment.close();
+    return open_segment(_next_seq, perr);
+}
+
+bool segmented_log::write_batch (error * perr)
+{
+    std::size_t offset = 0;
+
+    while (offset < _batch.size()) {
+        auto res = _segment.write_at(_segment_used + offset, _batch.data() + offset
+            , _batch.size() - offset, perr);
+
+        if (!res.second) {
+            // Keep unwritten records for the next attempt
+            _batch.erase(_batch.begin(), _batch.begin() + offset);
+            _segment_used += offset;
+            return false;
+        }
+
+        offset += static_cast<std::size_t>(res.first);
+    }
+
+    _segment_used += offset;
+    _batch.clear();
+    _written_seq = _next_seq;
+    return true;
+}
+
+bool segmented_log::sync_written (std::unique_lock<std::mutex> & locker, error * perr)
+{
+    if (_opts.sync != log_sync_enum::commit)
+        return true;
+
+    auto target = _written_seq;
+
+    // Group commit: the thread performing synchronization makes durable all records written
+    // before it started, other threads wait for it instead of issuing their own request.
+    while (_synced_seq < target) {
+        if (_syncing) {
+            _sync_cond.wait(locker);
+            continue;
+        }
+
+        _syncing = true;
+        auto seq = _written_seq;
+
+        locker.unlock();
+        auto success = _segment.sync_data(perr);
+        locker.lock();
+
+        _syncing = false;
+
+        if (success)
+            _synced_seq = (std::max)(_synced_seq, seq);
+
+        _sync_cond.notify_all();
+
+        if (!success)
+            return false;
+    }
+
+    return true;
+}
+
+segmented_log_reader::segmented_log_reader (filepath_type const & dir, error * perr)
+{
+    if (list_segments(dir, _segments, perr) && !_segments.empty())
+        _seq = _segments.front().first;
+}
+
+bool segmented_log_reader::map_segment (std::size_t index, error * perr)
+{
+    _view = local_file::mapped_view_type{};
+    _offset = 0;
+    _index = index;
+    _mapped = false;
+
+    auto f = local_file::open_read_only(_segments[index].second, perr);
+
+    if (!f)
+        return false;
+
+    if (f.size() > 0) {
+        _view = f.map_read_only(advice_enum::sequential, perr);
+
+        if (_view.empty())
+            return false;
+    }
+
+    _seq = _segments[index].first;
+    _mapped = true;
+    return true;
+}
+
+bool segmented_log_reader::seek (std::uint64_t seq, error * perr)
+{
+    auto pos = std::upper_bound(_segments.cbegin(), _segments.cend(), seq
+        , [] (std::uint64_t value, segment_list::value_type const & s) { return value < s.first; });
+
+    if (pos == _segments.cbegin()) {
+        pfs::throw_or(perr, make_error_code(std::errc::result_out_of_range)
+            , tr::f_("log record not found: {}", seq));
+        return false;
+    }
+
+    if (!map_segment(static_cast<std::size_t>(pos - _segments.cbegin()) - 1, perr))
+        return false;
+
+    log_record rec;
+
+    while (_seq < seq && next(rec, perr))
+        ;
+
+    if (_seq != seq) {
+        pfs::throw_or(perr, make_error_code(std::errc::result_out_of_range)
+            , tr::f_("log record not found: {}", seq));
+        return false;
+    }
+
+    return true;
+}
+
+bool segmented_log_reader::next (log_record & rec, error * perr)
+{
+    for (;;) {
+        if (!_mapped) {
+            if (_index >= _segments.size() || !map_segment(_index, perr))
+                return false;
+        }
+
+        auto len = check_record(_view.data() + _offset, _view.size() - _offset);
+
+        if (len > 0) {
+            rec.seq = _seq++;
+            rec.data = _view.data() + _offset + segmented_log::RECORD_HEADER_SIZE;
+            rec.size = len;
+            _offset += segmented_log::RECORD_HEADER_SIZE + len;
+            return true;
+        }
+
+        // End of the last segment
+        if (_index + 1 >= _segments.size())
+            return false;
+
+        _index++;
+        _mapped = false;
+    }
+}
+
+} // namespace ionik
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/buffer_pool.hpp"
+#include "pfs/ionik/memory_file.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+TEST_CASE("acquire and release") {
+    ionik::buffer_pool pool {64, ionik::huge_pages_enum::off, 2};
+
+    char const * data = nullptr;
+
+    {
+        auto buf = pool.acquire(100);
+        REQUIRE_EQ(buf.size(), 100);
+        CHECK_EQ(buf.capacity(), 128);
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(buf.data()) % 64, 0);
+        data = buf.data();
+    }
+
+    CHECK_EQ(pool.cached(), 1);
+
+    // Cached buffer is reused
+    {
+        auto buf = pool.acquire(50);
+        CHECK_EQ(buf.data(), data);
+        CHECK_EQ(buf.size(), 50);
+        CHECK_EQ(pool.cached(), 0);
+
+        // Too small for the request
+        auto buf2 = pool.acquire(200);
+        CHECK_EQ(buf2.capacity(), 256);
+    }
+
+    CHECK_EQ(pool.cached(), 2);
+
+    // Pool is full, smallest buffer is replaced by larger one
+    {
+        auto buf = pool.acquire(1000);
+        auto buf2 = pool.acquire(10);
+        CHECK_EQ(pool.cached(), 1);
+    }
+
+    CHECK_EQ(pool.cached(), 2);
+
+    {
+        auto buf = pool.acquire(300);
+        CHECK_EQ(buf.capacity(), 1024);
+    }
+
+    pool.clear();
+    CHECK_EQ(pool.cached(), 0);
+}
+
+TEST_CASE("cache limits") {
+    // At most 4 buffers of 1024 bytes total, buffers larger than 512 bytes are not cached
+    ionik::buffer_pool pool {64, ionik::huge_pages_enum::off, 4, 1024, 512};
+
+    {
+        auto buf = pool.acquire(600);
+
+        // Not rounded up to power of two, but to alignment
+        CHECK_EQ(buf.capacity(), 640);
+    }
+
+    CHECK_EQ(pool.cached(), 0);
+    CHECK_EQ(pool.cached_bytes(), 0);
+
+    {
+        auto buf1 = pool.acquire(512);
+        auto buf2 = pool.acquire(256);
+        auto buf3 = pool.acquire(256);
+        auto buf4 = pool.acquire(128);
+    }
+
+    // Last released buffer (512) evicts the smallest one (128) to fit into the total limit
+    CHECK_EQ(pool.cached_bytes(), 1024);
+    CHECK_EQ(pool.cached(), 3);
+
+    {
+        auto buf = pool.acquire(64);
+        CHECK_EQ(buf.capacity(), 256);
+        CHECK_EQ(pool.cached_bytes(), 768);
+    }
+
+    CHECK_EQ(pool.cached_bytes(), 1024);
+
+    pool.clear();
+    CHECK_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_CASE("resize") {
+    ionik::buffer_pool pool;
+
+    auto buf = pool.acquire(10);
+    std::memcpy(buf.data(), "0123456789", 10);
+
+    buf.resize(5);
+    CHECK_EQ(buf.size(), 5);
+    CHECK_EQ(buf.capacity(), ionik::buffer_pool::DEFAULT_ALIGNMENT);
+
+    // Content is preserved on growth
+    buf.resize(3 * ionik::buffer_pool::DEFAULT_ALIGNMENT);
+    CHECK_EQ(buf.size(), 3 * ionik::buffer_pool::DEFAULT_ALIGNMENT);
+    CHECK_EQ(buf.capacity(), 4 * ionik::buffer_pool::DEFAULT_ALIGNMENT);
+    CHECK_EQ(std::string(buf.data(), 5), std::string("01234"));
+    CHECK_EQ(pool.cached(), 1);
+
+    buf.release();
+    CHECK(buf.empty());
+    CHECK_EQ(pool.cached(), 2);
+
+    // Default constructed buffer borrows from shared pool
+    ionik::pooled_buffer buf2;
+    buf2.resize(10);
+    CHECK_EQ(buf2.size(), 10);
+}
+
+TEST_CASE("huge pages") {
+    ionik::buffer_pool pool {4096, ionik::huge_pages_enum::on};
+
+    // Huge pages may be not reserved by the system, regular allocation is used in this case
+    auto buf = pool.acquire(3 * 1024 * 1024);
+    REQUIRE_EQ(buf.size(), 3 * 1024 * 1024);
+    std::memset(buf.data(), 'x', buf.size());
+    CHECK_EQ(buf[buf.size() - 1], 'x');
+}
+
+TEST_CASE("read all into pooled buffer") {
+    std::string content(10000, 'a');
+    auto mem = ionik::memory_buffer::wrap(static_cast<char const *>(content.data()), content.size());
+
+    auto f = ionik::memory_file::open_read_only(mem);
+    REQUIRE_EQ(f, true);
+
+    ionik::buffer_pool pool;
+    auto buf = pool.acquire(0);
+    auto res = f.read_all(buf);
+
+    REQUIRE(res.second);
+    CHECK_EQ(res.first, content.size());
+    CHECK_EQ(buf.size(), content.size());
+    CHECK_EQ(std::string(buf.data(), buf.size()), content);
+}
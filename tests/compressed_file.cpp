@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/buffered_file.hpp"
+#include "pfs/ionik/compressed_file.hpp"
+#include "pfs/ionik/local_file.hpp"
+#include <pfs/standard_paths.hpp>
+#include <pfs/universal_id.hpp>
+#include <zstd.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __linux__
+#   include <csignal>
+#   include <sys/resource.h>
+#endif
+
+namespace fs = pfs::filesystem;
+
+static fs::path unique_temp_file_path ()
+{
+    fs::path result;
+    int counter = 100;
+
+    while (result.empty() && counter-- > 0) {
+        result = fs::standard_paths::temp_folder()
+            / pfs::utf8_decode_path(to_string(pfs::generate_uuid()) + ".ionik.zst");
+
+        if (fs::exists(result))
+            result.clear();
+    }
+
+    if (result.empty())
+        throw std::runtime_error("unable to generate unique file");
+
+    return result;
+}
+
+static std::vector<char> make_data (std::size_t size, unsigned seed = 0)
+{
+    std::vector<char> result(size);
+
+    // Compressible but not trivial content
+    for (std::size_t i = 0; i < size; i++)
+        result[i] = static_cast<char>((i / 7 + seed) % 61 + (i % 13 == 0 ? i % 17 : 0));
+
+    return result;
+}
+
+TEST_CASE("write and read") {
+    static constexpr std::size_t TEST_FRAME_SIZE = 64 * 1024;
+
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    ionik::compressed_file_path path {test_file_path, 3, TEST_FRAME_SIZE};
+    auto data = make_data(TEST_FRAME_SIZE * 3 + TEST_FRAME_SIZE / 2);
+
+    {
+        auto out = ionik::compressed_file::open_write_only(path, ionik::truncate_enum::on);
+        REQUIRE_EQ(out, true);
+        CHECK_EQ(out.stat().block_size, TEST_FRAME_SIZE);
+
+        // Random writes are not supported
+        CHECK_THROWS(out.write_at(100, data.data(), 10));
+
+        auto res = out.try_write_at(100, data.data(), 10);
+        CHECK_FALSE(res);
+        CHECK(res.ec == std::errc::operation_not_supported);
+
+        ionik::buffered_writer<ionik::compressed_file_provider> writer {out, 1000};
+        REQUIRE(writer.write(data.data(), data.size()).second);
+        REQUIRE(writer.flush());
+        REQUIRE(out.sync());
+    }
+
+    CHECK_LT(fs::file_size(test_file_path), data.size() / 2);
+    CHECK_EQ(ionik::compressed_file_provider::size(path, nullptr), data.size());
+
+    auto in = ionik::compressed_file::open_read_only(path);
+    REQUIRE_EQ(in, true);
+    CHECK_EQ(in.size(), data.size());
+    CHECK(in.advise(ionik::advice_enum::sequential));
+    CHECK(in.readahead(0, TEST_FRAME_SIZE));
+
+    // Writing into file opened for reading is not allowed
+    CHECK_THROWS(in.write("x", 1));
+    CHECK(in.try_write("x", 1).ec == std::errc::bad_file_descriptor);
+
+    auto content = in.read_all();
+    REQUIRE_EQ(content.size(), data.size());
+    CHECK(std::equal(content.cbegin(), content.cend(), data.cbegin()));
+
+    // Positional reads across frame boundaries in arbitrary order
+    std::vector<char> buffer(TEST_FRAME_SIZE + 100);
+
+    for (std::size_t offset: {TEST_FRAME_SIZE * 3 + 10, TEST_FRAME_SIZE - 50, std::size_t{0}
+            , TEST_FRAME_SIZE * 2 + 1}) {
+        auto res = in.read_at(offset, buffer.data(), buffer.size());
+        REQUIRE(res.second);
+        auto n = (std::min)(buffer.size(), data.size() - offset);
+        REQUIRE_EQ(res.first, n);
+        CHECK(std::equal(buffer.cbegin(), buffer.cbegin() + n, data.cbegin() + offset));
+    }
+
+    // Non-throwing read
+    auto res = in.try_read_at(TEST_FRAME_SIZE - 50, buffer.data(), 100);
+    REQUIRE(res);
+    REQUIRE_EQ(res.size, 100);
+    CHECK(std::equal(buffer.cbegin(), buffer.cbegin() + 100, data.cbegin() + TEST_FRAME_SIZE - 50));
+
+    // Read beyond the end
+    CHECK_EQ(in.read_at(data.size(), buffer.data(), 1).first, 0);
+
+    // Backward positioning
+    REQUIRE(in.set_pos(TEST_FRAME_SIZE + 3));
+    char ch = 0;
+    REQUIRE_EQ(in.read(& ch, 1).first, 1);
+    CHECK_EQ(ch, data[TEST_FRAME_SIZE + 3]);
+
+    auto view = in.map_read_only(TEST_FRAME_SIZE - 10, 20);
+    REQUIRE_EQ(view.size(), 20);
+    CHECK(std::equal(view.begin(), view.end(), data.cbegin() + TEST_FRAME_SIZE - 10));
+
+    in.close();
+
+    // Append to existing file
+    auto tail = make_data(1000, 5);
+
+    {
+        auto file_size = fs::file_size(test_file_path);
+        auto out = ionik::compressed_file::open_write_only(path, ionik::truncate_enum::off);
+        REQUIRE_EQ(out, true);
+        CHECK_EQ(out.offset().first, data.size());
+
+        // Seek table is removed until closing, file is still readable
+        CHECK_LT(fs::file_size(test_file_path), file_size);
+        CHECK_EQ(ionik::compressed_file::open_read_only(path).read_all().size(), data.size());
+
+        REQUIRE_EQ(out.write(tail.data(), tail.size()).first, tail.size());
+    }
+
+    data.insert(data.end(), tail.cbegin(), tail.cend());
+
+    in = ionik::compressed_file::open_read_only(path);
+    REQUIRE_EQ(in, true);
+    content = in.read_all();
+    REQUIRE_EQ(content.size(), data.size());
+    CHECK(std::equal(content.cbegin(), content.cend(), data.cbegin()));
+    in.close();
+
+    // Atomic rewrite
+    REQUIRE(ionik::compressed_file::rewrite(path, std::string{"new content"}
+        , ionik::rewrite_policy_enum::atomic));
+
+    in = ionik::compressed_file::open_read_only(path);
+    CHECK_EQ(in.read_all(), "new content");
+    in.close();
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("file without seek table") {
+    auto test_file_path = unique_temp_file_path();
+
+    auto part1 = make_data(100000, 1);
+    auto part2 = make_data(50000, 2);
+    std::vector<char> compressed;
+
+    // Frame with content size in the header
+    {
+        std::vector<char> frame(ZSTD_compressBound(part1.size()));
+        auto n = ZSTD_compress(frame.data(), frame.size(), part1.data(), part1.size(), 1);
+        REQUIRE_FALSE(ZSTD_isError(n));
+        compressed.insert(compressed.end(), frame.data(), frame.data() + n);
+    }
+
+    // Skippable frame
+    {
+        char skippable[] = {'\x50', '\x2A', '\x4D', '\x18', 3, 0, 0, 0, 'a', 'b', 'c'};
+        compressed.insert(compressed.end(), skippable, skippable + sizeof(skippable));
+    }
+
+    // Streaming frame without content size and with checksum
+    {
+        auto cctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+        std::vector<char> frame(ZSTD_compressBound(part2.size()));
+        ZSTD_outBuffer ob {frame.data(), frame.size(), 0};
+        ZSTD_inBuffer ib {part2.data(), part2.size(), 0};
+        REQUIRE_EQ(ZSTD_compressStream2(cctx, & ob, & ib, ZSTD_e_end), 0);
+        ZSTD_freeCCtx(cctx);
+        compressed.insert(compressed.end(), frame.data(), frame.data() + ob.pos);
+    }
+
+    REQUIRE(ionik::local_file::rewrite(test_file_path, compressed.data(), compressed.size()
+        , ionik::rewrite_policy_enum::in_place));
+
+    auto in = ionik::compressed_file::open_read_only(test_file_path);
+    REQUIRE_EQ(in, true);
+    REQUIRE_EQ(in.size(), part1.size() + part2.size());
+
+    std::vector<char> buffer(200);
+    REQUIRE_EQ(in.read_at(part1.size() - 100, buffer.data(), buffer.size()).first, buffer.size());
+    CHECK(std::equal(buffer.cbegin(), buffer.cbegin() + 100, part1.cend() - 100));
+    CHECK(std::equal(buffer.cbegin() + 100, buffer.cend(), part2.cbegin()));
+
+    in.close();
+
+    // Corrupted file
+    compressed.resize(compressed.size() / 2);
+    REQUIRE(ionik::local_file::rewrite(test_file_path, compressed.data(), compressed.size()
+        , ionik::rewrite_policy_enum::in_place));
+    CHECK_THROWS(ionik::compressed_file::open_read_only(test_file_path));
+
+    ionik::error err;
+    CHECK_FALSE(ionik::compressed_file::open_read_only(test_file_path, & err));
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::illegal_byte_sequence));
+
+    fs::remove(test_file_path);
+}
+
+#if __linux__
+TEST_CASE("write failure") {
+    static constexpr std::size_t TEST_FRAME_SIZE = 4096;
+
+    auto test_file_path = unique_temp_file_path();
+    ionik::compressed_file_path path {test_file_path, 1, TEST_FRAME_SIZE};
+
+    // Incompressible data
+    std::vector<char> data(TEST_FRAME_SIZE);
+    std::mt19937 gen;
+    std::generate(data.begin(), data.end(), [& gen] { return static_cast<char>(gen()); });
+
+    // Writing beyond the file size limit fails with EFBIG
+    rlimit saved_limit;
+    REQUIRE_EQ(::getrlimit(RLIMIT_FSIZE, & saved_limit), 0);
+    auto saved_handler = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit limit = saved_limit;
+    limit.rlim_cur = 3 * TEST_FRAME_SIZE;
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, & limit), 0);
+
+    auto out = ionik::compressed_file::open_write_only(path, ionik::truncate_enum::on);
+    REQUIRE_EQ(out, true);
+
+    ionik::error err;
+    ionik::compressed_file::filesize_type written = 0;
+
+    for (int i = 0; i < 10; i++) {
+        auto res = out.write(data.data(), data.size(), & err);
+
+        if (!res.second)
+            break;
+
+        written += res.first;
+    }
+
+    CHECK(err.code() == std::errc::file_too_large);
+    CHECK_EQ(out.offset().first, written);
+
+    // Failed data is not accepted, so writing continues when the limit is lifted
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, & saved_limit), 0);
+    std::signal(SIGXFSZ, saved_handler);
+
+    REQUIRE_EQ(out.write(data.data(), data.size()).first, data.size());
+    REQUIRE(out.sync());
+    out.close();
+
+    auto in = ionik::compressed_file::open_read_only(path);
+    REQUIRE_EQ(in, true);
+    CHECK_EQ(in.size(), written + data.size());
+    in.close();
+
+    fs::remove(test_file_path);
+}
+#endif
@@ -8,11 +8,22 @@
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include "pfs/ionik/aligned_buffer.hpp"
+#include "pfs/ionik/buffered_file.hpp"
+#include "pfs/ionik/directory_handle.hpp"
 #include "pfs/ionik/local_file.hpp"
 #include <pfs/standard_paths.hpp>
 #include <pfs/universal_id.hpp>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <numeric>
+#include <thread>
+
+#if !_MSC_VER
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
 
 namespace fs = pfs::filesystem;
 
@@ -102,3 +113,722 @@ TEST_CASE("initial size") {
     CHECK_EQ(fs::file_size(test_file_path), initial_size);
     fs::remove(test_file_path);
 }
+
+TEST_CASE("map read only") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    std::vector<char> binary_data(10000);
+    std::iota(binary_data.begin(), binary_data.end(), 0);
+
+    auto test_file = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+    REQUIRE_EQ(test_file.write(binary_data.data(), binary_data.size()).first, binary_data.size());
+    test_file.close();
+
+    test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    // === Whole file
+    auto view = test_file.map_read_only(ionik::advice_enum::sequential);
+    REQUIRE_EQ(view.size(), binary_data.size());
+    CHECK(std::equal(view.begin(), view.end(), binary_data.cbegin()));
+
+    // === Region with offset not aligned to the page size
+    auto region = test_file.map_read_only(5000, 100, ionik::advice_enum::random);
+    REQUIRE_EQ(region.size(), 100);
+    CHECK(std::equal(region.begin(), region.end(), binary_data.cbegin() + 5000));
+
+    // === Empty region
+    CHECK(test_file.map_read_only(0, 0).empty());
+
+    // === Out of bounds
+    REQUIRE_THROWS(test_file.map_read_only(5000, 5001));
+
+    // === View outlives the file
+    test_file.close();
+    decltype(view) moved_view = std::move(view);
+    CHECK(view.empty());
+    REQUIRE_EQ(moved_view.size(), binary_data.size());
+    CHECK_EQ(moved_view[9999], binary_data[9999]);
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("read all") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    std::vector<char> binary_data(100000);
+    std::iota(binary_data.begin(), binary_data.end(), 0);
+
+    auto test_file = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+    REQUIRE_EQ(test_file.write(binary_data.data(), binary_data.size()).first, binary_data.size());
+    test_file.close();
+
+    // === Read into reusable buffer
+    std::string buffer;
+    auto res = ionik::local_file::read_all(test_file_path, buffer);
+    REQUIRE(res.second);
+    REQUIRE_EQ(res.first, binary_data.size());
+    REQUIRE_EQ(buffer.size(), binary_data.size());
+    CHECK(std::equal(buffer.cbegin(), buffer.cend(), binary_data.cbegin()));
+
+    auto capacity = buffer.capacity();
+    auto data = buffer.data();
+
+    // === Read rest of the file into the same buffer (no reallocation expected)
+    test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE(test_file.set_pos(99000));
+    res = test_file.read_all(buffer);
+    REQUIRE(res.second);
+    REQUIRE_EQ(res.first, 1000);
+    CHECK(std::equal(buffer.cbegin(), buffer.cend(), binary_data.cbegin() + 99000));
+    CHECK_EQ(buffer.capacity(), capacity);
+    CHECK_EQ(buffer.data(), data);
+
+    // === End of file
+    res = test_file.read_all(buffer);
+    REQUIRE(res.second);
+    CHECK_EQ(res.first, 0);
+    CHECK(buffer.empty());
+
+    test_file.close();
+
+#if __linux__
+    // === File of unknown size (procfs) into the large reused buffer
+    res = ionik::local_file::read_all(PFS__LITERAL_PATH("/proc/self/stat"), buffer);
+    REQUIRE(res.second);
+    CHECK_GT(res.first, 0);
+    CHECK_EQ(buffer.size(), res.first);
+    CHECK_EQ(buffer.back(), '\n');
+    CHECK_EQ(buffer.capacity(), capacity);
+#endif
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("advise and readahead") {
+    auto test_file_path = unique_temp_file_path();
+
+    std::vector<char> binary_data(100000);
+    std::iota(binary_data.begin(), binary_data.end(), 0);
+    ionik::local_file::rewrite(test_file_path, binary_data.data(), binary_data.size());
+
+    auto test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    ionik::advice_enum const advices[] = {
+          ionik::advice_enum::normal
+        , ionik::advice_enum::sequential
+        , ionik::advice_enum::random
+        , ionik::advice_enum::willneed
+        , ionik::advice_enum::dontneed
+    };
+
+    // Content is not affected by any advice for file and mapped region
+    for (auto advice: advices) {
+        CHECK(test_file.advise(advice));
+        CHECK(test_file.advise(advice, 99000, 1000));
+
+        auto view = test_file.map_read_only(50000, 50000, advice);
+        REQUIRE_EQ(view.size(), 50000);
+        CHECK(std::equal(view.begin(), view.end(), binary_data.cbegin() + 50000));
+    }
+
+    CHECK(test_file.readahead(0, binary_data.size()));
+    CHECK(test_file.readahead(99000, 1000));
+    CHECK_EQ(test_file.read_all(), std::string(binary_data.cbegin(), binary_data.cend()));
+
+    test_file.close();
+
+#if __linux__
+    // === Invalid handle
+    ionik::error err;
+    CHECK_FALSE(test_file.advise(ionik::advice_enum::dontneed, 0, 0, & err));
+    CHECK(err.code() == std::errc::bad_file_descriptor);
+
+    err = ionik::error{};
+    CHECK_FALSE(test_file.readahead(0, 1000, & err));
+    CHECK(err.code() == std::errc::bad_file_descriptor);
+#endif
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("positional read/write") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    std::vector<char> binary_data(4096);
+    std::iota(binary_data.begin(), binary_data.end(), 0);
+
+    auto test_file = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    // Write blocks in reverse order
+    for (std::size_t offset = binary_data.size(); offset > 0; offset -= 512) {
+        auto res = test_file.write_at(offset - 512, binary_data.data() + offset - 512, 512);
+        REQUIRE_EQ(res.first, 512);
+    }
+
+    std::uint32_t value = 0xDEADBEEF;
+    REQUIRE(test_file.write_at(binary_data.size(), value).second);
+
+    test_file.close();
+
+    REQUIRE_EQ(fs::file_size(test_file_path), binary_data.size() + sizeof(value));
+
+    test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    // Concurrent readers over the same file descriptor
+    std::vector<std::thread> readers;
+    std::vector<int> failures(4, 0);
+
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([& test_file, & binary_data, & failures, i] {
+            char buffer[128];
+
+            for (std::size_t offset = i * 128; offset < binary_data.size(); offset += 4 * 128) {
+                auto res = test_file.read_at(offset, buffer, sizeof(buffer));
+
+                if (res.first != sizeof(buffer)
+                        || !std::equal(buffer, buffer + sizeof(buffer), binary_data.cbegin() + offset)) {
+                    failures[i]++;
+                }
+            }
+        });
+    }
+
+    for (auto & t: readers)
+        t.join();
+
+    CHECK_EQ(std::accumulate(failures.cbegin(), failures.cend(), 0), 0);
+
+    std::uint32_t read_value = 0;
+    REQUIRE_EQ(test_file.read_at(binary_data.size(), read_value).first, sizeof(read_value));
+    CHECK_EQ(read_value, value);
+
+    // Reading beyond the end of file
+    auto res = test_file.read_at(binary_data.size() + 100, read_value);
+    CHECK(res.second);
+    CHECK_EQ(res.first, 0);
+
+#if !_MSC_VER
+    // File position is not changed by positional calls
+    CHECK_EQ(test_file.offset().first, 0);
+#endif
+
+    test_file.close();
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("vectored read/write") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    struct header { std::uint32_t magic; std::uint32_t size; };
+
+    std::vector<char> payload(100);
+    std::iota(payload.begin(), payload.end(), 0);
+    header hdr {0xCAFEBABE, static_cast<std::uint32_t>(payload.size())};
+    std::uint16_t trailer = 0xABCD;
+
+    auto test_file = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    auto record_size = sizeof(hdr) + payload.size() + sizeof(trailer);
+    auto res = test_file.write_v({ionik::make_io_buffer(hdr)
+        , {payload.data(), payload.size()}, ionik::make_io_buffer(trailer)});
+    REQUIRE_EQ(res.first, record_size);
+
+    // Second record written at the offset after 32 bytes gap, number of buffers greater than
+    // stack storage size
+    std::vector<ionik::const_io_buffer> bufs;
+
+    for (std::size_t i = 0; i < payload.size(); i += 4)
+        bufs.emplace_back(payload.data() + i, 4);
+
+    res = test_file.write_v_at(record_size + 32, bufs.data(), bufs.size());
+    REQUIRE_EQ(res.first, payload.size());
+
+    test_file.close();
+
+    test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    header hdr1;
+    std::vector<char> payload1(payload.size());
+    std::uint16_t trailer1 = 0;
+
+    res = test_file.read_v({ionik::make_io_buffer(hdr1)
+        , {payload1.data(), payload1.size()}, ionik::make_io_buffer(trailer1)});
+    REQUIRE_EQ(res.first, record_size);
+    CHECK_EQ(hdr1.magic, hdr.magic);
+    CHECK_EQ(hdr1.size, hdr.size);
+    CHECK(payload1 == payload);
+    CHECK_EQ(trailer1, trailer);
+
+    std::vector<char> head(50), tail(50);
+    res = test_file.read_v_at(record_size + 32, {{head.data(), head.size()}, {tail.data(), tail.size()}});
+    REQUIRE_EQ(res.first, payload.size());
+    CHECK(std::equal(head.cbegin(), head.cend(), payload.cbegin()));
+    CHECK(std::equal(tail.cbegin(), tail.cend(), payload.cbegin() + 50));
+
+    // End of file reached
+    res = test_file.read_v_at(record_size + 32 + 60, {{head.data(), head.size()}, {tail.data(), tail.size()}});
+    CHECK(res.second);
+    CHECK_EQ(res.first, 40);
+
+    test_file.close();
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("buffered reader/writer") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    std::vector<char> binary_data(1000);
+    std::iota(binary_data.begin(), binary_data.end(), 0);
+
+    // === Write small chunks and large chunk bypassing the buffer
+    {
+        auto test_file = ionik::local_file::open_write_only(test_file_path);
+        REQUIRE_EQ(test_file, true);
+
+        ionik::buffered_writer<ionik::local_file_provider> writer {test_file, 64};
+
+        for (std::size_t i = 0; i < 500; i += 10)
+            REQUIRE_EQ(writer.write(binary_data.data() + i, 10).first, 10);
+
+        REQUIRE_EQ(writer.write(binary_data.data() + 500, 496).first, 496);
+
+        std::uint32_t tail;
+        std::memcpy(& tail, binary_data.data() + 996, sizeof(tail));
+        REQUIRE(writer.write(tail).second);
+        CHECK_EQ(writer.pending(), sizeof(tail));
+
+        // Remaining data flushed by destructor
+    }
+
+    REQUIRE_EQ(fs::file_size(test_file_path), binary_data.size());
+
+    // === Read
+    auto test_file = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(test_file, true);
+
+    ionik::buffered_reader<ionik::local_file_provider> reader {test_file, 64};
+
+    std::uint16_t value = 0;
+    REQUIRE_EQ(reader.peek(value).first, sizeof(value));
+    CHECK_EQ(value, 0x0100);
+    CHECK_EQ(reader.offset(), 0);
+
+    REQUIRE_EQ(reader.read(value).first, sizeof(value));
+    CHECK_EQ(value, 0x0100);
+    CHECK_EQ(reader.offset(), 2);
+
+    REQUIRE(reader.unread(1));
+    CHECK_EQ(reader.offset(), 1);
+
+    char ch = 0;
+    REQUIRE_EQ(reader.read(ch).first, 1);
+    CHECK_EQ(ch, '\x01');
+
+    // Within buffer
+    REQUIRE(reader.skip(10));
+    REQUIRE_EQ(reader.read(ch).first, 1);
+    CHECK_EQ(ch, '\x0c');
+
+    // Beyond buffer
+    REQUIRE(reader.skip(100));
+    CHECK_EQ(reader.offset(), 113);
+    CHECK_FALSE(reader.unread(1));
+    REQUIRE_EQ(reader.read(ch).first, 1);
+    CHECK_EQ(ch, static_cast<char>(113));
+
+    // Large read bypassing buffer
+    std::vector<char> buffer(800);
+    REQUIRE_EQ(reader.read(buffer.data(), buffer.size()).first, buffer.size());
+    CHECK(std::equal(buffer.cbegin(), buffer.cend(), binary_data.cbegin() + 114));
+
+    REQUIRE(reader.sync_pos());
+    CHECK_EQ(test_file.offset().first, 914);
+
+    // Read till the end of file
+    REQUIRE_EQ(reader.read(buffer.data(), buffer.size()).first, 86);
+    CHECK(std::equal(buffer.cbegin(), buffer.cbegin() + 86, binary_data.cbegin() + 914));
+    REQUIRE_EQ(reader.read(ch).first, 0);
+
+    test_file.close();
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("direct I/O") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    ionik::error err;
+    auto out = ionik::local_file::open_write_only(test_file_path, ionik::truncate_enum::on, 0
+        , ionik::direct_io_enum::on, & err);
+
+    if (!out) {
+        MESSAGE("Direct I/O is not supported: ", err.what());
+        fs::remove(test_file_path);
+        return;
+    }
+
+    auto alignment = out.alignment();
+    REQUIRE(alignment > 0);
+
+    ionik::aligned_buffer buffer {alignment * 4, alignment};
+    REQUIRE_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % alignment, 0);
+
+    for (std::size_t i = 0; i < buffer.size(); i++)
+        buffer.data()[i] = static_cast<char>(i % 251);
+
+    REQUIRE_EQ(out.write(buffer.data(), buffer.size()).first, buffer.size());
+    REQUIRE_EQ(out.write_at(buffer.size(), buffer.data(), alignment).first, alignment);
+
+    // Unaligned size, address and offset
+    CHECK_THROWS(out.write(buffer.data(), alignment - 1));
+    CHECK_THROWS(out.write(buffer.data() + 1, alignment));
+    CHECK_THROWS(out.write_at(1, buffer.data(), alignment));
+
+    out.close();
+    REQUIRE_EQ(fs::file_size(test_file_path), buffer.size() + alignment);
+
+    auto in = ionik::local_file::open_read_only(test_file_path, ionik::direct_io_enum::on);
+    REQUIRE_EQ(in, true);
+    CHECK_EQ(in.alignment(), alignment);
+
+    ionik::aligned_buffer input {buffer.size() * 2, alignment};
+
+    // Short read at the end of file
+    REQUIRE_EQ(in.read(input.data(), input.size()).first, buffer.size() + alignment);
+    CHECK(std::equal(buffer.data(), buffer.data() + buffer.size(), input.data()));
+    CHECK(std::equal(buffer.data(), buffer.data() + alignment, input.data() + buffer.size()));
+
+    REQUIRE_EQ(in.read_at(alignment, input.data(), alignment).first, alignment);
+    CHECK(std::equal(buffer.data() + alignment, buffer.data() + alignment * 2, input.data()));
+
+    CHECK_THROWS(in.read_at(alignment / 2, input.data(), alignment));
+    CHECK_THROWS(in.read_all());
+
+    in.close();
+    fs::remove(test_file_path);
+
+    CHECK_EQ(ionik::aligned_buffer::align_up(1, 512), 512);
+    CHECK_EQ(ionik::aligned_buffer::align_up(512, 512), 512);
+    CHECK_EQ(ionik::aligned_buffer::align_up(513, 512), 1024);
+}
+
+TEST_CASE("preallocation") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    ionik::local_file::filesize_type initial_size = 1024 * 1024; // 1 Mib
+
+    auto out = ionik::local_file::open_write_only(test_file_path, ionik::truncate_enum::on
+        , initial_size, ionik::preallocate_enum::on);
+
+    REQUIRE_EQ(out, true);
+    CHECK_EQ(fs::file_size(test_file_path), initial_size);
+
+    // Reservation does not change file size
+    REQUIRE(out.reserve(initial_size * 2));
+    CHECK_EQ(fs::file_size(test_file_path), initial_size);
+
+    std::vector<char> data(8192, 'x');
+    REQUIRE_EQ(out.write_at(0, data.data(), data.size()).first, data.size());
+
+    ionik::error err;
+
+    if (out.punch_hole(0, 4096, & err)) {
+        CHECK_EQ(fs::file_size(test_file_path), initial_size);
+        out.close();
+
+        auto in = ionik::local_file::open_read_only(test_file_path);
+        std::vector<char> buffer(data.size());
+        REQUIRE_EQ(in.read(buffer.data(), buffer.size()).first, buffer.size());
+        CHECK(std::all_of(buffer.cbegin(), buffer.cbegin() + 4096, [] (char ch) { return ch == 0; }));
+        CHECK(std::all_of(buffer.cbegin() + 4096, buffer.cend(), [] (char ch) { return ch == 'x'; }));
+    } else {
+        MESSAGE("Punching holes is not supported: ", err.what());
+    }
+
+    out.close();
+
+    // Preallocated file shrinks on reopening with smaller initial size
+    out = ionik::local_file::open_write_only(test_file_path, ionik::truncate_enum::on
+        , initial_size / 2, ionik::preallocate_enum::on);
+    REQUIRE_EQ(out, true);
+    out.close();
+    CHECK_EQ(fs::file_size(test_file_path), initial_size / 2);
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("copy") {
+    auto src_path = unique_temp_file_path();
+    auto dst_path = unique_temp_file_path();
+
+    std::string data(3 * 1024 * 1024 + 17, '\0');
+
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i % 253);
+
+    ionik::local_file::rewrite(src_path, data);
+
+    // Region
+    {
+        auto in = ionik::local_file::open_read_only(src_path);
+        auto out = ionik::local_file::open_write_only(dst_path, ionik::truncate_enum::on);
+        REQUIRE_EQ(in, true);
+        REQUIRE_EQ(out, true);
+
+        REQUIRE_EQ(out.write("head", 4).first, 4);
+        auto res = in.copy_to(out, 100, 5000);
+        REQUIRE(res.second);
+        CHECK_EQ(res.first, 5000);
+
+        // Beyond end of file
+        res = in.copy_to(out, data.size() - 10, 100);
+        REQUIRE(res.second);
+        CHECK_EQ(res.first, 10);
+    }
+
+    auto copied = ionik::local_file::read_all(dst_path);
+    REQUIRE(copied);
+    CHECK_EQ(*copied, "head" + data.substr(100, 5000) + data.substr(data.size() - 10));
+
+    // Whole file
+    REQUIRE(ionik::local_file::copy(src_path, dst_path));
+    copied = ionik::local_file::read_all(dst_path);
+    REQUIRE(copied);
+    CHECK(*copied == data);
+
+    fs::remove(src_path);
+    fs::remove(dst_path);
+}
+
+TEST_CASE("rewrite policies") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    ionik::local_file::rewrite(test_file_path, std::string{"initial content"});
+
+    for (auto policy: {ionik::rewrite_policy_enum::in_place, ionik::rewrite_policy_enum::atomic
+            , ionik::rewrite_policy_enum::durable}) {
+        std::string text = "content " + std::to_string(static_cast<int>(policy));
+
+        REQUIRE(ionik::local_file::rewrite(test_file_path, text, policy));
+
+        auto content = ionik::local_file::read_all(test_file_path);
+        REQUIRE(content);
+        CHECK_EQ(*content, text);
+    }
+
+    // No temporary files left
+    auto prefix = pfs::utf8_encode_path(test_file_path.filename());
+
+    for (auto const & entry: fs::directory_iterator{test_file_path.parent_path()}) {
+        auto name = pfs::utf8_encode_path(entry.path().filename());
+        CHECK_FALSE((name != prefix && name.compare(0, prefix.size(), prefix) == 0));
+    }
+
+    // Target directory does not exist: nothing created
+    auto bad_path = test_file_path / pfs::utf8_decode_path("nested");
+    ionik::error err;
+    CHECK_FALSE(ionik::local_file::rewrite(bad_path, "x", 1, ionik::rewrite_policy_enum::atomic, & err));
+    CHECK(err);
+
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("file stat") {
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    auto start = std::chrono::system_clock::now() - std::chrono::seconds{2};
+
+    ionik::local_file::rewrite(test_file_path, std::string(1234, 'x'));
+
+    auto f = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(f, true);
+    CHECK_EQ(f.size(), 1234);
+    CHECK_EQ(f.stat().size, 1234);
+    CHECK(f.stat().mtime >= start);
+    CHECK(f.stat().block_size > 0);
+
+#if !_MSC_VER
+    // Flag used for opening only is not left on the handle
+    CHECK_EQ(::fcntl(f.native(), F_GETFL) & O_NONBLOCK, 0);
+#endif
+
+    auto out = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(out, true);
+    CHECK_EQ(out.size(), 1234);
+    CHECK_EQ(out.stat().inode, f.stat().inode);
+
+    out = ionik::local_file::open_write_only(test_file_path, ionik::truncate_enum::on, 100);
+    REQUIRE_EQ(out, true);
+    CHECK_EQ(out.size(), 100);
+
+    // Moved
+    auto f2 = std::move(f);
+    CHECK_EQ(f2.size(), 1234);
+    CHECK_EQ(f.size(), 0);
+
+    f2.close();
+    out.close();
+
+    ionik::error err;
+
+    // Not a regular file
+    CHECK_FALSE(ionik::local_file::open_read_only(test_file_path.parent_path(), & err));
+    CHECK(err);
+
+    fs::remove(test_file_path);
+
+    // Not exists
+    err = ionik::error{};
+    CHECK_FALSE(ionik::local_file::open_read_only(test_file_path, & err));
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::no_such_file_or_directory));
+}
+
+TEST_CASE("directory handle") {
+    auto const dir_path = unique_temp_file_path();
+    REQUIRE(fs::create_directory(dir_path));
+    REQUIRE(fs::create_directory(dir_path / PFS__LITERAL_PATH("sub")));
+
+    ionik::local_file::rewrite(dir_path / PFS__LITERAL_PATH("a"), std::string("12345\n"));
+    ionik::local_file::rewrite(dir_path / PFS__LITERAL_PATH("sub") / PFS__LITERAL_PATH("b")
+        , std::string(5000, 'b'));
+
+    auto dir = ionik::directory_handle::open(dir_path);
+    REQUIRE_EQ(dir, true);
+
+    auto f = dir.open_at(PFS__LITERAL_PATH("a"));
+    REQUIRE_EQ(f, true);
+    CHECK_EQ(f.size(), 6);
+    CHECK_EQ(f.read_all(), std::string("12345\n"));
+
+#if !_MSC_VER
+    CHECK_EQ(::fcntl(f.native(), F_GETFL) & O_NONBLOCK, 0);
+#endif
+
+    ionik::file_stat st;
+    REQUIRE(dir.stat_at(fs::path{PFS__LITERAL_PATH("sub")} / PFS__LITERAL_PATH("b"), st));
+    CHECK_EQ(st.size, 5000);
+
+    // Buffer is reused for repeated reads
+    std::string content;
+    CHECK(dir.read_all_at(PFS__LITERAL_PATH("a"), content).second);
+    CHECK_EQ(content, std::string("12345\n"));
+    CHECK(dir.read_all_at(fs::path{PFS__LITERAL_PATH("sub")} / PFS__LITERAL_PATH("b"), content).second);
+    CHECK_EQ(content, std::string(5000, 'b'));
+
+    // Absolute path ignores the directory
+    CHECK_EQ(dir.read_all_at(dir_path / PFS__LITERAL_PATH("a")), std::string("12345\n"));
+
+    // Moved
+    auto dir2 = std::move(dir);
+    CHECK_FALSE(dir);
+    REQUIRE_EQ(dir2, true);
+
+    ionik::error err;
+
+    // Not a regular file
+    CHECK_FALSE(dir2.open_at(PFS__LITERAL_PATH("sub"), & err));
+    CHECK(err);
+
+    // Not exists
+    err = ionik::error{};
+    CHECK_FALSE(dir2.open_at(PFS__LITERAL_PATH("missing"), & err));
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::no_such_file_or_directory));
+
+    err = ionik::error{};
+    CHECK_FALSE(dir2.stat_at(PFS__LITERAL_PATH("missing"), st, & err));
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::no_such_file_or_directory));
+
+    err = ionik::error{};
+    CHECK_FALSE(ionik::directory_handle::open(dir_path / PFS__LITERAL_PATH("missing"), & err));
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::no_such_file_or_directory));
+
+    dir2.close();
+    fs::remove_all(dir_path);
+}
+
+TEST_CASE("non-throwing I/O") {
+    auto const test_file_path = unique_temp_file_path();
+
+    {
+        auto out = ionik::local_file::open_write_only(test_file_path, ionik::truncate_enum::on);
+        REQUIRE_EQ(out, true);
+
+        auto res = out.try_write("0123456789", 10);
+        REQUIRE(res);
+        CHECK_EQ(res.size, 10);
+        CHECK(out.try_write_at(20, "abc", 3));
+
+        // Not opened for reading
+        char buf[4];
+        res = out.try_read(buf, sizeof(buf));
+        CHECK_FALSE(res);
+        CHECK_EQ(res.op, ionik::io_op_enum::read);
+        CHECK_EQ(res.ec, std::make_error_code(std::errc::bad_file_descriptor));
+        CHECK_FALSE(res.message().empty());
+
+        ionik::error err;
+        res.report(& err);
+        CHECK(err.code() == std::errc::bad_file_descriptor);
+        CHECK_THROWS_AS(res.report(nullptr), ionik::error);
+    }
+
+    auto in = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(in, true);
+
+    char buf[32];
+    auto res = in.try_read(buf, 4);
+    REQUIRE(res);
+    CHECK_EQ(std::string(buf, res.size), std::string("0123"));
+
+    res = in.try_read_at(20, buf, sizeof(buf));
+    REQUIRE(res);
+    CHECK_EQ(std::string(buf, res.size), std::string("abc"));
+
+    // End of file
+    res = in.try_read_at(100, buf, sizeof(buf));
+    REQUIRE(res);
+    CHECK_EQ(res.size, 0);
+
+    res = ionik::local_file_provider::try_offset(in.native());
+    REQUIRE(res);
+    CHECK_EQ(res.size, 4);
+
+    auto h = in.native();
+    CHECK(ionik::local_file_provider::try_set_pos(h, 8));
+    res = in.try_read(buf, sizeof(buf));
+    CHECK_EQ(res.size, 15);
+
+    in.close();
+    fs::remove(test_file_path);
+
+#if !_MSC_VER
+    // Expected error on non-blocking descriptor
+    int fds[2];
+    REQUIRE_EQ(::pipe(fds), 0);
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    res = ionik::local_file_provider::try_read(fds[0], buf, sizeof(buf));
+    CHECK_FALSE(res);
+    CHECK(res.would_block());
+    CHECK_FALSE(res.interrupted());
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+#endif
+}
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/hashing.hpp"
+#include "pfs/ionik/memory_file.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bitwise reference implementation
+static std::uint32_t crc32c_ref (char const * data, std::size_t len)
+{
+    std::uint32_t crc = 0xFFFFFFFF;
+
+    for (std::size_t i = 0; i < len; i++) {
+        crc ^= static_cast<unsigned char>(data[i]);
+
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+TEST_CASE("crc32c") {
+    MESSAGE("CRC-32C hardware: " << ionik::crc32c_hardware());
+
+    CHECK_EQ(ionik::crc32c::compute("", 0), 0);
+    CHECK_EQ(ionik::crc32c::compute("123456789", 9), 0xE3069283);
+
+    std::vector<char> data(1000);
+
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i * 31 + 7);
+
+    // All alignments and tails
+    for (std::size_t offset = 0; offset < 9; offset++) {
+        for (std::size_t len: {0, 1, 7, 8, 9, 15, 16, 17, 100, 991}) {
+            CHECK_EQ(ionik::crc32c::compute(data.data() + offset, len)
+                , crc32c_ref(data.data() + offset, len));
+        }
+    }
+
+    // Incremental
+    ionik::crc32c hasher;
+    hasher.update(data.data(), 3);
+    hasher.update(data.data() + 3, 500);
+    hasher.update(data.data() + 503, data.size() - 503);
+    CHECK_EQ(hasher.digest(), crc32c_ref(data.data(), data.size()));
+
+    hasher.reset();
+    CHECK_EQ(hasher.digest(), 0);
+}
+
+#if IONIK__HAS_XXHASH
+TEST_CASE("xxh3") {
+    CHECK_EQ(ionik::xxh3_64::compute("", 0), 0x2D06800538D394C2ULL);
+
+    std::string data(10000, 'x');
+    ionik::xxh3_64 hasher;
+    hasher.update(data.data(), 1000);
+    hasher.update(data.data() + 1000, data.size() - 1000);
+    CHECK_EQ(hasher.digest(), ionik::xxh3_64::compute(data.data(), data.size()));
+
+    auto moved = std::move(hasher);
+    CHECK_EQ(moved.digest(), ionik::xxh3_64::compute(data.data(), data.size()));
+
+    // Moved-from hasher has no state
+    hasher.update(data.data(), data.size());
+    hasher.reset();
+    CHECK_EQ(hasher.digest(), ionik::xxh3_64::compute("", 0));
+
+    hasher = ionik::xxh3_64{};
+    hasher.update(data.data(), data.size());
+    CHECK_EQ(hasher.digest(), ionik::xxh3_64::compute(data.data(), data.size()));
+}
+#endif
+
+TEST_CASE("hashing reader/writer") {
+    std::string data;
+
+    for (int i = 0; i < 100000; i++)
+        data.push_back(static_cast<char>(i % 251));
+
+    auto expected = crc32c_ref(data.data(), data.size());
+
+    ionik::memory_buffer buffer;
+
+    {
+        auto out = ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::on);
+        REQUIRE_EQ(out, true);
+
+        ionik::hashing_writer<ionik::crc32c, ionik::memory_file_provider> writer {out};
+
+        for (std::size_t pos = 0; pos < data.size(); pos += 4096) {
+            auto n = (std::min)(data.size() - pos, std::size_t{4096});
+            auto res = writer.write(data.data() + pos, n);
+            REQUIRE(res.second);
+        }
+
+        CHECK_EQ(writer.digest(), expected);
+    }
+
+    auto in = ionik::memory_file::open_read_only(buffer);
+    REQUIRE_EQ(in, true);
+
+    ionik::hashing_reader<ionik::crc32c, ionik::memory_file_provider> reader {in};
+
+    // Process the header, hash the rest
+    std::uint32_t header = 0;
+    auto res = reader.read(header);
+    REQUIRE(res.second);
+    CHECK_EQ(res.first, sizeof(header));
+
+    res = reader.consume(1000);
+    REQUIRE(res.second);
+    CHECK_EQ(res.first, data.size() - sizeof(header));
+    CHECK_EQ(reader.digest(), expected);
+
+#if IONIK__HAS_XXHASH
+    in = ionik::memory_file::open_read_only(buffer);
+    ionik::hashing_reader<ionik::xxh3_64, ionik::memory_file_provider> xreader {in};
+    CHECK(xreader.consume().second);
+    CHECK_EQ(xreader.digest(), ionik::xxh3_64::compute(data.data(), data.size()));
+#endif
+}
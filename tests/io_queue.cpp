@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/io_queue.hpp"
+#include "pfs/ionik/local_file.hpp"
+#include <pfs/standard_paths.hpp>
+#include <pfs/universal_id.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace fs = pfs::filesystem;
+
+static fs::path unique_temp_file_path ()
+{
+    fs::path result;
+    int counter = 100;
+
+    while (result.empty() && counter-- > 0) {
+        result = fs::standard_paths::temp_folder()
+            / pfs::utf8_decode_path(to_string(pfs::generate_uuid()) + ".ionik");
+
+        if (fs::exists(result))
+            result.clear();
+    }
+
+    if (result.empty())
+        throw std::runtime_error("unable to generate unique file");
+
+    return result;
+}
+
+static void test_queue (ionik::io_queue & q)
+{
+    static constexpr std::size_t IO_BLOCK_SIZE = 4096;
+    static constexpr std::size_t BLOCK_COUNT = 64;
+
+    auto test_file_path = unique_temp_file_path();
+    MESSAGE("Test file path: ", pfs::utf8_encode_path(test_file_path));
+
+    std::vector<char> data(IO_BLOCK_SIZE * BLOCK_COUNT);
+
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i % 251);
+
+    // === Batch write
+    auto out = ionik::local_file::open_write_only(test_file_path);
+    REQUIRE_EQ(out, true);
+
+    for (std::size_t i = 0; i < BLOCK_COUNT; i++)
+        REQUIRE(q.prepare_write(out, i * IO_BLOCK_SIZE, data.data() + i * IO_BLOCK_SIZE, IO_BLOCK_SIZE, i));
+
+    CHECK_EQ(q.submit(), BLOCK_COUNT);
+
+    std::vector<ionik::io_completion> completions(BLOCK_COUNT);
+    std::size_t completed = 0;
+
+    while (completed < BLOCK_COUNT) {
+        auto n = q.wait(completions.data(), completions.size());
+        REQUIRE(n > 0);
+
+        for (std::size_t i = 0; i < n; i++) {
+            CHECK(completions[i].ok());
+            CHECK_EQ(completions[i].result, IO_BLOCK_SIZE);
+        }
+
+        completed += n;
+    }
+
+    out.close();
+    REQUIRE_EQ(fs::file_size(test_file_path), data.size());
+
+    // === Batch read in reverse order
+    auto in = ionik::local_file::open_read_only(test_file_path);
+    REQUIRE_EQ(in, true);
+
+    std::vector<char> buffer(data.size());
+
+    for (std::size_t i = BLOCK_COUNT; i > 0; i--) {
+        REQUIRE(q.prepare_read(in, (i - 1) * IO_BLOCK_SIZE, buffer.data() + (i - 1) * IO_BLOCK_SIZE
+            , IO_BLOCK_SIZE, i - 1));
+    }
+
+    CHECK_EQ(q.submit(), BLOCK_COUNT);
+
+    std::vector<bool> done(BLOCK_COUNT, false);
+    completed = q.wait(completions.data(), completions.size(), BLOCK_COUNT);
+    REQUIRE_EQ(completed, BLOCK_COUNT);
+
+    for (auto const & c: completions) {
+        CHECK_EQ(c.result, IO_BLOCK_SIZE);
+        done[c.user_data] = true;
+    }
+
+    CHECK(std::all_of(done.cbegin(), done.cend(), [] (bool x) { return x; }));
+    CHECK(buffer == data);
+
+    // === Registered file and buffer
+    std::fill(buffer.begin(), buffer.end(), 0);
+    ionik::io_queue::handle_type files[] = { in.native() };
+    ionik::io_buffer bufs[] = { ionik::io_buffer{buffer.data(), buffer.size()} };
+
+    REQUIRE(q.register_files(files, 1));
+    REQUIRE(q.register_buffers(bufs, 1));
+
+    REQUIRE(q.prepare_read_fixed(0, IO_BLOCK_SIZE, 0, buffer.data(), IO_BLOCK_SIZE, 42));
+    CHECK_EQ(q.submit(), 1);
+
+    REQUIRE_EQ(q.wait(completions.data(), 1), 1);
+    CHECK_EQ(completions[0].user_data, 42);
+    CHECK_EQ(completions[0].result, IO_BLOCK_SIZE);
+    CHECK(std::equal(buffer.cbegin(), buffer.cbegin() + IO_BLOCK_SIZE, data.cbegin() + IO_BLOCK_SIZE));
+
+    // Out of range file index, buffer index and buffer range
+    CHECK_FALSE(q.prepare_read_fixed(1, 0, 0, buffer.data(), IO_BLOCK_SIZE, 0));
+    CHECK_FALSE(q.prepare_read_fixed(0, 0, 1, buffer.data(), IO_BLOCK_SIZE, 0));
+    CHECK_FALSE(q.prepare_read_fixed(0, 0, 0, buffer.data() + 1, buffer.size(), 0));
+
+    // === Error
+    char ch;
+    REQUIRE(q.prepare_read(-1, 0, & ch, 1, 0));
+    CHECK_EQ(q.submit(), 1);
+    REQUIRE_EQ(q.wait(completions.data(), 1), 1);
+    CHECK_FALSE(completions[0].ok());
+    CHECK(completions[0].error_code());
+
+    // === Nothing in flight
+    CHECK_EQ(q.wait(completions.data(), completions.size()), 0);
+    CHECK_EQ(q.poll(completions.data(), completions.size()), 0);
+
+    in.close();
+    fs::remove(test_file_path);
+}
+
+TEST_CASE("thread pool") {
+    ionik::io_queue q {128, ionik::io_queue::backend_enum::thread_pool, 2};
+    REQUIRE(q);
+    CHECK_EQ(q.backend(), ionik::io_queue::backend_enum::thread_pool);
+    test_queue(q);
+}
+
+TEST_CASE("default backend") {
+    ionik::io_queue q {128};
+    REQUIRE(q);
+    MESSAGE("Backend: ", (q.backend() == ionik::io_queue::backend_enum::io_uring
+        ? std::string{"io_uring"} : std::string{"thread pool"}));
+    test_queue(q);
+}
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/buffered_file.hpp"
+#include "pfs/ionik/memory_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("growable buffer") {
+    ionik::memory_buffer buffer;
+    CHECK(buffer.growable());
+    CHECK_EQ(buffer.size(), 0);
+
+    auto out = ionik::memory_file::open_write_only(buffer);
+    REQUIRE_EQ(out, true);
+
+    std::vector<char> data(10000);
+    std::iota(data.begin(), data.end(), 0);
+
+    REQUIRE_EQ(out.write(data.data(), data.size()).first, data.size());
+    REQUIRE_EQ(out.write_at(20000, "tail", 4).first, 4);
+    out.close();
+
+    // Gap is filled with zeros
+    REQUIRE_EQ(buffer.size(), 20004);
+    CHECK(std::equal(data.cbegin(), data.cend(), buffer.data()));
+    CHECK(std::all_of(buffer.data() + 10000, buffer.data() + 20000, [] (char ch) { return ch == 0; }));
+    CHECK_EQ(std::string(buffer.data() + 20000, 4), "tail");
+
+    // Copy of the buffer shares the storage
+    auto copy = buffer;
+    auto in = ionik::memory_file::open_read_only(copy);
+    REQUIRE_EQ(in, true);
+    CHECK_EQ(in.size(), 20004);
+
+    std::vector<char> input(data.size());
+    REQUIRE_EQ(in.read(input.data(), input.size()).first, input.size());
+    CHECK(input == data);
+
+    REQUIRE_EQ(in.read_at(20002, input.data(), input.size()).first, 2);
+    CHECK_EQ(std::string(input.data(), 2), "il");
+
+    // Writing into file opened for reading is not allowed
+    CHECK_THROWS(in.write("x", 1));
+
+    // Zero-copy view
+    auto view = in.map_read_only(100, 10);
+    REQUIRE_EQ(view.size(), 10);
+    CHECK_EQ(view.data(), buffer.data() + 100);
+
+    // Rest of the file from the current position
+    auto rest = in.read_all();
+    CHECK_EQ(rest.size(), 10004);
+
+    // Truncation
+    out = ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::on, 16);
+    REQUIRE_EQ(out, true);
+    CHECK_EQ(buffer.size(), 16);
+    CHECK(std::all_of(buffer.data(), buffer.data() + 16, [] (char ch) { return ch == 0; }));
+}
+
+TEST_CASE("fixed buffer") {
+    char storage[16];
+    std::memset(storage, 'x', sizeof(storage));
+
+    auto buffer = ionik::memory_buffer::wrap(storage, sizeof(storage));
+    CHECK_FALSE(buffer.growable());
+    CHECK_EQ(buffer.size(), 16);
+
+    auto out = ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::on);
+    REQUIRE_EQ(out, true);
+    CHECK_EQ(buffer.size(), 0);
+
+    // Write is limited by the region size
+    REQUIRE_EQ(out.write("0123456789", 10).first, 10);
+    CHECK_EQ(out.write("0123456789", 10).first, 6);
+
+    ionik::error err;
+    CHECK_FALSE(out.write("0", 1, & err).second);
+    CHECK_EQ(err.code(), std::make_error_code(std::errc::no_space_on_device));
+
+    CHECK_EQ(std::string(storage, 16), "0123456789012345");
+    CHECK_THROWS(ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::on, 17));
+
+    // Read-only region
+    auto ro_buffer = ionik::memory_buffer::wrap(static_cast<char const *>(storage), sizeof(storage));
+    CHECK(ro_buffer.read_only());
+    CHECK_THROWS(ionik::memory_file::open_write_only(ro_buffer));
+}
+
+TEST_CASE("memory file adapters") {
+    ionik::memory_buffer buffer;
+
+    {
+        auto out = ionik::memory_file::open_write_only(buffer);
+        ionik::buffered_writer<ionik::memory_file_provider> writer {out, 64};
+
+        for (std::uint32_t i = 0; i < 100; i++)
+            REQUIRE(writer.write(i).second);
+    }
+
+    REQUIRE_EQ(buffer.size(), 100 * sizeof(std::uint32_t));
+
+    auto in = ionik::memory_file::open_read_only(buffer);
+    ionik::buffered_reader<ionik::memory_file_provider> reader {in, 64};
+    std::uint32_t value = 0;
+
+    REQUIRE(reader.skip(10 * sizeof(value)));
+    REQUIRE_EQ(reader.read(value).first, sizeof(value));
+    CHECK_EQ(value, 10);
+
+    // Atomic rewrite
+    REQUIRE(ionik::memory_file::rewrite(buffer, std::string{"new content"}
+        , ionik::rewrite_policy_enum::atomic));
+    CHECK_EQ(std::string(buffer.data(), buffer.size()), "new content");
+
+    // Copy
+    ionik::memory_buffer target;
+    REQUIRE(ionik::memory_file::copy(buffer, target));
+    CHECK_EQ(std::string(target.data(), target.size()), "new content");
+}
+
+TEST_CASE("non-throwing I/O") {
+    char storage[8];
+    auto buffer = ionik::memory_buffer::wrap(storage, sizeof(storage));
+
+    auto out = ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::on);
+    REQUIRE_EQ(out, true);
+
+    auto res = out.try_write("0123456789", 10);
+    REQUIRE(res);
+    CHECK_EQ(res.size, 8);
+    CHECK_EQ(res.op, ionik::io_op_enum::write);
+
+    res = out.try_write_at(8, "x", 1);
+    CHECK_FALSE(res);
+    CHECK_EQ(res.op, ionik::io_op_enum::write_at);
+    CHECK(res.ec == std::errc::no_space_on_device);
+
+    auto in = ionik::memory_file::open_read_only(buffer);
+    REQUIRE_EQ(in, true);
+
+    char buf[16];
+    res = in.try_read(buf, 4);
+    REQUIRE(res);
+    CHECK_EQ(std::string(buf, res.size), "0123");
+
+    res = in.try_read_at(6, buf, sizeof(buf));
+    REQUIRE(res);
+    CHECK_EQ(std::string(buf, res.size), "67");
+
+    res = in.try_write("x", 1);
+    CHECK_FALSE(res);
+    CHECK(res.ec == std::errc::bad_file_descriptor);
+
+    auto h = in.native();
+    CHECK(ionik::memory_file_provider::try_set_pos(h, 2));
+    CHECK_EQ(ionik::memory_file_provider::try_offset(h).size, 2);
+}
+
+TEST_CASE("mapped view") {
+    ionik::memory_file::mapped_view_type view;
+
+    {
+        ionik::memory_buffer buffer {std::vector<char>{'0', '1', '2', '3', '4', '5', '6', '7'}};
+        auto in = ionik::memory_file::open_read_only(buffer);
+        REQUIRE_EQ(in, true);
+
+        view = in.map_read_only(2, 4);
+        REQUIRE_EQ(view.size(), 4);
+        CHECK_EQ(std::string(view.begin(), view.end()), "2345");
+
+        // Region beyond the end
+        CHECK(ionik::memory_file_provider::map_read_only(in.native(), 8, 4
+            , ionik::advice_enum::normal, nullptr).empty());
+        CHECK(ionik::memory_file_provider::map_read_only(in.native(), 100, 4
+            , ionik::advice_enum::normal, nullptr).empty());
+
+        // Writing within the buffer is visible through the view
+        auto out = ionik::memory_file::open_write_only(buffer, ionik::truncate_enum::off);
+        REQUIRE_EQ(out, true);
+        REQUIRE_EQ(out.write_at(3, "xy", 2).first, 2);
+        CHECK_EQ(std::string(view.begin(), view.end()), "2xy5");
+    }
+
+    // Storage is kept alive by the view
+    CHECK_EQ(std::string(view.begin(), view.end()), "2xy5");
+}
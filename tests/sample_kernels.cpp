@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/audio/sample_kernels.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using ionik::audio::reduce_samples;
+using ionik::audio::sample_stats;
+
+// Straightforward reference implementation
+template <typename T, typename Normalize>
+static void reduce_ref (std::vector<T> const & samples, std::size_t channels, std::size_t frame_step
+    , sample_stats * stats, Normalize normalize)
+{
+    auto frame_count = samples.size() / channels;
+
+    for (std::size_t c = 0; c < channels; c++) {
+        for (std::size_t f = 0; f < frame_count; f += frame_step) {
+            double v = normalize(samples[f * channels + c]);
+            auto & s = stats[c];
+            s.count++;
+            s.sum += v;
+            s.sum_squares += v * v;
+            s.min = (std::min)(s.min, static_cast<float>(v));
+            s.max = (std::max)(s.max, static_cast<float>(v));
+        }
+    }
+}
+
+static void check_stats (sample_stats const & a, sample_stats const & b)
+{
+    CHECK_EQ(a.count, b.count);
+    CHECK_EQ(a.sum, doctest::Approx(b.sum).epsilon(1e-9));
+    CHECK_EQ(a.sum_squares, doctest::Approx(b.sum_squares).epsilon(1e-9));
+    CHECK_EQ(a.min, doctest::Approx(b.min));
+    CHECK_EQ(a.max, doctest::Approx(b.max));
+    CHECK_EQ(a.mean(), doctest::Approx(b.mean()));
+    CHECK_EQ(a.rms(), doctest::Approx(b.rms()));
+}
+
+template <typename T, typename Generate, typename Normalize>
+static void check_kernels (Generate generate, Normalize normalize)
+{
+    // Sizes cover vector bulk with scalar tails and more than one accumulation block
+    std::size_t const sizes[] = {0, 1, 2, 7, 15, 16, 33, 64, 1001, 40000, 600000};
+
+    for (auto n: sizes) {
+        std::vector<T> samples(n);
+        std::generate(samples.begin(), samples.end(), generate);
+
+        for (std::size_t channels: {1, 2}) {
+            for (std::size_t frame_step: {1, 3}) {
+                sample_stats expected[2];
+                sample_stats actual[2];
+
+                reduce_ref(samples, channels, frame_step, expected, normalize);
+                reduce_samples(samples.data(), n / channels, channels, frame_step, actual);
+
+                for (std::size_t c = 0; c < channels; c++)
+                    check_stats(actual[c], expected[c]);
+            }
+        }
+    }
+}
+
+TEST_CASE("int16 samples") {
+    MESSAGE("SIMD: " << static_cast<int>(ionik::audio::sample_kernels_simd()));
+
+    std::mt19937 gen {42};
+    std::uniform_int_distribution<int> dist {-32768, 32767};
+
+    check_kernels<std::int16_t>([& gen, & dist] { return static_cast<std::int16_t>(dist(gen)); }
+        , [] (std::int16_t v) { return (std::max)(v / 32767.0, -1.0); });
+
+    // Extreme values
+    std::vector<std::int16_t> samples(1024, -32768);
+    sample_stats stats[1];
+    reduce_samples(samples.data(), samples.size(), 1, 1, stats);
+    CHECK_EQ(stats[0].min, -1.0f);
+    CHECK_EQ(stats[0].max, -1.0f);
+    CHECK_EQ(stats[0].mean(), -1.0f);
+    CHECK_EQ(stats[0].rms(), 1.0f);
+}
+
+TEST_CASE("uint8 samples") {
+    std::mt19937 gen {42};
+    std::uniform_int_distribution<int> dist {0, 255};
+
+    check_kernels<std::uint8_t>([& gen, & dist] { return static_cast<std::uint8_t>(dist(gen)); }
+        , [] (std::uint8_t v) { return (v - 128.0) / 255.0; });
+}
+
+TEST_CASE("float samples") {
+    std::mt19937 gen {42};
+    std::uniform_real_distribution<float> dist {-1.0f, 1.0f};
+
+    check_kernels<float>([& gen, & dist] { return dist(gen); }, [] (float v) { return v; });
+}
+
+TEST_CASE("stereo channels") {
+    std::vector<std::int16_t> samples;
+
+    for (int i = 0; i < 100; i++) {
+        samples.push_back(32767);
+        samples.push_back(0);
+    }
+
+    sample_stats stats[2];
+    reduce_samples(samples.data(), samples.size() / 2, 2, 1, stats);
+
+    CHECK_EQ(stats[0].count, 100);
+    CHECK_EQ(stats[1].count, 100);
+    CHECK_EQ(stats[0].mean(), 1.0f);
+    CHECK_EQ(stats[1].mean(), 0.0f);
+    CHECK_EQ(stats[0].min, 1.0f);
+    CHECK_EQ(stats[1].max, 0.0f);
+}
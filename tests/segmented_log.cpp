@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/ionik/segmented_log.hpp"
+#include <pfs/standard_paths.hpp>
+#include <pfs/universal_id.hpp>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = pfs::filesystem;
+
+static fs::path unique_temp_dir_path ()
+{
+    fs::path result;
+    int counter = 100;
+
+    while (result.empty() && counter-- > 0) {
+        result = fs::standard_paths::temp_folder()
+            / pfs::utf8_decode_path(to_string(pfs::generate_uuid()) + ".ionik-log");
+
+        if (fs::exists(result))
+            result.clear();
+    }
+
+    if (result.empty())
+        throw std::runtime_error("unable to generate unique directory");
+
+    return result;
+}
+
+static std::string make_record (std::uint64_t i)
+{
+    return std::to_string(i) + std::string(i % 50, static_cast<char>('a' + i % 26));
+}
+
+static std::size_t segment_count (fs::path const & dir)
+{
+    std::size_t result = 0;
+
+    for (fs::directory_iterator pos {dir}, last; pos != last; ++pos)
+        result++;
+
+    return result;
+}
+
+TEST_CASE("append and read") {
+    static constexpr std::size_t TEST_SEGMENT_SIZE = 4096;
+    static constexpr std::uint64_t RECORD_COUNT = 1000;
+
+    auto dir = unique_temp_dir_path();
+    MESSAGE("Log directory: ", pfs::utf8_encode_path(dir));
+
+    ionik::segmented_log_options opts;
+    opts.segment_size = TEST_SEGMENT_SIZE;
+    opts.batch_size = 512;
+    opts.sync = ionik::log_sync_enum::segment;
+
+    {
+        ionik::segmented_log log {dir, opts};
+        REQUIRE(log);
+
+        for (std::uint64_t i = 0; i < RECORD_COUNT; i++) {
+            auto rec = make_record(i);
+            auto res = log.append(rec.data(), rec.size());
+            REQUIRE(res.second);
+            CHECK_EQ(res.first, i);
+        }
+
+        REQUIRE(log.commit());
+        CHECK_EQ(log.next_seq(), RECORD_COUNT);
+
+        // Bad records
+        CHECK_THROWS(log.append("", 0));
+        CHECK_THROWS(log.append(std::string(TEST_SEGMENT_SIZE, 'x').data(), TEST_SEGMENT_SIZE));
+    }
+
+    CHECK_GT(segment_count(dir), 1);
+
+    ionik::segmented_log_reader reader {dir};
+    std::uint64_t expected = 0;
+
+    auto count = reader.for_each([& expected] (ionik::log_record const & rec) {
+        auto sample = make_record(expected);
+        CHECK_EQ(rec.seq, expected);
+        CHECK_EQ(std::string(rec.data, rec.size), sample);
+        expected++;
+    });
+
+    CHECK_EQ(count, RECORD_COUNT);
+
+    // Positioning
+    ionik::log_record rec;
+    REQUIRE(reader.seek(777));
+    REQUIRE(reader.next(rec));
+    CHECK_EQ(rec.seq, 777);
+    CHECK_EQ(std::string(rec.data, rec.size), make_record(777));
+
+    REQUIRE(reader.seek(RECORD_COUNT));
+    CHECK_FALSE(reader.next(rec));
+    CHECK_THROWS(reader.seek(RECORD_COUNT + 1));
+
+    // Continue existing log with the torn record at the end of the active segment
+    {
+        auto last_segment = fs::path{};
+
+        for (fs::directory_iterator pos {dir}, last; pos != last; ++pos) {
+            if (last_segment.empty() || last_segment < pos->path())
+                last_segment = pos->path();
+        }
+
+        auto f = ionik::local_file::open_write_only(last_segment, ionik::truncate_enum::off);
+        REQUIRE(f);
+
+        // Find the end of data
+        auto in = ionik::local_file::open_read_only(last_segment);
+        auto view = in.map_read_only();
+        std::size_t offset = 0;
+
+        for (;;) {
+            std::uint32_t len = 0;
+            std::memcpy(& len, view.data() + offset, sizeof(len));
+
+            if (len == 0)
+                break;
+
+            offset += ionik::segmented_log::RECORD_HEADER_SIZE + len;
+        }
+
+        char torn[] = {100, 0, 0, 0, 1, 2, 3, 4, 'x', 'y', 'z'};
+        REQUIRE(f.write_at(offset, torn, sizeof(torn)).second);
+    }
+
+    {
+        ionik::segmented_log log {dir, opts};
+        REQUIRE(log);
+        CHECK_EQ(log.next_seq(), RECORD_COUNT);
+
+        for (std::uint64_t i = RECORD_COUNT; i < RECORD_COUNT + 10; i++) {
+            auto rec = make_record(i);
+            REQUIRE(log.append(rec.data(), rec.size()).second);
+        }
+    }
+
+    ionik::segmented_log_reader reader2 {dir};
+    expected = 0;
+
+    count = reader2.for_each([& expected] (ionik::log_record const & rec) {
+        CHECK_EQ(rec.seq, expected);
+        CHECK_EQ(std::string(rec.data, rec.size), make_record(expected));
+        expected++;
+    });
+
+    CHECK_EQ(count, RECORD_COUNT + 10);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("group commit") {
+    static constexpr int THREAD_COUNT = 4;
+    static constexpr std::uint64_t RECORDS_PER_THREAD = 200;
+
+    auto dir = unique_temp_dir_path();
+
+    ionik::segmented_log_options opts;
+    opts.segment_size = 16 * 1024;
+    opts.sync = ionik::log_sync_enum::commit;
+
+    {
+        ionik::segmented_log log {dir, opts};
+        REQUIRE(log);
+
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            threads.emplace_back([& log, t] {
+                for (std::uint64_t i = 0; i < RECORDS_PER_THREAD; i++) {
+                    auto rec = std::to_string(t) + ':' + std::to_string(i);
+                    log.append(rec.data(), rec.size());
+
+                    if (i % 10 == 0)
+                        log.commit();
+                }
+
+                log.commit();
+            });
+        }
+
+        for (auto & t: threads)
+            t.join();
+
+        CHECK_EQ(log.next_seq(), THREAD_COUNT * RECORDS_PER_THREAD);
+        CHECK_EQ(log.synced_seq(), THREAD_COUNT * RECORDS_PER_THREAD);
+    }
+
+    // Records of each thread are in order
+    std::vector<std::uint64_t> next(THREAD_COUNT, 0);
+    ionik::segmented_log_reader reader {dir};
+
+    auto count = reader.for_each([& next] (ionik::log_record const & rec) {
+        auto s = std::string(rec.data, rec.size);
+        auto colon = s.find(':');
+        REQUIRE(colon != std::string::npos);
+        auto t = std::stoi(s.substr(0, colon));
+        auto i = std::stoull(s.substr(colon + 1));
+        CHECK_EQ(i, next[t]);
+        next[t] = i + 1;
+    });
+
+    CHECK_EQ(count, THREAD_COUNT * RECORDS_PER_THREAD);
+
+    fs::remove_all(dir);
+}
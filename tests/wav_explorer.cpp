@@ -5,11 +5,19 @@
 //
 // Changelog:
 //      2023.10.12 Initial version.
+//      2026.10.15 Added multi-threaded spectrum building test.
+//      2026.10.15 Added spectrum envelope test.
+//      2026.10.15 Added mapped decoding test.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include <pfs/filesystem.hpp>
 #include <pfs/ionik/audio/wav_explorer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
 
 // Source of test audio files
 // https://www.mmsp.ece.mcgill.ca/Documents/AudioFormats/WAVE/Samples.html
@@ -366,3 +374,261 @@ TEST_CASE("ionik decoder") {
 
     CHECK(wav_explorer.decode(1024));
 }
+
+TEST_CASE("memory wav explorer") {
+    auto au_path = data_dir_path()
+        / PFS__LITERAL_PATH("au")
+        / PFS__LITERAL_PATH("stereol.wav");
+
+    auto content = ionik::local_file::read_all(au_path);
+    REQUIRE(content);
+
+    ionik::audio::wav_explorer file_explorer {au_path};
+    ionik::audio::memory_wav_explorer memory_explorer {
+        ionik::memory_buffer::wrap(content->data(), content->size())
+    };
+
+    ionik::audio::wav_spectrum_builder file_builder {file_explorer};
+    ionik::audio::wav_spectrum_builder memory_builder {memory_explorer};
+
+    auto file_spectrum = file_builder(100);
+    auto memory_spectrum = memory_builder(100);
+
+    REQUIRE(file_spectrum);
+    REQUIRE(memory_spectrum);
+
+    CHECK_EQ(memory_spectrum->info.data.start_offset, file_spectrum->info.data.start_offset);
+    CHECK_EQ(memory_spectrum->info.frame_count, file_spectrum->info.frame_count);
+    CHECK(memory_spectrum->data == file_spectrum->data);
+}
+
+TEST_CASE("parallel spectrum") {
+    char const * filenames[] = {"pcm0808m.wav", "stereol.wav", "M1F1-uint8-AFsp.wav"};
+    std::size_t const chunk_counts[] = {1, 7, 100, 1000};
+    std::size_t const frame_steps[] = {1, 3, (std::numeric_limits<std::size_t>::max)()};
+
+    for (auto filename: filenames) {
+        auto au_path = data_dir_path() / PFS__LITERAL_PATH("au") / fs::path(filename);
+
+        for (auto chunk_count: chunk_counts) {
+            for (auto frame_step: frame_steps) {
+                // Header is read from the current position, so explorers are not reused
+                ionik::audio::wav_explorer sequential_explorer {au_path};
+                ionik::audio::wav_explorer parallel_explorer {au_path};
+
+                ionik::audio::wav_spectrum_builder sequential_builder {sequential_explorer};
+                ionik::audio::wav_spectrum_builder parallel_builder {parallel_explorer};
+                parallel_builder.set_thread_count(4);
+
+                auto expected = sequential_builder(chunk_count, frame_step);
+                auto actual = parallel_builder(chunk_count, frame_step);
+
+                REQUIRE(expected);
+                REQUIRE(actual);
+
+                CHECK_EQ(actual->data.size(), expected->data.size());
+                CHECK(actual->data == expected->data);
+                CHECK(actual->min_frame == expected->min_frame);
+                CHECK(actual->max_frame == expected->max_frame);
+            }
+        }
+    }
+
+    // Unsupported format is reported as by sequential building
+    ionik::audio::wav_explorer explorer {data_dir_path() / PFS__LITERAL_PATH("au")
+        / PFS__LITERAL_PATH("M1F1-Alaw-AFsp.wav")};
+    ionik::audio::wav_spectrum_builder builder {explorer};
+    builder.set_thread_count(0);
+
+    ionik::error err;
+    CHECK_FALSE(builder(100, & err));
+    CHECK(err);
+}
+
+TEST_CASE("spectrum envelope") {
+    auto au_path = data_dir_path()
+        / PFS__LITERAL_PATH("au")
+        / PFS__LITERAL_PATH("stereol.wav");
+
+    // Global peaks of normalized samples
+    float min[2] = {1.0f, 1.0f};
+    float max[2] = {-1.0f, -1.0f};
+
+    {
+        ionik::audio::wav_explorer explorer {au_path};
+
+        explorer.on_raw_data = [&] (char const * data, std::size_t size) {
+            for (std::size_t i = 0; i < size / 2; i++) {
+                std::int16_t v;
+                std::memcpy(& v, data + i * 2, 2);
+                auto sample = (std::max)(v / 32767.0f, -1.0f);
+                min[i % 2] = (std::min)(min[i % 2], sample);
+                max[i % 2] = (std::max)(max[i % 2], sample);
+            }
+
+            return true;
+        };
+
+        REQUIRE(explorer.decode());
+    }
+
+    std::vector<float> sequential_rms;
+
+    for (std::size_t thread_count: {1, 4}) {
+        ionik::audio::wav_explorer explorer {au_path};
+        ionik::audio::wav_spectrum_builder builder {explorer};
+        builder.set_envelope(ionik::audio::envelope_enum::on);
+        builder.set_thread_count(thread_count);
+
+        auto spectrum = builder(100);
+
+        REQUIRE(spectrum);
+        REQUIRE_EQ(spectrum->envelope.channels.size(), 2);
+        REQUIRE_EQ(spectrum->envelope.size(), spectrum->data.size());
+
+        for (std::size_t c = 0; c < 2; c++) {
+            auto const & ch = spectrum->envelope.channels[c];
+
+            CHECK_EQ(*std::min_element(ch.min.begin(), ch.min.end()), doctest::Approx(min[c]));
+            CHECK_EQ(*std::max_element(ch.max.begin(), ch.max.end()), doctest::Approx(max[c]));
+
+            for (std::size_t i = 0; i < ch.min.size(); i++) {
+                auto mean = c == 0 ? spectrum->data[i].first : spectrum->data[i].second;
+                CHECK_LE(ch.min[i], mean + 1e-6f);
+                CHECK_GE(ch.max[i], mean - 1e-6f);
+                CHECK_GE(ch.rms[i], std::abs(mean) - 1e-6f);
+            }
+        }
+
+        // Parallel building gives the same envelope
+        if (thread_count == 1)
+            sequential_rms = spectrum->envelope.channels[1].rms;
+        else
+            CHECK(spectrum->envelope.channels[1].rms == sequential_rms);
+    }
+
+    // Envelope is not built by default
+    ionik::audio::wav_explorer explorer {au_path};
+    ionik::audio::wav_spectrum_builder builder {explorer};
+    auto spectrum = builder(100);
+
+    REQUIRE(spectrum);
+    CHECK(spectrum->envelope.channels.empty());
+}
+
+TEST_CASE("mapped decoding") {
+    char const * filenames[] = {"pcm0808m.wav", "stereol.wav", "M1F1-uint8-AFsp.wav"};
+
+    struct decode_result
+    {
+        std::string data;
+        std::vector<std::size_t> sizes;
+        bool contiguous {true};
+    };
+
+    auto decode = [] (ionik::audio::wav_explorer_base & explorer, std::size_t frames_chunk_size) {
+        decode_result result;
+        char const * next = nullptr;
+
+        explorer.on_raw_data = [&] (char const * data, std::size_t size) {
+            if (next != nullptr && data != next)
+                result.contiguous = false;
+
+            next = data + size;
+            result.data.append(data, size);
+            result.sizes.push_back(size);
+            return true;
+        };
+
+        REQUIRE(explorer.decode(frames_chunk_size));
+        return result;
+    };
+
+    for (auto filename: filenames) {
+        auto au_path = data_dir_path() / PFS__LITERAL_PATH("au") / fs::path(filename);
+        auto content = ionik::local_file::read_all(au_path);
+        REQUIRE(content);
+
+        for (std::size_t frames_chunk_size: {1000, 1024 * 1024}) {
+            ionik::audio::wav_explorer read_explorer {au_path};
+            ionik::audio::wav_explorer mapped_explorer {au_path};
+            ionik::audio::memory_wav_explorer memory_explorer {
+                ionik::memory_buffer::wrap(content->data(), content->size())
+            };
+
+            mapped_explorer.set_mapping(ionik::audio::mapping_enum::on);
+            memory_explorer.set_mapping(ionik::audio::mapping_enum::on);
+
+            auto expected = decode(read_explorer, frames_chunk_size);
+            auto mapped = decode(mapped_explorer, frames_chunk_size);
+            auto memory_mapped = decode(memory_explorer, frames_chunk_size);
+
+            CHECK(mapped.sizes == expected.sizes);
+            CHECK(mapped.data == expected.data);
+            CHECK(memory_mapped.sizes == expected.sizes);
+            CHECK(memory_mapped.data == expected.data);
+
+            // Data is not copied into the decoding buffer
+            CHECK(mapped.contiguous);
+            CHECK(memory_mapped.contiguous);
+        }
+    }
+
+    // Spectrum is the same
+    auto au_path = data_dir_path() / PFS__LITERAL_PATH("au") / PFS__LITERAL_PATH("stereol.wav");
+    ionik::audio::wav_explorer read_explorer {au_path};
+    ionik::audio::wav_explorer mapped_explorer {au_path};
+    mapped_explorer.set_mapping(ionik::audio::mapping_enum::on);
+
+    auto expected = ionik::audio::wav_spectrum_builder{read_explorer}(100);
+    auto actual = ionik::audio::wav_spectrum_builder{mapped_explorer}(100);
+
+    REQUIRE(expected);
+    REQUIRE(actual);
+    CHECK(actual->data == expected->data);
+}
+
+#if IONIK__HAS_ZSTD
+TEST_CASE("compressed wav explorer") {
+    auto au_path = data_dir_path()
+        / PFS__LITERAL_PATH("au")
+        / PFS__LITERAL_PATH("stereol.wav");
+
+    auto compressed_path = fs::temp_directory_path() / PFS__LITERAL_PATH("stereol.wav.zst");
+    auto content = ionik::local_file::read_all(au_path);
+    REQUIRE(content);
+
+    // Small frames to decode across frame boundaries
+    REQUIRE(ionik::compressed_file::rewrite(ionik::compressed_file_path{compressed_path, 3, 4096}
+        , *content, ionik::rewrite_policy_enum::in_place));
+
+    ionik::audio::wav_explorer file_explorer {au_path};
+    ionik::audio::compressed_wav_explorer compressed_explorer {compressed_path};
+
+    ionik::audio::wav_spectrum_builder file_builder {file_explorer};
+    ionik::audio::wav_spectrum_builder compressed_builder {compressed_explorer};
+
+    auto file_spectrum = file_builder(100);
+    auto compressed_spectrum = compressed_builder(100);
+
+    REQUIRE(file_spectrum);
+    REQUIRE(compressed_spectrum);
+
+    CHECK_EQ(compressed_spectrum->info.frame_count, file_spectrum->info.frame_count);
+    CHECK(compressed_spectrum->data == file_spectrum->data);
+
+    // Built by the single thread (positional reads of compressed file are not concurrent)
+    CHECK(file_explorer.concurrent_reads());
+    CHECK_FALSE(compressed_explorer.concurrent_reads());
+
+    ionik::audio::compressed_wav_explorer parallel_explorer {compressed_path};
+    ionik::audio::wav_spectrum_builder parallel_builder {parallel_explorer};
+    parallel_builder.set_thread_count(4);
+
+    auto parallel_spectrum = parallel_builder(100);
+    REQUIRE(parallel_spectrum);
+    CHECK(parallel_spectrum->data == file_spectrum->data);
+
+    fs::remove(compressed_path);
+}
+#endif
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `ionik-lib`.
+//
+// Changelog:
+//      2026.10.15 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include <pfs/filesystem.hpp>
+#include <pfs/ionik/audio/waveform_pyramid.hpp>
+#include <pfs/ionik/local_file.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace fs = pfs::filesystem;
+
+using ionik::audio::waveform_pyramid;
+
+inline fs::path data_dir_path ()
+{
+    auto dir_path = fs::current_path() / PFS__LITERAL_PATH("..")
+#if _MSC_VER
+        / PFS__LITERAL_PATH("..")
+#endif
+        / PFS__LITERAL_PATH("tests")
+        / PFS__LITERAL_PATH("data");
+
+    if (fs::exists(dir_path))
+        return dir_path;
+
+    dir_path = fs::current_path()
+        / PFS__LITERAL_PATH("data");
+
+    REQUIRE(fs::exists(dir_path));
+
+    return dir_path;
+}
+
+// Normalized samples of each channel
+static std::vector<std::vector<float>> decode_samples (fs::path const & path)
+{
+    std::vector<std::vector<float>> result;
+    int sample_size = 0;
+
+    ionik::audio::wav_explorer explorer {path};
+
+    explorer.on_wav_info = [&] (ionik::audio::wav_info const & info, std::size_t *) {
+        result.resize(static_cast<std::size_t>(info.num_channels));
+        sample_size = info.sample_size;
+        return true;
+    };
+
+    explorer.on_raw_data = [&] (char const * data, std::size_t size) {
+        auto channels = result.size();
+        auto sample_bytes = sample_size <= 8 ? std::size_t{1} : std::size_t{2};
+        auto frames = size / (channels * sample_bytes);
+
+        for (std::size_t f = 0; f < frames; f++) {
+            for (std::size_t c = 0; c < channels; c++) {
+                auto p = data + (f * channels + c) * sample_bytes;
+
+                if (sample_bytes == 1) {
+                    result[c].push_back((static_cast<unsigned char>(*p) - 128.0f) / 255.0f);
+                } else {
+                    std::int16_t v;
+                    std::memcpy(& v, p, 2);
+                    result[c].push_back((std::max)(v / 32767.0f, -1.0f));
+                }
+            }
+        }
+
+        return true;
+    };
+
+    REQUIRE(explorer.decode());
+    return result;
+}
+
+static void check_range (std::vector<float> const & samples, std::size_t first, std::size_t last
+    , float min, float max, float rms)
+{
+    last = (std::min)(last, samples.size());
+
+    auto mm = std::minmax_element(samples.begin() + first, samples.begin() + last);
+    double sum_squares = 0;
+
+    for (auto i = first; i < last; i++)
+        sum_squares += double{samples[i]} * samples[i];
+
+    CHECK_EQ(min, doctest::Approx(*mm.first));
+    CHECK_EQ(max, doctest::Approx(*mm.second));
+    CHECK_EQ(rms, doctest::Approx(std::sqrt(sum_squares / (last - first))).epsilon(1e-4));
+}
+
+TEST_CASE("build") {
+    char const * filenames[] = {"pcm0808m.wav", "stereol.wav", "M1F1-uint8-AFsp.wav"};
+
+    for (auto filename: filenames) {
+        auto path = data_dir_path() / PFS__LITERAL_PATH("au") / fs::path(filename);
+        auto samples = decode_samples(path);
+
+        ionik::audio::wav_explorer explorer {path};
+        std::size_t raw_data_calls = 0;
+        explorer.on_raw_data = [& raw_data_calls] (char const *, std::size_t) {
+            raw_data_calls++;
+            return true;
+        };
+
+        auto pyramid = waveform_pyramid::build(explorer, 64);
+
+        REQUIRE(pyramid);
+
+        // Callbacks are restored
+        CHECK_EQ(raw_data_calls, 0);
+        explorer.on_raw_data(nullptr, 0);
+        CHECK_EQ(raw_data_calls, 1);
+
+        REQUIRE_EQ(pyramid->channels(), samples.size());
+        CHECK_EQ(pyramid->frame_count(), samples[0].size());
+        CHECK_EQ(pyramid->level(pyramid->level_count() - 1).size(), 1);
+
+        for (std::size_t level = 0; level < pyramid->level_count(); level++) {
+            auto const & env = pyramid->level(level);
+            std::size_t width = std::size_t{64} << level;
+
+            CHECK_EQ(env.size(), (samples[0].size() + width - 1) / width);
+
+            // Spot check of the first, middle and last chunks
+            for (auto i: {std::size_t{0}, env.size() / 2, env.size() - 1}) {
+                for (std::size_t c = 0; c < samples.size(); c++) {
+                    check_range(samples[c], i * width, (i + 1) * width
+                        , env.channels[c].min[i], env.channels[c].max[i], env.channels[c].rms[i]);
+                }
+            }
+        }
+
+        // Points aligned to chunks of level 2 are exact
+        std::size_t width = 64 * 4;
+        auto env = pyramid->query(width, width * 11, 10);
+
+        REQUIRE_EQ(env.size(), 10);
+
+        for (std::size_t i = 0; i < 10; i++) {
+            for (std::size_t c = 0; c < samples.size(); c++) {
+                check_range(samples[c], (i + 1) * width, (i + 2) * width
+                    , env.channels[c].min[i], env.channels[c].max[i], env.channels[c].rms[i]);
+            }
+        }
+
+        // Points of arbitrary range cover it (boundaries are rounded to chunks)
+        env = pyramid->query(1000, 7777, 13);
+
+        REQUIRE_EQ(env.size(), 13);
+
+        for (std::size_t c = 0; c < samples.size(); c++) {
+            auto mm = std::minmax_element(samples[c].begin() + 1000, samples[c].begin() + 7777);
+            CHECK_LE(*std::min_element(env.channels[c].min.begin(), env.channels[c].min.end())
+                , *mm.first);
+            CHECK_GE(*std::max_element(env.channels[c].max.begin(), env.channels[c].max.end())
+                , *mm.second);
+        }
+
+        // More points than frames
+        CHECK_EQ(pyramid->query(10, 20, 100).size(), 100);
+
+        // Empty range
+        CHECK_EQ(pyramid->query(20, 10, 100).size(), 0);
+        CHECK_EQ(pyramid->query(0).size(), 0);
+    }
+}
+
+TEST_CASE("sidecar") {
+    auto src_path = data_dir_path() / PFS__LITERAL_PATH("au") / PFS__LITERAL_PATH("stereol.wav");
+    auto wav_path = fs::temp_directory_path() / PFS__LITERAL_PATH("ionik-waveform.wav");
+    auto sidecar_path = waveform_pyramid::sidecar_path(wav_path);
+
+    fs::remove(sidecar_path);
+    REQUIRE(ionik::local_file::copy(src_path, wav_path));
+
+    auto pyramid = waveform_pyramid::open(wav_path);
+
+    REQUIRE(pyramid);
+    REQUIRE(fs::exists(sidecar_path));
+    CHECK_EQ(pyramid->base_frames(), waveform_pyramid::DEFAULT_BASE_FRAMES);
+
+    auto loaded = waveform_pyramid::load(sidecar_path);
+
+    REQUIRE(loaded);
+    CHECK_EQ(loaded->channels(), pyramid->channels());
+    CHECK_EQ(loaded->frame_count(), pyramid->frame_count());
+    REQUIRE_EQ(loaded->level_count(), pyramid->level_count());
+
+    for (std::size_t level = 0; level < pyramid->level_count(); level++) {
+        for (std::size_t c = 0; c < pyramid->channels(); c++) {
+            auto const & a = loaded->level(level).channels[c];
+            auto const & b = pyramid->level(level).channels[c];
+            CHECK(a.min == b.min);
+            CHECK(a.max == b.max);
+            CHECK(a.rms == b.rms);
+        }
+    }
+
+    // Up-to-date sidecar is reused (not rewritten)
+    auto sidecar_time = fs::last_write_time(sidecar_path) - std::chrono::hours{1};
+    fs::last_write_time(sidecar_path, sidecar_time);
+
+    auto reopened = waveform_pyramid::open(wav_path);
+
+    REQUIRE(reopened);
+    CHECK(fs::last_write_time(sidecar_path) == sidecar_time);
+    CHECK(reopened->query(100).channels[0].max == pyramid->query(100).channels[0].max);
+
+    // Other base is rebuilt
+    auto other = waveform_pyramid::open(wav_path, 1024);
+
+    REQUIRE(other);
+    CHECK_EQ(other->base_frames(), 1024);
+    CHECK_EQ(waveform_pyramid::load(sidecar_path)->base_frames(), 1024);
+
+    // WAV file replaced with older timestamp (e.g. by `cp -p`) is detected
+    auto wav_time = fs::last_write_time(wav_path);
+    REQUIRE(ionik::local_file::copy(data_dir_path() / PFS__LITERAL_PATH("au")
+        / PFS__LITERAL_PATH("pcm0808m.wav"), wav_path));
+    fs::last_write_time(wav_path, wav_time - std::chrono::hours{1});
+
+    ionik::audio::wav_explorer replaced_explorer {wav_path};
+    auto expected = waveform_pyramid::build(replaced_explorer, 1024);
+    auto replaced = waveform_pyramid::open(wav_path, 1024);
+
+    REQUIRE(expected);
+    REQUIRE(replaced);
+    CHECK_NE(replaced->frame_count(), other->frame_count());
+    CHECK_EQ(replaced->frame_count(), expected->frame_count());
+    CHECK(replaced->level(0).channels[0].max == expected->level(0).channels[0].max);
+
+    // Damaged sidecar is detected
+    auto content = ionik::local_file::read_all(sidecar_path);
+    REQUIRE(content);
+    (*content)[content->size() - 1] ^= 0x55;
+    ionik::local_file::rewrite(sidecar_path, *content);
+
+    ionik::error err;
+    CHECK_FALSE(waveform_pyramid::load(sidecar_path, & err));
+    CHECK(err);
+
+    // ... and rebuilt
+    auto rebuilt = waveform_pyramid::open(wav_path, 1024);
+
+    REQUIRE(rebuilt);
+    CHECK(waveform_pyramid::load(sidecar_path));
+
+    fs::remove(sidecar_path);
+    fs::remove(wav_path);
+}